@@ -109,6 +109,38 @@ if(NOT GRVL_ZEPHYR)
     GLOB_RECURSE duktape_sources "${duktape_SOURCE_DIR}/src/*.c"
                                  "${duktape_SOURCE_DIR}/src/*.h")
 
+  set(duktape_include_dir "${duktape_SOURCE_DIR}/src")
+
+  if(GRVL_JS_EXECUTION_TIMEOUT)
+    # The stock configuration disables the check, and duktape.h includes it from its own directory,
+    # so Duktape is built from a copy with the patched configuration
+    file(READ "${duktape_SOURCE_DIR}/src/duk_config.h" duktape_config)
+    string(FIND "${duktape_config}" "#undef DUK_USE_EXEC_TIMEOUT_CHECK" timeout_check_position)
+    string(FIND "${duktape_config}" "#undef DUK_USE_INTERRUPT_COUNTER" interrupt_counter_position)
+
+    if(timeout_check_position EQUAL -1 OR interrupt_counter_position EQUAL -1)
+      message(WARNING "Unexpected duk_config.h, Duktape is built without the execution timeout check")
+    else()
+      string(
+        REPLACE "#undef DUK_USE_EXEC_TIMEOUT_CHECK"
+                "#if defined(__cplusplus)\nextern \"C\"\n#endif\nint grvl_js_exec_timeout_check(void* udata);\n#define DUK_USE_EXEC_TIMEOUT_CHECK(udata) grvl_js_exec_timeout_check((udata))"
+                duktape_config "${duktape_config}")
+      string(
+        REPLACE "#undef DUK_USE_INTERRUPT_COUNTER"
+                "#define DUK_USE_INTERRUPT_COUNTER"
+                duktape_config "${duktape_config}")
+
+      set(duktape_include_dir "${CMAKE_CURRENT_BINARY_DIR}/duktape")
+      file(WRITE "${duktape_include_dir}/duk_config.h" "${duktape_config}")
+      configure_file("${duktape_SOURCE_DIR}/src/duktape.h" "${duktape_include_dir}/duktape.h" COPYONLY)
+      configure_file("${duktape_SOURCE_DIR}/src/duktape.c" "${duktape_include_dir}/duktape.c" COPYONLY)
+
+      set(duktape_sources "${duktape_include_dir}/duktape.c" "${duktape_include_dir}/duktape.h"
+                          "${duktape_include_dir}/duk_config.h")
+      message(STATUS "Duktape execution timeout check ENABLED")
+    endif()
+  endif()
+
   target_sources(duktape PRIVATE "${duktape_sources}")
-  target_include_directories(duktape PUBLIC "${duktape_SOURCE_DIR}/src")
+  target_include_directories(duktape PUBLIC "${duktape_include_dir}")
 endif()
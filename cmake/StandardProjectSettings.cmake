@@ -5,6 +5,7 @@ option(GRVL_SHARED "Build shared library" OFF)
 option(GRVL_ZEPHYR "Enable ZephyrRTOS support" OFF)
 option(GRVL_LINUX_NATIVE "Enable Native Linux support" OFF)
 option(GRVL_LINUX_DESKTOP "Enable X11/Wayland Linux Desktop support" OFF)
+option(GRVL_JS_EXECUTION_TIMEOUT "Build Duktape with the execution timeout check" OFF)
 
 option(BUILD_DOCS "Build documentation" OFF)
 option(USE_SYSTEM_LIBRARIES "Use system provided libraries" OFF)
@@ -0,0 +1,362 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <strings.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <tinyxml2.h>
+
+#include <grvl/grvl.h>
+#include <grvl/ImageContent.h>
+
+struct Args
+{
+    const char** argv;
+    int index;
+    int count;
+
+    const char* Next()
+    {
+        return argv[index ++];
+    }
+
+    bool IfNext(const char* expected)
+    {
+        bool matched = strcmp(argv[index], expected) == 0;
+
+        if (matched) {
+            index ++;
+        }
+
+        return matched;
+    }
+
+    bool HasNext()
+    {
+        return index < count;
+    }
+};
+
+struct Config
+{
+    const char* image_path = nullptr;
+    const char* atlas_path = nullptr;
+    const char* output_path = "./out.gimg";
+    int padding = 1;
+    grvl::Format format = grvl::Format::ARGB8888;
+    bool palette = false;
+    int tolerance = 0;
+    bool dither = false;
+    bool compress = false;
+    bool rotate = false;
+    bool help = false;
+    bool invalid = false;
+};
+
+static bool ParseFormat(const char* name, grvl::Format& format)
+{
+    for (int i = 0; i <= static_cast<int>(grvl::Format::AXXX8888); i ++) {
+        if (strcasecmp(name, grvl::GetFormatName(static_cast<grvl::Format>(i))) == 0) {
+            format = static_cast<grvl::Format>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void ParseNext(Config& cfg, Args& args)
+{
+    while (args.HasNext()) {
+
+        if (args.IfNext("--image") && args.HasNext()) {
+            cfg.image_path = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--atlas") && args.HasNext()) {
+            cfg.atlas_path = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--padding") && args.HasNext()) {
+            cfg.padding = atoi(args.Next());
+            continue;
+        }
+
+        if (args.IfNext("--output") && args.HasNext()) {
+            cfg.output_path = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--format") && args.HasNext()) {
+            const char* name = args.Next();
+
+            if (!ParseFormat(name, cfg.format)) {
+                grvl::Log(grvl::ERROR, "Unknown format '%s'.", name);
+                cfg.invalid = true;
+                return;
+            }
+
+            continue;
+        }
+
+        if (args.IfNext("--palette")) {
+            cfg.palette = true;
+            continue;
+        }
+
+        if (args.IfNext("--tolerance") && args.HasNext()) {
+            cfg.palette = true;
+            cfg.tolerance = atoi(args.Next());
+            continue;
+        }
+
+        if (args.IfNext("--dither")) {
+            cfg.dither = true;
+            continue;
+        }
+
+        if (args.IfNext("--compress")) {
+            cfg.compress = true;
+            continue;
+        }
+
+        if (args.IfNext("--rotate")) {
+            cfg.rotate = true;
+            continue;
+        }
+
+        if (args.IfNext("--help")) {
+            cfg.help = true;
+            continue;
+        }
+
+        grvl::Log(grvl::ERROR, "Invalid argument '%s', expected option.", args.Next());
+        cfg.invalid = true;
+        return;
+
+    }
+
+    // check required arguments
+    if ((cfg.image_path == nullptr) == (cfg.atlas_path == nullptr)) cfg.invalid = true;
+    if (cfg.padding < 0) cfg.invalid = true;
+    if (cfg.tolerance < 0 || cfg.tolerance > 255) cfg.invalid = true;
+}
+
+struct Sprite
+{
+    std::string name;
+    std::unique_ptr<grvl::ImageContent> image;
+    int32_t x = 0;
+    int32_t y = 0;
+};
+
+/// Places sprites on shelves of an atlas roughly as wide as it is tall, tallest sprites first.
+static void PlaceSprites(std::vector<Sprite>& sprites, int32_t padding, int32_t& width, int32_t& height)
+{
+    std::sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+        return a.image->GetHeight() > b.image->GetHeight();
+    });
+
+    int64_t area = 0;
+    width = 0;
+    for (const Sprite& sprite : sprites) {
+        area += static_cast<int64_t>(sprite.image->GetWidth() + padding) * (sprite.image->GetHeight() + padding);
+        width = std::max<int32_t>(width, sprite.image->GetWidth());
+    }
+    width = std::max<int32_t>(width, std::ceil(std::sqrt(static_cast<double>(area))));
+
+    int32_t x = 0, y = 0, shelfHeight = 0;
+    for (Sprite& sprite : sprites) {
+        if (x + static_cast<int32_t>(sprite.image->GetWidth()) > width) {
+            x = 0;
+            y += shelfHeight + padding;
+            shelfHeight = 0;
+        }
+
+        sprite.x = x;
+        sprite.y = y;
+        x += sprite.image->GetWidth() + padding;
+        shelfHeight = std::max<int32_t>(shelfHeight, sprite.image->GetHeight());
+    }
+    height = y + shelfHeight;
+}
+
+/// Loads all images of the directory and packs them into one image, writing their regions to a manifest.
+static std::unique_ptr<grvl::ImageContent> PackAtlas(const Config& cfg, const std::string& manifest_path)
+{
+    std::vector<Sprite> sprites;
+    std::error_code error;
+
+    for (const auto& entry : std::filesystem::directory_iterator(cfg.atlas_path, error)) {
+        const std::string extension = entry.path().extension().string();
+        if (!entry.is_regular_file() || (strcasecmp(extension.c_str(), ".png") != 0 && strcasecmp(extension.c_str(), ".jpg") != 0
+            && strcasecmp(extension.c_str(), ".jpeg") != 0 && strcasecmp(extension.c_str(), ".bmp") != 0)) {
+            continue;
+        }
+
+        auto image = std::make_unique<grvl::ImageContent>(entry.path().c_str(), cfg.format);
+        if (image->IsEmpty()) {
+            return nullptr;
+        }
+
+        sprites.push_back({entry.path().stem().string(), std::move(image)});
+    }
+
+    if (error) {
+        grvl::Log(grvl::ERROR, "Unable to read directory %s", cfg.atlas_path);
+        return nullptr;
+    }
+
+    if (sprites.empty()) {
+        grvl::Log(grvl::ERROR, "No images found in %s", cfg.atlas_path);
+        return nullptr;
+    }
+
+    int32_t width = 0, height = 0;
+    PlaceSprites(sprites, cfg.padding, width, height);
+
+    auto atlas = std::make_unique<grvl::ImageContent>(width, height, 1, cfg.format);
+    memset(atlas->GetData(), 0, atlas->GetDataLength());
+
+    const uint32_t bpp = atlas->GetBytesPerPixel();
+    for (const Sprite& sprite : sprites) {
+        const uint32_t lineLength = sprite.image->GetWidth() * bpp;
+        for (uint32_t line = 0; line < sprite.image->GetHeight(); line ++) {
+            memcpy(atlas->GetData() + ((sprite.y + line) * width + sprite.x) * bpp, sprite.image->GetData() + line * lineLength, lineLength);
+        }
+    }
+
+    tinyxml2::XMLDocument manifest;
+    tinyxml2::XMLElement* root = manifest.NewElement("atlas");
+    root->SetAttribute("image", std::filesystem::path(cfg.output_path).filename().c_str());
+    manifest.InsertEndChild(root);
+
+    for (const Sprite& sprite : sprites) {
+        tinyxml2::XMLElement* region = root->InsertNewChildElement("region");
+        region->SetAttribute("name", sprite.name.c_str());
+        region->SetAttribute("x", sprite.x);
+        region->SetAttribute("y", sprite.y);
+        region->SetAttribute("width", sprite.image->GetWidth());
+        region->SetAttribute("height", sprite.image->GetHeight());
+    }
+
+    if (manifest.SaveFile(manifest_path.c_str()) != tinyxml2::XML_SUCCESS) {
+        grvl::Log(grvl::ERROR, "Unable to write %s", manifest_path.c_str());
+        return nullptr;
+    }
+
+    grvl::Log(grvl::INFO, "Packed %u images into %dx%d, regions saved to %s", static_cast<uint32_t>(sprites.size()), width, height, manifest_path.c_str());
+
+    return atlas;
+}
+
+int main(int argc, const char* argv[])
+{
+    grvl::gui_callbacks_t callbacks {};
+    grvl::grvl::Init(&callbacks);
+
+    Config cfg;
+    Args args {argv, 1, argc};
+    ParseNext(cfg, args);
+
+    if (cfg.help) {
+        printf("Usage: gimg [OPTION]...\n");
+        printf("Prepare images to be loaded by grvl without decoding\n");
+
+        printf("\nRequired options (one of):\n");
+        printf("  --image <path>      : Source image file path (PNG, JPEG, BMP or GIF)\n");
+        printf("  --atlas <directory> : Pack all PNG, JPEG and BMP images of the directory into one atlas,\n");
+        printf("                        the regions are written to an XML manifest next to the output\n");
+
+        printf("\nOther options:\n");
+        printf("  --help              : Print this help page and exit\n");
+        printf("  --output <path>     : Output path, by default './out.gimg' is used\n");
+        printf("  --format <format>   : Pixel format, by default ARGB8888 is used\n");
+        printf("  --palette           : Convert to L8 (or AL88) with a palette, only if it is lossless\n");
+        printf("  --tolerance <0-255> : Convert to a palette if no color channel changes by more than this\n");
+        printf("  --dither            : Dither colors that are not exactly in the palette\n");
+        printf("  --compress          : Store the pixels run-length encoded\n");
+        printf("  --rotate            : Rotate the image for displays with rotated framebuffers\n");
+        printf("  --padding <pixels>  : Space left between atlas images, by default 1 is used\n");
+
+        printf("\nExamples:\n");
+        printf("  gimg --image ./icon.png --palette --compress --output ./icon.gimg\n");
+        printf("  gimg --image ./photo.jpg --tolerance 8 --dither --output ./photo.gimg\n");
+        printf("  gimg --image ./background.png --format RGB565 --output ./background.gimg\n");
+        printf("  gimg --atlas ./icons --palette --output ./icons.gimg\n");
+        return 0;
+    }
+
+    if (cfg.invalid) {
+        grvl::Log(grvl::INFO, "Usage: gimg [OPTION]...");
+        grvl::Log(grvl::INFO, "Use '--help' for a list of options.");
+        return 1;
+    }
+
+    std::unique_ptr<grvl::ImageContent> content;
+
+    if (cfg.atlas_path) {
+        const std::string manifest_path = std::filesystem::path(cfg.output_path).replace_extension(".xml").string();
+        content = PackAtlas(cfg, manifest_path);
+
+        if (!content) {
+            return 1;
+        }
+    } else {
+        content = std::make_unique<grvl::ImageContent>(cfg.image_path, cfg.format);
+    }
+
+    grvl::ImageContent& image = *content;
+
+    if (image.IsEmpty()) {
+        return 1;
+    }
+
+    if (image.IsStreamed()) {
+        grvl::Log(grvl::ERROR, "Long animations are decoded during playback and can not be converted.");
+        return 1;
+    }
+
+    if (cfg.palette && !image.Palettize(cfg.tolerance, cfg.dither)) {
+        grvl::Log(grvl::INFO, "Palette not used, keeping %s.", grvl::GetFormatName(image.GetColorFormat()));
+    }
+
+    if (cfg.rotate) {
+        image.Rotate90();
+    }
+
+    if (cfg.compress) {
+        image.Compress();
+    }
+
+    if (image.Save(cfg.output_path) != 0) {
+        grvl::Log(grvl::ERROR, "Unable to write %s", cfg.output_path);
+        return 1;
+    }
+
+    grvl::Log(grvl::INFO, "Done! Image saved to %s (%u bytes of pixel data)", cfg.output_path, image.GetDataLength());
+
+    return 0;
+
+}
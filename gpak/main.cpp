@@ -0,0 +1,306 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <strings.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <grvl/grvl.h>
+#include <grvl/AssetBundle.h>
+#include <grvl/Endian.h>
+
+struct Args
+{
+    const char** argv;
+    int index;
+    int count;
+
+    const char* Next()
+    {
+        return argv[index ++];
+    }
+
+    bool IfNext(const char* expected)
+    {
+        bool matched = strcmp(argv[index], expected) == 0;
+
+        if (matched) {
+            index ++;
+        }
+
+        return matched;
+    }
+
+    bool HasNext()
+    {
+        return index < count;
+    }
+};
+
+struct Config
+{
+    const char* input_path = nullptr;
+    const char* output_path = "./assets.gpak";
+    const char* store_extensions = "png,jpg,jpeg,gif,bmp,gimg,gz";
+    bool compress = false;
+    int alignment = 4;
+    bool help = false;
+    bool invalid = false;
+};
+
+struct Asset
+{
+    std::string name;
+    std::vector<char> data;
+    uint32_t size = 0;
+    grvl::AssetCompression compression = grvl::AssetCompression::None;
+};
+
+static void ParseNext(Config& cfg, Args& args)
+{
+    while (args.HasNext()) {
+
+        if (args.IfNext("--input") && args.HasNext()) {
+            cfg.input_path = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--output") && args.HasNext()) {
+            cfg.output_path = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--compress")) {
+            cfg.compress = true;
+            continue;
+        }
+
+        if (args.IfNext("--store") && args.HasNext()) {
+            cfg.store_extensions = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--align") && args.HasNext()) {
+            cfg.alignment = atoi(args.Next());
+            continue;
+        }
+
+        if (args.IfNext("--help")) {
+            cfg.help = true;
+            continue;
+        }
+
+        grvl::Log(grvl::ERROR, "Invalid argument '%s', expected option.", args.Next());
+        cfg.invalid = true;
+        return;
+
+    }
+
+    // check required arguments
+    if (cfg.input_path == nullptr) cfg.invalid = true;
+    if (cfg.alignment < 1 || cfg.alignment > 4096 || (cfg.alignment & (cfg.alignment - 1)) != 0) cfg.invalid = true;
+}
+
+/// Checks if the extension is in the comma separated list, ignoring case
+static bool HasListedExtension(const std::filesystem::path& path, const char* list)
+{
+    std::string extension = path.extension().string();
+    if (extension.empty()) {
+        return false;
+    }
+    extension = extension.substr(1);
+
+    for (const char* start = list; *start;) {
+        const char* end = strchr(start, ',');
+        const size_t length = end ? end - start : strlen(start);
+
+        if (length == extension.size() && strncasecmp(start, extension.c_str(), length) == 0) {
+            return true;
+        }
+
+        start += end ? length + 1 : length;
+    }
+
+    return false;
+}
+
+static bool LoadAssets(const Config& cfg, std::vector<Asset>& assets)
+{
+    const std::filesystem::path root = cfg.input_path;
+    std::error_code error;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+
+        std::ifstream stream(entry.path(), std::ios::binary);
+        if (!stream) {
+            grvl::Log(grvl::ERROR, "Unable to read %s", entry.path().c_str());
+            return false;
+        }
+
+        Asset asset;
+        asset.name = entry.path().lexically_relative(root).generic_string();
+        asset.data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        asset.size = asset.data.size();
+
+        // formats which are compressed already, or used in place, are stored as they are
+        if (cfg.compress && asset.size > 0 && !HasListedExtension(entry.path(), cfg.store_extensions)) {
+            uLongf compressedSize = compressBound(asset.size);
+            std::vector<char> compressed(compressedSize);
+
+            if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                          reinterpret_cast<const Bytef*>(asset.data.data()), asset.size, Z_BEST_COMPRESSION) == Z_OK
+                && compressedSize < asset.size) {
+                compressed.resize(compressedSize);
+                asset.data = std::move(compressed);
+                asset.compression = grvl::AssetCompression::Zlib;
+            }
+        }
+
+        assets.push_back(std::move(asset));
+    }
+
+    if (error) {
+        grvl::Log(grvl::ERROR, "Unable to read directory %s", cfg.input_path);
+        return false;
+    }
+
+    // entries are found with a binary search
+    std::sort(assets.begin(), assets.end(), [](const Asset& a, const Asset& b) { return a.name < b.name; });
+    return true;
+}
+
+static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool WriteBundle(const Config& cfg, const std::vector<Asset>& assets)
+{
+    std::vector<char> names;
+    std::vector<grvl::AssetBundleEntry> entries(assets.size());
+
+    for (size_t i = 0; i < assets.size(); i ++) {
+        entries[i].name = names.size();
+        names.insert(names.end(), assets[i].name.begin(), assets[i].name.end());
+        names.push_back('\0');
+    }
+
+    uint8_t alignmentShift = 0;
+    while ((1 << alignmentShift) < cfg.alignment) {
+        alignmentShift ++;
+    }
+
+    uint64_t offset = sizeof(grvl::AssetBundleHeader) + entries.size() * sizeof(grvl::AssetBundleEntry) + names.size();
+    for (size_t i = 0; i < assets.size(); i ++) {
+        offset = AlignUp(offset, cfg.alignment);
+        if (offset + assets[i].data.size() > UINT32_MAX) {
+            grvl::Log(grvl::ERROR, "Assets do not fit a bundle, it is limited to 4 GiB");
+            return false;
+        }
+
+        entries[i].offset = grvl::BigEndian32(offset);
+        entries[i].size = grvl::BigEndian32(assets[i].size);
+        entries[i].storedSize = grvl::BigEndian32(assets[i].data.size());
+        entries[i].compression = static_cast<uint8_t>(assets[i].compression);
+        entries[i].alignment = alignmentShift;
+        entries[i].reserved = 0;
+        entries[i].name = grvl::BigEndian32(entries[i].name);
+        offset += assets[i].data.size();
+    }
+
+    grvl::AssetBundleHeader header {};
+    memcpy(header.magic, grvl::assetBundleMagic, sizeof(header.magic));
+    header.version = grvl::BigEndian32(grvl::assetBundleVersion);
+    header.entries = grvl::BigEndian32(entries.size());
+    header.names = grvl::BigEndian32(names.size());
+
+    std::ofstream output(cfg.output_path, std::ios::binary);
+    if (!output) {
+        return false;
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(grvl::AssetBundleEntry));
+    output.write(names.data(), names.size());
+
+    for (size_t i = 0; i < assets.size(); i ++) {
+        const uint32_t padding = grvl::BigEndian32(entries[i].offset) - static_cast<uint32_t>(output.tellp());
+        output.write(std::string(padding, '\0').data(), padding);
+        output.write(assets[i].data.data(), assets[i].data.size());
+    }
+
+    return static_cast<bool>(output);
+}
+
+int main(int argc, const char* argv[])
+{
+    grvl::gui_callbacks_t callbacks {};
+    grvl::grvl::Init(&callbacks);
+
+    Config cfg;
+    Args args {argv, 1, argc};
+    ParseNext(cfg, args);
+
+    if (cfg.help) {
+        printf("Usage: gpak [OPTION]...\n");
+        printf("Pack a directory of assets into a single bundle, which grvl maps to memory\n");
+
+        printf("\nRequired options:\n");
+        printf("  --input <directory> : Directory to pack, paths in the bundle are relative to it\n");
+
+        printf("\nOther options:\n");
+        printf("  --help              : Print this help page and exit\n");
+        printf("  --output <path>     : Output path, by default './assets.gpak' is used\n");
+        printf("  --compress          : Compress assets with zlib, compressed assets are copied when read\n");
+        printf("  --store <ext,...>   : Extensions never compressed, by default 'png,jpg,jpeg,gif,bmp,gimg,gz'\n");
+        printf("  --align <bytes>     : Alignment of asset data (power of two), by default 4 is used\n");
+
+        printf("\nExamples:\n");
+        printf("  gpak --input ./romfs --output ./romfs.gpak\n");
+        printf("  gpak --input ./romfs --compress --align 16 --output ./romfs.gpak\n");
+        return 0;
+    }
+
+    if (cfg.invalid) {
+        grvl::Log(grvl::INFO, "Usage: gpak [OPTION]...");
+        grvl::Log(grvl::INFO, "Use '--help' for a list of options.");
+        return 1;
+    }
+
+    std::vector<Asset> assets;
+    if (!LoadAssets(cfg, assets)) {
+        return 1;
+    }
+
+    if (!WriteBundle(cfg, assets)) {
+        grvl::Log(grvl::ERROR, "Unable to write %s", cfg.output_path);
+        return 1;
+    }
+
+    grvl::Log(grvl::INFO, "Done! %u assets packed into %s", static_cast<uint32_t>(assets.size()), cfg.output_path);
+
+    return 0;
+
+}
@@ -0,0 +1,265 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <grvl/grvl.h>
+#include <grvl/Endian.h>
+#include <grvl/Scene.h>
+#include <grvl/Stylesheet.h>
+
+struct Args
+{
+    const char** argv;
+    int index;
+    int count;
+
+    const char* Next()
+    {
+        return argv[index ++];
+    }
+
+    bool IfNext(const char* expected)
+    {
+        bool matched = strcmp(argv[index], expected) == 0;
+
+        if (matched) {
+            index ++;
+        }
+
+        return matched;
+    }
+
+    bool HasNext()
+    {
+        return index < count;
+    }
+};
+
+struct Config
+{
+    const char* input_path = nullptr;
+    const char* output_path = "./gui.gscn";
+    bool help = false;
+    bool invalid = false;
+};
+
+struct Compiler
+{
+    grvl::Stylesheet stylesheet;
+    std::vector<grvl::SceneElement> elements;
+    std::vector<grvl::SceneAttribute> attributes;
+    std::vector<char> strings;
+    std::unordered_map<std::string, uint32_t> stringOffsets;
+
+    uint32_t AddString(const char* text)
+    {
+        auto [position, inserted] = stringOffsets.emplace(text, strings.size());
+        if (inserted) {
+            strings.insert(strings.end(), text, text + strlen(text) + 1);
+        }
+        return position->second;
+    }
+
+    void AddAttribute(grvl::SceneElement& element, const char* name, const char* value)
+    {
+        attributes.push_back({AddString(name), AddString(value)});
+        element.attributeCount ++;
+    }
+
+    /// Adds the attributes set by the stylesheet, which are not set by the element itself
+    void ApplyStylesheet(uint32_t index, tinyxml2::XMLElement* source)
+    {
+        grvl::SceneElement& element = elements[index];
+        for (const grvl::Stylesheet::Property& property : stylesheet.Resolve(source)) {
+            if (!source->Attribute(property.name)) {
+                AddAttribute(element, property.name, property.value);
+            }
+        }
+    }
+
+    uint32_t AddElement(tinyxml2::XMLElement* source, bool root)
+    {
+        const uint32_t index = elements.size();
+        elements.push_back({AddString(source->Value()), grvl::sceneNone, static_cast<uint32_t>(attributes.size()), 0, grvl::sceneNone, grvl::sceneNone});
+
+        if (const char* text = source->GetText()) {
+            elements[index].text = AddString(text);
+        }
+
+        for (const tinyxml2::XMLAttribute* attribute = source->FirstAttribute(); attribute; attribute = attribute->Next()) {
+            AddAttribute(elements[index], attribute->Name(), attribute->Value());
+        }
+
+        ApplyStylesheet(index, source);
+
+        uint32_t previous = grvl::sceneNone;
+        for (tinyxml2::XMLElement* child = source->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            // the stylesheet is applied already
+            if (root && strcmp(child->Value(), "stylesheet") == 0) {
+                continue;
+            }
+
+            const uint32_t childIndex = AddElement(child, false);
+            if (previous == grvl::sceneNone) {
+                elements[index].firstChild = childIndex;
+            } else {
+                elements[previous].nextSibling = childIndex;
+            }
+            previous = childIndex;
+        }
+
+        return index;
+    }
+};
+
+static void ParseNext(Config& cfg, Args& args)
+{
+    while (args.HasNext()) {
+
+        if (args.IfNext("--input") && args.HasNext()) {
+            cfg.input_path = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--output") && args.HasNext()) {
+            cfg.output_path = args.Next();
+            continue;
+        }
+
+        if (args.IfNext("--help")) {
+            cfg.help = true;
+            continue;
+        }
+
+        grvl::Log(grvl::ERROR, "Invalid argument '%s', expected option.", args.Next());
+        cfg.invalid = true;
+        return;
+
+    }
+
+    // check required arguments
+    if (cfg.input_path == nullptr) cfg.invalid = true;
+}
+
+static bool WriteScene(const Config& cfg, Compiler& compiler)
+{
+    for (grvl::SceneElement& element : compiler.elements) {
+        element.name = grvl::BigEndian32(element.name);
+        element.text = grvl::BigEndian32(element.text);
+        element.firstAttribute = grvl::BigEndian32(element.firstAttribute);
+        element.attributeCount = grvl::BigEndian32(element.attributeCount);
+        element.firstChild = grvl::BigEndian32(element.firstChild);
+        element.nextSibling = grvl::BigEndian32(element.nextSibling);
+    }
+
+    for (grvl::SceneAttribute& attribute : compiler.attributes) {
+        attribute.name = grvl::BigEndian32(attribute.name);
+        attribute.value = grvl::BigEndian32(attribute.value);
+    }
+
+    grvl::SceneHeader header {};
+    memcpy(header.magic, grvl::sceneMagic, sizeof(header.magic));
+    header.version = grvl::BigEndian32(grvl::sceneVersion);
+    header.elements = grvl::BigEndian32(compiler.elements.size());
+    header.attributes = grvl::BigEndian32(compiler.attributes.size());
+    header.strings = grvl::BigEndian32(compiler.strings.size());
+
+    std::ofstream output(cfg.output_path, std::ios::binary);
+    if (!output) {
+        return false;
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(compiler.elements.data()), compiler.elements.size() * sizeof(grvl::SceneElement));
+    output.write(reinterpret_cast<const char*>(compiler.attributes.data()), compiler.attributes.size() * sizeof(grvl::SceneAttribute));
+    output.write(compiler.strings.data(), compiler.strings.size());
+
+    return static_cast<bool>(output);
+}
+
+int main(int argc, const char* argv[])
+{
+    grvl::gui_callbacks_t callbacks {};
+    grvl::grvl::Init(&callbacks);
+
+    Config cfg;
+    Args args {argv, 1, argc};
+    ParseNext(cfg, args);
+
+    if (cfg.help) {
+        printf("Usage: gscn [OPTION]...\n");
+        printf("Compile an XML layout into a scene, which grvl loads without parsing XML or the stylesheet\n");
+
+        printf("\nRequired options:\n");
+        printf("  --input <path>  : XML layout to compile\n");
+
+        printf("\nOther options:\n");
+        printf("  --help          : Print this help page and exit\n");
+        printf("  --output <path> : Output path, by default './gui.gscn' is used\n");
+
+        printf("\nExamples:\n");
+        printf("  gscn --input ./romfs/gui.xml --output ./romfs/gui.gscn\n");
+        return 0;
+    }
+
+    if (cfg.invalid) {
+        grvl::Log(grvl::INFO, "Usage: gscn [OPTION]...");
+        grvl::Log(grvl::INFO, "Use '--help' for a list of options.");
+        return 1;
+    }
+
+    std::ifstream stream(cfg.input_path, std::ios::binary);
+    if (!stream) {
+        grvl::Log(grvl::ERROR, "Unable to read %s", cfg.input_path);
+        return 1;
+    }
+
+    const std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    tinyxml2::XMLDocument document;
+    if (document.Parse(text.c_str(), text.size()) != tinyxml2::XML_SUCCESS) {
+        grvl::Log(grvl::ERROR, "Unable to parse %s", cfg.input_path);
+        return 1;
+    }
+
+    // the same element Manager::BuildFromXMLString starts from
+    tinyxml2::XMLElement* root = document.LastChild() ? document.LastChild()->ToElement() : nullptr;
+    if (!root) {
+        grvl::Log(grvl::ERROR, "Layout %s has no root element", cfg.input_path);
+        return 1;
+    }
+
+    Compiler compiler;
+    if (tinyxml2::XMLElement* stylesheet = root->FirstChildElement("stylesheet")) {
+        compiler.stylesheet.Parse(stylesheet->GetText());
+    }
+    compiler.AddElement(root, true);
+
+    if (!WriteScene(cfg, compiler)) {
+        grvl::Log(grvl::ERROR, "Unable to write %s", cfg.output_path);
+        return 1;
+    }
+
+    grvl::Log(grvl::INFO, "Done! %u elements compiled into %s", static_cast<uint32_t>(compiler.elements.size()), cfg.output_path);
+
+    return 0;
+
+}
@@ -0,0 +1,110 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GRVL_ASSETBUNDLE_H_
+#define GRVL_ASSETBUNDLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace grvl {
+
+    static constexpr char assetBundleMagic[8] = {'g', 'r', 'v', 'l', 'p', 'a', 'k', '\0'};
+    static constexpr uint32_t assetBundleVersion = 0;
+
+    enum class AssetCompression : uint8_t {
+        None = 0,
+        Zlib = 1,
+    };
+
+    // All fields are stored big endian, the header is followed by the entries sorted by name,
+    // the table of null terminated names and the data of every entry
+    struct AssetBundleHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t entries;
+        uint32_t names; // size of the name table in bytes
+        uint32_t reserved;
+    };
+
+    struct AssetBundleEntry {
+        uint32_t name; // offset of the name in the name table
+        uint32_t offset; // offset of the data from the start of the bundle
+        uint32_t size; // size of the data once decompressed
+        uint32_t storedSize; // size of the data in the bundle
+        uint8_t compression; // AssetCompression
+        uint8_t alignment; // log2 of the alignment of the data
+        uint16_t reserved;
+    };
+
+    static_assert(sizeof(AssetBundleHeader) == 24, "Asset bundle header has unexpected padding");
+    static_assert(sizeof(AssetBundleEntry) == 20, "Asset bundle entry has unexpected padding");
+
+    /// Single file holding many assets, found by a binary search through its sorted directory.
+    ///
+    /// The whole bundle is kept in memory (mapped from a file, or linked into flash),
+    /// so uncompressed entries are used in place, without copying. Only the directory is copied,
+    /// as the bundle may be unaligned.
+    class AssetBundle {
+    public:
+        /// Uses a bundle that is already in memory, which has to outlive the bundle object.
+        AssetBundle(const uint8_t* data, size_t size);
+
+        /// Maps the bundle file to memory, on systems without mmap it is read instead.
+        explicit AssetBundle(const char* path);
+
+        AssetBundle(const AssetBundle&) = delete;
+        AssetBundle& operator=(const AssetBundle&) = delete;
+
+        ~AssetBundle();
+
+        bool IsValid() const
+        {
+            return valid;
+        }
+
+        /// @return Entry with the given name, or nullptr if the bundle has none.
+        const AssetBundleEntry* Find(const char* name) const;
+
+        /// @return Data of an uncompressed entry, or nullptr if the entry is compressed.
+        const uint8_t* GetData(const AssetBundleEntry* entry) const;
+
+        uint32_t GetSize(const AssetBundleEntry* entry) const;
+
+        /// @return Data of the entry as stored in the bundle, compressed or not.
+        const uint8_t* GetStoredData(const AssetBundleEntry* entry, uint32_t& storedSize) const;
+
+        /// Copies the entry, decompressing it if needed, up to the given size.
+        /// @return Number of bytes written to the buffer, -1 on a decompression error.
+        int32_t Read(const AssetBundleEntry* entry, uint8_t* buffer, int32_t size) const;
+
+    private:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        bool mapped = false;
+        bool owned = false;
+
+        bool valid = false;
+        std::vector<AssetBundleEntry> entries {};
+        const char* names = nullptr;
+
+        bool Parse();
+    };
+
+} /* namespace grvl */
+
+#endif /* GRVL_ASSETBUNDLE_H_ */
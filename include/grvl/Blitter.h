@@ -31,6 +31,48 @@ namespace grvl {
                                         uint32_t NumberOfLine, uint32_t inOffset, uint32_t backgroundOffset, uint32_t outOffset,
                                         Format inPixelFormat, Format backgroundPixelFormat, Format outPixelFormat, uint32_t frontColor, uintptr_t backCLT, uintptr_t frontCTL);
 
+    // Blends input over background, with the input alpha multiplied by a constant alpha (0 - background only, 255 - input only)
+    using DmaBlendFunction = void (*)(uintptr_t inputMem, uintptr_t backgroundMem, uintptr_t outputMem, uint32_t PixelPerLine,
+                                      uint32_t NumberOfLine, uint32_t inOffset, uint32_t backgroundOffset, uint32_t outOffset,
+                                      Format inPixelFormat, Format backgroundPixelFormat, Format outPixelFormat, uint8_t alpha);
+
+    // Blitters may return before an operation is done, as long as operations complete in submission order.
+    // The fence of the operations submitted so far grows with every operation, waiting for it makes sure
+    // that they are done, before their memory is accessed by the CPU (0 is always complete).
+    using BlitFence = uint32_t;
+    using BlitFenceFunction = BlitFence (*)();
+    using BlitWaitFunction = void (*)(BlitFence fence);
+
+    enum class BlitOperation : uint8_t {
+        Fill,
+        Blit,
+        BlitClt,
+        Blend,
+    };
+
+    // Arguments of a single operation in a batch, the color holds the fill color, the font color or the constant alpha
+    struct BlitDescriptor {
+        BlitOperation operation;
+        uintptr_t inputMem;
+        uintptr_t backgroundMem;
+        uintptr_t outputMem;
+        uint32_t columns;
+        uint32_t rows;
+        uint32_t inOffset;
+        uint32_t backgroundOffset;
+        uint32_t outOffset;
+        Format inPixelFormat;
+        Format backgroundPixelFormat;
+        Format outPixelFormat;
+        uint32_t color;
+        uintptr_t backCLT;
+        uintptr_t frontCLT;
+    };
+
+    // Runs a batch of operations, none of them writes memory used by another, so they can run in any order.
+    // The descriptors can be reused once the function returns, asynchronous blitters have to copy them
+    using DmaBlitBatchFunction = void (*)(const BlitDescriptor* descriptors, uint32_t count);
+
     /// Helper function to convert grvl::Format to DMA2D enum
     uint32_t FormatToDma2d(Format format);
 
@@ -41,9 +83,22 @@ namespace grvl {
     void UseBlitAsBlitClt(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff,
                           uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL);
 
+    // a DmaBlendFunction function impl for custom blitters without blending, synchronous blitters get the pixels blended by the CPU,
+    // asynchronous ones don't blend at all, all calls are routed to DmaBlitFunction, picking either the input or the background
+    void UseBlitAsBlend(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff,
+                        uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint8_t alpha);
+
+    // a DmaBlitBatchFunction function impl that routs every operation to its own callback, in order
+    void UseOperationsAsBlitBatch(const BlitDescriptor* descriptors, uint32_t count);
+
+    // Runs a single operation with its own callback
+    void RunBlitDescriptor(const BlitDescriptor& descriptor);
+
     DmaFillFunction GetFillFunction();
     DmaBlitFunction GetBlitFunction();
     DmaBlitCltFunction GetBlitCltFunction();
+    DmaBlendFunction GetBlendFunction();
+    DmaBlitBatchFunction GetBlitBatchFunction();
 
 }
 
@@ -0,0 +1,45 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GRVL_BLITTERTHREAD_H_
+#define GRVL_BLITTERTHREAD_H_
+
+#include <grvl/grvl.h>
+
+#include <stdint.h>
+
+namespace grvl {
+
+    /// Runs the blitter on a worker thread, so drawing goes on while the operations are done.
+    ///
+    /// Operations are queued and run in submission order, the painter waits for their fences
+    /// before the CPU touches memory they use. On systems with the software blitter only,
+    /// it stands in for an asynchronous DMA engine.
+    class BlitterThread {
+    public:
+        static constexpr uint32_t defaultQueueSize = 64;
+
+        /// Moves the blitter callbacks to the worker thread, replacing them with callbacks queuing the operations,
+        /// together with blit_fence and wait_for_blit. Has to be called after grvl::Init, before anything is drawn.
+        static bool Start(uint32_t queueSize = defaultQueueSize);
+
+        /// Waits for the queued operations, stops the worker and restores the blitter callbacks.
+        static void Stop();
+    };
+
+} /* namespace grvl */
+
+#endif /* GRVL_BLITTERTHREAD_H_ */
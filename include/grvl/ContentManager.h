@@ -32,6 +32,9 @@ namespace grvl {
 
     /// Represents a managed image resource, the ContentManager can freely swap the underlying ImageContent pointer
     /// thus this object should be queried for it each time it is used.
+    ///
+    /// A delegate may also refer to a region of another delegate's content, e.g. an icon packed into an atlas,
+    /// in which case it does not own the content.
     class ImageDelegate {
     public:
         constexpr void Set(ImageContent* ptr)
@@ -43,14 +46,39 @@ namespace grvl {
             this->content = ptr;
         }
 
-        constexpr ImageContent* Get() const
+        /// Makes this delegate refer to the given region of the source's content.
+        void SetRegion(const std::shared_ptr<ImageDelegate>& regionSource, const ImageRegion& imageRegion)
         {
-            return content;
+            Set(nullptr);
+            source = regionSource;
+            region = imageRegion;
+        }
+
+        ImageContent* Get() const
+        {
+            return source ? source->Get() : content;
+        }
+
+        bool HasContent() const
+        {
+            return Get() != nullptr;
         }
 
-        constexpr bool HasContent() const
+        bool HasRegion() const
         {
-            return content != nullptr;
+            return source != nullptr;
+        }
+
+        /// Region of the content to draw, the whole content if the delegate does not refer to a region.
+        ImageRegion GetRegion() const
+        {
+            if(source) {
+                return region;
+            }
+            if(!content) {
+                return {0, 0, 0, 0};
+            }
+            return {0, 0, static_cast<int32_t>(content->GetWidth()), static_cast<int32_t>(content->GetHeight())};
         }
 
         ~ImageDelegate()
@@ -60,18 +88,29 @@ namespace grvl {
 
     private:
         ImageContent* content = nullptr;
+        std::shared_ptr<ImageDelegate> source;
+        ImageRegion region{0, 0, 0, 0};
     };
 
     /// Represents manager for shared resources, e.g., image contents.
     class ContentManager {
     public:
         using LoaderCallback = std::function<void(const std::string&)>;
+        using AtlasRegions = std::unordered_map<std::string, ImageRegion>;
+
+        /// Separates the atlas name from the region name in image names, e.g. "icons#home".
+        static constexpr char AtlasSeparator = '#';
 
         virtual ~ContentManager() = default;
 
         /// Updates all users of the image with the given name
         void RegisterContent(const std::string& name, ImageContent* ic);
 
+        /// Registers an image with named regions, each available as "<name>#<region>".
+        ///
+        /// Users of the regions are updated, a region keeps following the atlas content if it is replaced later.
+        void RegisterAtlas(const std::string& name, ImageContent* ic, const AtlasRegions& regions);
+
         /// Used by Image component to get a ImageContent delegate
         std::shared_ptr<ImageDelegate> RequestImage(const std::string& name);
 
@@ -84,8 +123,14 @@ namespace grvl {
     private:
         LoaderCallback loader_callback = [](const std::string& path) { /* do nothing */ };
 
+        /// Points the delegate at its atlas region if the name refers to a known one.
+        bool ResolveRegion(const std::string& name, ImageDelegate& delegate);
+
         // mapping of resource handles to resource delegates
         std::unordered_map<std::string, std::shared_ptr<ImageDelegate>> content_registry;
+
+        // mapping of atlas names to their named regions
+        std::unordered_map<std::string, AtlasRegions> atlas_registry;
     };
 
 } /* namespace grvl */
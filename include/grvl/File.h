@@ -19,12 +19,19 @@
 
 #include <cstring>
 #include <stdint.h>
+#include <stdio.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+struct gzFile_s;
+struct z_stream_s;
+
 namespace grvl {
 
+    class AssetBundle;
+    struct AssetBundleEntry;
+
     inline bool EndsWith(const char* name, const char* ext)
     {
         return strlen(name) >= strlen(ext) && !strcmp(name + strlen(name) - strlen(ext), ext);
@@ -40,10 +47,63 @@ namespace grvl {
 
         using MapEntry = std::pair<unsigned char*, uint64_t>;
 
+        /// Reads the contents of a file from start to end in chunks, decompressing them on the way.
+        class Reader {
+        public:
+            explicit Reader(const File& file);
+            ~Reader();
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            bool IsOpen() const
+            {
+                return open;
+            }
+
+            /// Read the next chunk of the file.
+            /// @param buffer Buffer to be written to, must be at least 'size' bytes long.
+            /// @param size Number of bytes to read.
+            /// @return Number of bytes read, less than requested only at the end of the file. -1 is returned on errors.
+            int32_t Read(uint8_t* buffer, int32_t size);
+
+            /// Appends the rest of the file to the buffer.
+            /// @return false on a read error, the buffer then holds the data read before it.
+            bool ReadToEnd(std::vector<char>& buffer);
+            bool ReadToEnd(std::string& buffer);
+
+            /// @return Expected size of the whole file, which may be inaccurate for gzip (e.g. multiple members) or 0 if unknown.
+            uint32_t GetSizeHint() const
+            {
+                return sizeHint;
+            }
+
+        private:
+            bool open = false;
+            FILE* file = nullptr;
+            gzFile_s* gzfile = nullptr;
+            z_stream_s* inflater = nullptr;
+            const uint8_t* memory = nullptr;
+            uint32_t memorySize = 0;
+            uint32_t position = 0;
+            uint32_t sizeHint = 0;
+        };
+
         /// @param _files <filename, <data, length>>
         static void NoFilesystem(std::unordered_map<std::string, MapEntry>* files);
         static bool noFS;
 
+        /// Resolves paths starting with the mount point through an asset bundle, other paths are used as before.
+        /// @param path Bundle file, which is mapped to memory.
+        /// @param mountPoint Prefix of the paths in the bundle, e.g. "romfs/".
+        /// @return false if the bundle could not be loaded.
+        static bool MountBundle(const char* path, const char* mountPoint = "");
+
+        /// Same as above, for a bundle already in memory (e.g. linked into flash), which is used in place.
+        static bool MountBundle(const uint8_t* data, size_t size, const char* mountPoint = "");
+
+        static void UnmountBundle();
+
         /// Check if this file exists
         bool Exists() const;
 
@@ -51,6 +111,7 @@ namespace grvl {
         std::string GetName() const;
 
         /// @return File size in bytes. If the file is missing 0 is returned.
+        /// For gzip files the size is taken from the trailer, which is not accurate for files with multiple members.
         int32_t GetSize() const;
 
         /// Read file contains to buffer, up to the given size.
@@ -68,6 +129,11 @@ namespace grvl {
         /// Check if the filename ends with a specific extension.
         bool HasExtension(const char* ext) const;
 
+        /// Get the file contents if they are already in memory, which is the case for
+        /// uncompressed bundle entries and files given to NoFilesystem.
+        /// @return Pointer to GetSize() bytes valid until the bundle is unmounted, or nullptr if the file has to be read.
+        const uint8_t* GetMappedData() const;
+
         /// Read file into a buffer
         std::vector<char> Read() const;
 
@@ -82,13 +148,17 @@ namespace grvl {
             NORMAL,
             GZIPPED,
             DICTIONARY,
+            BUNDLE,
         };
 
         const char* path;
         bool readOnly;
         Storage storage;
+        const AssetBundleEntry* bundleEntry = nullptr;
 
         static std::unordered_map<std::string, MapEntry>* files;
+        static AssetBundle* bundle;
+        static std::string bundleMountPoint;
     };
 
 } /* namespace grvl */
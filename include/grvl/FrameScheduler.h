@@ -0,0 +1,88 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GRVL_FRAMESCHEDULER_H_
+#define GRVL_FRAMESCHEDULER_H_
+
+#include <pthread.h>
+#include <stdint.h>
+
+namespace grvl {
+
+    /// Decides when the next frame should be rendered.
+    ///
+    /// Frames are requested for a given timestamp (e.g. by input handling or animations),
+    /// and started at the first vertical blanking reported by the platform after that timestamp.
+    /// Platforms without vblank reports are paced by the frame interval instead.
+    /// All methods can be called from any thread.
+    class FrameScheduler {
+    public:
+        static constexpr uint64_t noFrame = UINT64_MAX;
+        static constexpr uint32_t defaultFrameInterval = 16;
+
+        FrameScheduler();
+        ~FrameScheduler();
+        FrameScheduler(const FrameScheduler&) = delete;
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        /// Requests a frame to be rendered as soon as possible.
+        ///
+        /// Same as requesting it for the current timestamp, its deadline is the later of the request and one frame interval after the last frame.
+        void RequestFrame();
+
+        /// Requests a frame to be rendered at the given timestamp (or later, if another frame is requested earlier).
+        void RequestFrame(uint64_t timestamp);
+
+        /// Reports the timestamp of a vertical blanking, used to align the start of rendering.
+        void ReportVblank(uint64_t timestamp);
+
+        void SetFrameInterval(uint32_t interval);
+        uint32_t GetFrameInterval() const;
+
+        /// @return Timestamp at which the next frame should start, or noFrame if there is nothing to render.
+        uint64_t GetNextFrameTimestamp() const;
+
+        bool IsFrameDue(uint64_t now) const;
+
+        /// @return Time in milliseconds until the next frame should start, or noFrame if there is nothing to render.
+        uint64_t GetTimeout(uint64_t now) const;
+
+        /// Blocks the calling thread until a frame is due, or until the given time in milliseconds elapses.
+        void WaitForFrame(uint64_t now, uint64_t maxTimeout = noFrame);
+
+        /// Marks the start of a frame, consuming the pending request.
+        ///
+        /// @return false if the frame started more than a frame interval after its deadline.
+        bool BeginFrame(uint64_t now);
+
+        uint32_t GetMissedDeadlines() const;
+
+    private:
+        mutable pthread_mutex_t m;
+        pthread_cond_t frameRequested;
+
+        uint64_t requestedTimestamp { noFrame };
+        uint64_t lastVblank { 0 };
+        uint64_t lastFrameStart { 0 };
+        uint32_t frameInterval { defaultFrameInterval };
+        uint32_t missedDeadlines { 0 };
+
+        uint64_t GetNextFrameTimestampLocked() const;
+    };
+
+} /* namespace grvl */
+
+#endif /* GRVL_FRAMESCHEDULER_H_ */
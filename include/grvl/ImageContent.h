@@ -27,10 +27,14 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <memory>
 #include <vector>
 
 namespace grvl {
 
+    class FrameStream;
+    struct GifLayout;
+
     class ImageContent {
     public:
         ImageContent(const char* path, Format format = Format::ARGB8888);
@@ -41,6 +45,7 @@ namespace grvl {
 
         ~ImageContent();
 
+        /// Images loaded in place, e.g. from an asset bundle, are read only.
         uint8_t* GetData()
         {
             return data;
@@ -51,19 +56,17 @@ namespace grvl {
             return data;
         }
 
-        uint8_t* GetFrameData(uint32_t frame)
-        {
-            return data + GetFrameDataLength() * frame;
-        }
-
-        const uint8_t* GetFrameData(uint32_t frame) const
-        {
-            return data + GetFrameDataLength() * frame;
-        }
+        /// For streamed animations the frame is decoded on demand, until it is ready the previously returned frame is given,
+        /// or nullptr if no frame has been decoded yet.
+        uint8_t* GetFrameData(uint32_t frame);
+        const uint8_t* GetFrameData(uint32_t frame) const;
 
         uint32_t GetDataLength() const
         {
-            return GetWidth() * GetHeight() * GetNumberOfFrames() * GetBytesPerPixel();
+            if(IsCompressed()) {
+                return lineIndex.back();
+            }
+            return GetWidth() * GetHeight() * GetNumberOfStoredFrames() * GetBytesPerPixel();
         }
 
         uint32_t GetFrameDataLength() const
@@ -106,6 +109,12 @@ namespace grvl {
             return !data;
         }
 
+        /// Animated GIFs with more frames than fit the decoding ring are decoded during playback, instead of all at once.
+        bool IsStreamed() const
+        {
+            return stream != nullptr;
+        }
+
         Format GetColorFormat() const
         {
             return format;
@@ -121,14 +130,65 @@ namespace grvl {
             return rotated ? height : width;
         }
 
+        /// @return Palette of L8 or AL88 content as blue, green and red bytes per entry, or 0 for greyscale.
         uintptr_t GetColorPalette() const
         {
-            return 0;
+            return palette.empty() ? 0 : reinterpret_cast<uintptr_t>(palette.data());
         }
 
+        /// Converts the content to L8 (or AL88 if it has transparency) indexed through a palette of up to 256 colors.
+        ///
+        /// @param tolerance Largest allowed difference of a color channel from the original, 0 only allows lossless conversion.
+        /// @param dither Diffuse the quantization error to neighbouring pixels, only used if the conversion is lossy.
+        /// @return true if the content was converted, otherwise it is left unchanged.
+        bool Palettize(uint8_t tolerance = 0, bool dither = false);
+
+        /// Precomputes copies of the content at half the size of the previous one, used when it is drawn scaled down.
+        ///
+        /// Levels are kept in the color format of the content and follow its conversions, they are not saved to files.
+        /// @param levels Largest number of levels, fewer are created when the content gets smaller than 2x2 pixels.
+        void GenerateMipLevels(uint32_t levels = 4);
+        void ClearMipLevels();
+
+        uint32_t GetNumberOfMipLevels() const
+        {
+            return mipLevels.size();
+        }
+
+        /// @return Content scaled down by 2^level, the content itself for level 0.
+        const ImageContent* GetMipLevel(uint32_t level) const
+        {
+            return level == 0 || level > mipLevels.size() ? this : mipLevels[level - 1].get();
+        }
+
+        /// @return Color of the pointed to pixel of this content as ARGB8888, resolving palette indices.
+        uint32_t GetPixelColor(const uint8_t* pixel) const;
+
+        /// Saves the content, as it is stored in memory, to a file which can be loaded directly without decoding.
+        /// @return 0 on success, -1 if the file could not be written.
+        int Save(const char* path) const;
+
         void Transcode(Format format);
         void Rotate90();
 
+        /// Compresses every line of pixels with run-length encoding, the lines are decoded while drawing.
+        ///
+        /// Works well for flat colored artwork like icons or buttons. Content that would not get smaller is left uncompressed.
+        /// @return true if the content is now compressed.
+        bool Compress();
+        /// Leaves the content empty if the decompressed pixels can't be allocated.
+        void Decompress();
+
+        /// Compressed content can only be drawn with Painter::DrawImage, GetData and GetFrameData return encoded lines.
+        bool IsCompressed() const
+        {
+            return !lineIndex.empty();
+        }
+
+        /// Decodes a part of a compressed line into the given buffer, in the content color format.
+        /// @param line Index of the line as stored, lines of rotated content are columns of the image.
+        void DecodeLine(uint32_t frame, uint32_t line, uint32_t firstPixel, uint32_t pixels, uint8_t* output) const;
+
         bool IsAnimated() const
         {
             return frames > 1 && frameDurations.size() == static_cast<size_t>(frames);
@@ -149,10 +209,21 @@ namespace grvl {
 
     private:
         uint8_t* data;
+        bool ownsData = true; // false for image files used in place, e.g. from a mapped asset bundle
         int32_t width, height, frames;
         Format format;
         std::vector<uint32_t> frameDurations;
         bool rotated = false;
+        std::unique_ptr<FrameStream> stream;
+        std::vector<uint32_t> lineIndex; // offset of every encoded line in data, followed by the total length
+        std::vector<uint8_t> palette;
+        std::vector<std::unique_ptr<ImageContent>> mipLevels;
+
+        uint32_t GetNumberOfStoredFrames() const;
+        std::unique_ptr<ImageContent> Downsample() const;
+        bool LoadImageFile(const uint8_t* bytes, size_t size, const char* path, bool inPlace);
+        void FreeData();
+        void StartStream(std::shared_ptr<const std::vector<char>> source, std::shared_ptr<const GifLayout> layout);
     };
 
     /// Convert the pointed to pixel to a color, in the specific output format
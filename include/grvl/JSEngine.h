@@ -25,28 +25,89 @@
 
 #include <duktape.h>
 
+#include <deque>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace grvl {
 
     class JSEngine {
     public:
+        /// JavaScript function called by events, looked up once and kept in the heap stash with its constant arguments.
+        ///
+        /// The function is looked up again after scripts are loaded, as they may define it anew.
+        class Callback {
+        public:
+            explicit Callback(std::string functionName, Event::ArgVector args = {});
+            ~Callback();
+
+            Callback(const Callback&) = delete;
+            Callback& operator=(const Callback&) = delete;
+
+            /// Calls the function with the object of the caller, the constant arguments and then the given ones.
+            void Execute(void* caller, const Event::ArgVector& args = {});
+
+        private:
+            std::string functionName;
+            Event::ArgVector constantArgs;
+
+            void* function { nullptr };
+            std::vector<void*> arguments;
+            duk_uarridx_t slot { 0 }; // index of [function, arguments...] in the stashed callbacks array
+            uint32_t scriptGeneration { 0 };
+            uint32_t heapGeneration { 0 };
+
+            bool Resolve();
+            void Release();
+        };
+
         static void Initialize();
         static void Destroy();
 
         static void SetSourceCodeWorkingDirectory(std::string path);
+
+        /// Keeps compiled scripts in the directory, where they are found by the hash of their source.
+        ///
+        /// Cached bytecode is loaded instead of compiling the script, the directory may be in an asset bundle
+        /// in which case the cache is only read. Duktape doesn't validate bytecode, so the cache must be trusted.
+        static void SetBytecodeCacheDirectory(std::string path);
+        /// Removes cached bytecode which no script used since the cache directory was set, e.g. of scripts which changed since.
+        /// Called by Destroy, once all scripts are loaded. Caches in asset bundles are left as they are.
+        static void PruneBytecodeCache();
         static bool LoadJavaScriptCode(const std::string& filePath);
         static bool LoadJavaScriptCode(const char* code, std::size_t size);
         static void AddGlobalFunction(const char* functionName, duk_c_function func, duk_idx_t nargs);
         static void AddGlobalObject(const char* name, void* ptr, const std::unordered_map<const char*, duk_c_function>& methods);
         static void AddGlobalEnum(const std::string& enumName, const std::unordered_map<std::string, int>& values);
 
+        /// Sets how long scripts may run in a frame, event callbacks included, before the remaining timers,
+        /// animation frame callbacks and microtasks are deferred to the next frame. 0 disables the budget.
+        static void SetFrameBudget(uint32_t microseconds);
+        /// Starts a new frame budget, called at the start of every main loop iteration, whether it draws or not.
+        static void ResetFrameBudget();
+
+        /// Aborts scripts which run longer than the timeout with an error, 0 disables the timeout.
+        /// Duktape has to be built with the execution timeout check, see the GRVL_JS_EXECUTION_TIMEOUT option.
+        static void SetExecutionTimeout(uint32_t milliseconds);
+
+        /// Runs queued microtasks and due timers, as long as the frame budget allows.
+        static void RunScheduledTasks(uint64_t timestamp);
+        /// Runs the animation frame callbacks requested before the frame, callbacks requested by them run in the next one.
+        static void RunAnimationFrameCallbacks(uint64_t timestamp);
+
         static void MakeJavaScriptFunctionCall(const char* functionName);
         static void ExecuteJavaScriptCallback(const char* functionName, void* caller, const Event::ArgVector& args);
         static Event CreateJavaScriptFunctionCallEvent(const std::string& functionName, const Event::ArgVector& args);
-        static void RememberObject(void* objectPtr);
-        static void ForgetObject(void* objectPtr);
+        /// Keeps the object reachable until it is forgotten.
+        /// @return Slot of the object in the stash, used to forget it along with the heap generation.
+        static duk_uarridx_t RememberObject(void* objectPtr);
+        /// Slots remembered in a previous heap are ignored, their objects are gone with it.
+        static void ForgetObject(duk_uarridx_t slot, uint32_t heapGeneration);
+        /// Changes whenever the heap is created anew, objects of previous generations are gone.
+        static uint32_t GetHeapGeneration();
+        static void RetargetObject(void* objectPtr, Component* component);
 
         static duk_ret_t Print(duk_context* ctx);
         static duk_ret_t GetElementById(duk_context* ctx);
@@ -57,6 +118,11 @@ namespace grvl {
         static duk_ret_t GetTopPanel(duk_context* ctx);
         static duk_ret_t GetBottomPanel(duk_context* ctx);
         static duk_ret_t GetPrefabById(duk_context* ctx);
+        static duk_ret_t SetTimeout(duk_context* ctx);
+        static duk_ret_t SetInterval(duk_context* ctx);
+        static duk_ret_t ClearTask(duk_context* ctx);
+        static duk_ret_t RequestAnimationFrame(duk_context* ctx);
+        static duk_ret_t QueueMicrotask(duk_context* ctx);
 
         static constexpr duk_ret_t NO_RETURN_VALUE { 0 };
         static constexpr duk_ret_t RETURN_VALUE_PRESENT { 1 };
@@ -67,17 +133,57 @@ namespace grvl {
         static void RegisterBasicAPIFunctions();
 
         inline static duk_context* ctx;
-        inline static duk_uarridx_t lowestMaybeEmptyRememberedObjectIdx;
+        inline static duk_uarridx_t rememberedObjectCount;
+        inline static std::vector<duk_uarridx_t> freeRememberedObjectSlots;
+
+        inline static uint32_t scriptGeneration;
+        inline static uint32_t heapGeneration;
+        inline static duk_uarridx_t callbackSlotCount;
+        inline static std::vector<duk_uarridx_t> freeCallbackSlots;
+
+        struct Timer {
+            uint32_t id;
+            uint64_t due;
+            uint32_t interval; // 0 for timers which run once
+        };
+
+        inline static uint32_t taskCount;
+        inline static std::vector<Timer> timers; // sorted by due timestamp
+        inline static std::vector<uint32_t> animationFrameTasks;
+        inline static std::deque<uint32_t> microtasks;
+        inline static size_t frameBudget { 8000000 }; // in nanoseconds, as measured by Stopwatch
+        inline static size_t frameBudgetUsed { 0 };
+
+        static uint32_t AddTask(duk_idx_t functionIdx);
+        static uint32_t AddTimer(uint32_t delay, bool repeat);
+        static void InsertTimer(const Timer& timer);
+        static bool PushTask(uint32_t id, bool keep);
+        static bool HasTask(uint32_t id);
+        static void RemoveTask(uint32_t id);
+        static void RunMicrotasks();
+        static bool IsFrameBudgetLeft();
 
         static std::vector<char> LoadCodeFromFile(const char* filePath);
 
         inline static std::string sourceCodeWorkingDirectory;
+        inline static std::string bytecodeCacheDirectory;
+        inline static std::vector<std::string> usedBytecode; // names of the cache files of the loaded scripts
+
+        static bool LoadCachedJavaScriptCode(const char* code, std::size_t size);
+        static bool LoadBytecode(const std::string& path, uint64_t hash, std::size_t size);
+        static void SaveBytecode(const std::string& path, uint64_t hash, std::size_t size);
 
         static void PrepareJavaScriptFunctionCall(const char* functionName);
         static void ExecutePreparedJavaScriptFunctionCall(const char* functionName, int numOfArgs);
 
         static void PushRemeberedObjectsArray(duk_context* ctx);
         static constexpr const char* STASH_REMEBERED_OBJECTS_KEY { "rememberedObjects" };
+
+        static void PushCallbacksArray(duk_context* ctx);
+        static constexpr const char* STASH_CALLBACKS_KEY { "callbacks" };
+
+        static void PushTasksObject(duk_context* ctx);
+        static constexpr const char* STASH_TASKS_KEY { "tasks" };
     };
 
 } /* namespace grvl */
@@ -17,10 +17,13 @@
 #ifndef GRVL_MANAGER_H_
 #define GRVL_MANAGER_H_
 
+#include <grvl/FrameScheduler.h>
 #include <grvl/Misc.h>
 #include <grvl/Mutex.h>
 #include <grvl/Painter.h>
 #include <grvl/Queue.h>
+#include <grvl/Ring.h>
+#include <grvl/Stylesheet.h>
 #include <grvl/XMLSupport.h>
 #include <grvl/component/Button.h>
 #include <grvl/component/Checkbox.h>
@@ -51,8 +54,10 @@
 
 #include <tinyxml2.h>
 
+#include <atomic>
 #include <chrono>
 #include <map>
+#include <memory>
 #include <math.h>
 #include <string>
 #include <time.h>
@@ -80,6 +85,7 @@ namespace grvl {
 
         size_t fps = 0;
         float mspt = 0;
+        size_t missed_deadlines = 0;
         size_t js_time_this_frame = 0;
 
         SimpleRing<uint32_t, samples> draw_times;
@@ -102,7 +108,9 @@ namespace grvl {
         static void Initialize(uint32_t xSize, uint32_t ySize, int bpp, bool rotate90, uint8_t* framebuffer);
         static Manager& GetInstance();
 
-        typedef Queue<Event*> EventQueue;
+        // events are queued by components while handling input, and by the application from any thread,
+        // ProcessEvents in the main loop is the only consumer
+        typedef Ring<Event*, 256> EventQueue;
         typedef Queue<Popup*> PopupQueue;
 
         enum State {
@@ -137,9 +145,7 @@ namespace grvl {
             uint32_t repeat;
         };
 
-        std::unordered_map<std::string, char*> widgetAttributes;
-        std::unordered_map<std::string, char*> classAttributes;
-        std::unordered_map<std::string, char*> idAttributes;
+        Stylesheet stylesheet;
 
         virtual ~Manager();
         Panel* GetTopPanel();
@@ -175,7 +181,7 @@ namespace grvl {
         /// Changes currently displayed screen with optional animation.
         ///
         /// @param activeScreenId Identifier of a screen to display.
-        /// @param direction Direction of animation (-1 = to the left, 1 = to the right, 0 = no animation)
+        /// @param direction Direction of animation (-1 = to the left, 1 = to the right, 2 = cross-fade, 0 = no animation)
         Manager& SetActiveScreen(const char* activeScreenId, int8_t direction);
 
         /// Sets an image that is displayed while the application is loading its resources.
@@ -270,6 +276,13 @@ namespace grvl {
         /// @param id Numerical identifier of a screen (zero-based).
         /// @return Pointer to the screen or NULL if not found.
         AbstractView* GetScreen(int id);
+
+        /// Keeps screens as XML until they are first shown or looked up, instead of building all of them while loading.
+        ///
+        /// While idle, the screens named by the attributes (e.g. callbacks) of built screens are built first,
+        /// followed by the other ones. Has to be enabled before loading screens, whose elements must not be
+        /// looked up by scripts before the screen is built.
+        Manager& SetLazyScreenLoading(bool enabled);
         Image& GetBackgroundImage();
         Image& GetLoadingImage();
         State GetState();
@@ -290,6 +303,31 @@ namespace grvl {
         /// @param image Image content object.
         Manager& AddImageContentToContainer(std::string name, ImageContent* image);
 
+        /// Registers an image atlas in content manager.
+        ///
+        /// Each region of the atlas will be accessible for other
+        /// components as "<name>#<region>", e.g. contentId="icons#home".
+        ///
+        /// @param name Atlas' identifier.
+        /// @param image Image content holding all regions.
+        /// @param regions Named rectangles of the image.
+        Manager& AddImageAtlasToContainer(const std::string& name, ImageContent* image, const ContentManager::AtlasRegions& regions);
+
+        /// Loads an image atlas described by an XML manifest and registers it in content manager.
+        ///
+        /// The manifest lists the atlas image, relative to the manifest's directory, and its regions:
+        /// @code{.xml}
+        /// <atlas image="icons.png">
+        ///     <region name="home" x="0" y="0" width="32" height="32" />
+        /// </atlas>
+        /// @endcode
+        ///
+        /// @param name Atlas' identifier.
+        /// @param manifestPath Path of the manifest file.
+        /// @param format Color format the atlas image is loaded in.
+        /// @return -1 if the manifest or the image could not be loaded, 0 otherwise.
+        int32_t LoadImageAtlas(const std::string& name, const char* manifestPath, Format format = Format::ARGB8888);
+
         /// Binds registered image content to an image object.
         ///
         /// @param contentName Identifier of the content.
@@ -313,6 +351,12 @@ namespace grvl {
         Event GetOrCreateCallback(const std::string& callbackFunctionName, const Event::ArgVector& callbackArgs);
         Event GetOrCreateCallback(const CallbackDefinition& callbackDefinition);
 
+        /// Same as GetOrCreateCallback, but the returned function takes its args at the time it is called.
+        ///
+        /// @param callbackFunctionName Identifier of a function invoked by the callback.
+        /// @return Empty function if the name is empty.
+        Event::CallbackFunction GetOrCreateCallbackFunction(const std::string& callbackFunctionName);
+
         Division* GetPrefabByID(const char* id);
 
         /// Register font in content manager.
@@ -343,6 +387,34 @@ namespace grvl {
         /// @return Result of parsing the file (0 = OK, -1 = there was an error)
         int32_t BuildFromXML(const char* filename);
         int32_t BuildFromXMLString(const std::string& document);
+
+        /// Loads screens from a scene compiled by the gscn utility, which needs no XML or stylesheet parsing.
+        ///
+        /// @param filename Path to the scene file, scenes in an asset bundle are used in place.
+        /// @return Result of loading the scene (0 = OK, -1 = there was an error)
+        int32_t BuildFromScene(const char* filename);
+        int32_t BuildFromSceneData(const uint8_t* data, size_t size);
+
+        /// Keeps the layout loaded last, so it can be replaced by a new version with ReloadFromXML.
+        ///
+        /// Has to be enabled before loading the layout.
+        Manager& SetLayoutReloading(bool enabled);
+
+        /// Replaces the layout loaded last with a new version, rebuilding only what changed.
+        ///
+        /// Screens, popups and panels are compared with their previous version (with the stylesheet applied),
+        /// components are matched by their id and type. Unchanged components are kept, and the JavaScript
+        /// objects of rebuilt ones are moved to their replacements. Scripts, fonts, prefabs, the keyboard
+        /// and the configuration of the layout are not loaded again.
+        ///
+        /// Has to be called by the thread running MainLoopIteration, as queued events are processed before
+        /// the components they refer to are replaced. Called by an event callback, the layout is reloaded
+        /// after the remaining events, and errors of parsing it are only logged.
+        ///
+        /// @param filename Path to the file with the new screens definition.
+        /// @return Result of parsing the file (0 = OK, -1 = there was an error)
+        int32_t ReloadFromXML(const char* filename);
+        int32_t ReloadFromXMLString(const std::string& document);
         Event GetEventWithArguments(const char* eventName) const;
 
         // //Physical keys
@@ -364,10 +436,41 @@ namespace grvl {
 
         EventQueue& GetEventsQueueInstance();
 
+        /// Queues an event to be triggered by the main loop, may be called from any thread.
+        ///
+        /// Events which don't fit in the queue are kept in a list, triggered after the queue is drained.
+        void QueueEvent(Event* event);
+
         /// Executes an iteration of processing loop.
         ///
         /// This method handles pop-up windows, processes events and redraw screen if needed.
-        void MainLoopIteration();
+        /// It has to be called by the same thread every time, which becomes the drawing thread.
+        ///
+        /// @return true if a new frame was drawn.
+        bool MainLoopIteration();
+
+        /// Requests the screen to be redrawn as soon as possible.
+        ///
+        /// Called by components when their state changes. Requests made by the drawing thread while
+        /// drawing are ignored, as the frame being drawn already reflects them.
+        static void RequestRedraw();
+
+        /// Requests the screen to be redrawn at the given timestamp, e.g. when the next animation frame is due.
+        ///
+        /// MainLoopIteration skips drawing entirely until a redraw is due.
+        static void RequestRedraw(uint64_t timestamp);
+
+        /// Requests the frame after the one being drawn, for changes which the frame being drawn doesn't reflect,
+        /// e.g. ones deferred by callbacks called while drawing. Same as RequestRedraw() when not drawing.
+        static void RequestRedrawAfterFrame();
+
+        /// @return true if called by the drawing thread while it draws a frame.
+        static bool IsDrawingThread();
+
+        /// Returns the scheduler deciding when MainLoopIteration draws the next frame.
+        ///
+        /// Platforms can wait on it between iterations, and report vertical blanking timestamps to it.
+        FrameScheduler& GetFrameScheduler();
 
         void ResetScreens();
         void ClearBuffers();
@@ -398,6 +501,19 @@ namespace grvl {
         KeyMappingMap KeyMappingContainer;
         std::vector<AbstractView*> Screens;
 
+        struct PendingScreen {
+            XMLElement* element;
+            uint32_t index; // position in Screens, which holds nullptr until the screen is built
+        };
+
+        bool lazyScreenLoading { false };
+        bool layoutReloading { false };
+        std::unique_ptr<XMLDocument> layoutDocument;
+        std::vector<std::unique_ptr<XMLDocument>> screenDocuments;
+        std::vector<PendingScreen> pendingScreens;
+        std::vector<XMLElement*> likelyScreens;
+        uint64_t prebuildTime { 0 }; // longest time a screen took to prebuild, in milliseconds
+
         std::vector<Division*> Prefabs;
 
         Keyboard* keyboard { nullptr };
@@ -429,6 +545,9 @@ namespace grvl {
         int32_t dotDistance, dotRadius, dotYPos, debugDot;
         KeyData activeKey;
         EventQueue eventsQueue;
+        Mutex overflowEventsMutex {};
+        std::vector<Event*> overflowEvents {};
+        std::atomic<bool> eventsOverflowed { false };
         PopupQueue popupsQueue;
         ContentManager contentManager;
         float initialTransparency, desiredTransparency, currentTransparency;
@@ -436,17 +555,45 @@ namespace grvl {
         FontLoader font_callback = [](const std::string& font) { /* do nothing */ };
 
         Mutex DrawMutex {};
+        FrameScheduler frameScheduler {};
+        // read by any thread, drawingThread is written once, before drawing is first set
+        std::atomic<bool> drawing { false };
+        pthread_t drawingThread {};
+        bool drawingThreadSet { false };
+        std::atomic<bool> redrawAfterFrame { false };
+
+        bool processingEvents { false };
+        bool eventsProcessed { false };
+        pthread_t eventsThread {};
+        std::string pendingLayout {};
 
         // XML private
+        void BuildFromDocument(XMLNode* Root);
+        void KeepScreenDocument(std::unique_ptr<XMLDocument> document, size_t previouslyPending);
+        void AddScreenFromXML(XMLElement* element);
+        AbstractView* BuildScreen(XMLElement* element);
+        AbstractView* BuildPendingScreen(size_t pending);
+        void BuildPendingScreens();
+        bool PrebuildScreen(uint64_t timestamp);
+        void FindLikelyScreens(XMLElement* element);
+        void RemoveScreenAt(size_t index);
+        void ReloadLayout(XMLNode* previousRoot, const Stylesheet& previousStylesheet, XMLNode* root);
+        void ReloadScreens(XMLNode* previousRoot, const Stylesheet& previousStylesheet, XMLNode* root, const char* name);
+        void ReloadPopups(XMLNode* previousRoot, const Stylesheet& previousStylesheet, XMLNode* root);
+        Panel* ReloadPanel(Panel* panel, XMLElement* previous, const Stylesheet& previousStylesheet, XMLElement* next);
+        bool ReloadComponent(Component* component, XMLElement* previous, const Stylesheet& previousStylesheet, XMLElement* next);
+        bool ReloadElements(Container* container, XMLElement* previous, const Stylesheet& previousStylesheet, XMLElement* next);
+        void TransferJavaScriptObjects(Component* from, Component* to);
+        void DiscardComponent(Component* component);
         void ParseGuiConfiguration(XMLElement* ConfigNode);
         void ParseKeypadMapping(XMLElement* KeypadNode);
-        void ParseStylesheet(XMLElement* stylesheet);
+        void ParseStylesheet(XMLElement* stylesheetElement);
         void ParseFontStyles(XMLElement* stylesheet);
         void ParseScripts(XMLElement* scripts);
-        void ParseStyle(char* active_object, char* active_parameter, char* active_parameter_value);
 
         void ProcessEvents();
         bool UpdateAnimationWindowOffset();
+        void FinishTransition();
         void ShowPopup();
 
         void ApplyTransparency();
@@ -17,6 +17,7 @@
 #ifndef GRVL_PAINTER_H_
 #define GRVL_PAINTER_H_
 
+#include <grvl/Blitter.h>
 #include <grvl/Font.h>
 #include <grvl/Format.h>
 
@@ -40,6 +41,20 @@ namespace grvl {
         int32_t height;
     } background_block;
 
+    /// Rectangle of image content to draw, e.g. a single icon packed into an atlas.
+    struct ImageRegion {
+        int32_t x;
+        int32_t y;
+        int32_t width;
+        int32_t height;
+    };
+
+    /// Sampling used when an image is drawn at a size other than its own.
+    enum class ImageFilter : uint8_t {
+        Nearest,
+        Bilinear,
+    };
+
     /// Represents object used to draw graphics.
     class Painter {
     public:
@@ -142,6 +157,11 @@ namespace grvl {
         void FillTriangle(int16_t x1, int16_t x2, int16_t x3, int16_t y1, int16_t y2, int16_t y3, uint32_t color) const;
 
         void DrawImage(int16_t x, int16_t y, const ImageContent* image, uint32_t frame = 0) const;
+        void DrawImage(int16_t x, int16_t y, const ImageContent* image, uint32_t frame, const ImageRegion& region) const;
+
+        /// Draws the region of the image scaled to the given size, using the largest mip level of the image that is not smaller than it.
+        void DrawScaledImage(int16_t x, int16_t y, int32_t width, int32_t height, const ImageContent* image, uint32_t frame,
+                             const ImageRegion& region, ImageFilter filter = ImageFilter::Bilinear) const;
         void DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t color) const;
         void DrawAntialiasedLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t color) const;
         void DrawVLine(int32_t Xpos, int32_t Ypos, int32_t Length, uint32_t text_color) const;
@@ -154,6 +174,18 @@ namespace grvl {
 
         void SetLayerAddress(uint32_t display);
 
+        /// @return Fence of the blitter operations submitted so far, 0 for blitters completing them right away.
+        BlitFence GetBlitFence() const;
+
+        /// Waits until the blitter operations up to the fence are done, before the CPU accesses memory they use.
+        void WaitForBlit(BlitFence fence) const;
+
+        /// Waits until all submitted blitter operations are done.
+        void WaitForBlitter() const;
+
+        /// Submits the queued blitter operations as a single batch.
+        void FlushBlits() const;
+
         void DmaOperation(uintptr_t inputMem, uintptr_t backgroundMem, uintptr_t outputMem, uint32_t PixelsPerLine,
                           uint32_t NumberOfLines, uint32_t inOffset, uint32_t backgroundOffset, uint32_t outOffset,
                           Format inPixelFormat, Format backgroundPixelFormat, Format outPixelFormat,
@@ -163,6 +195,10 @@ namespace grvl {
                              uint32_t NumberOfLines, uint32_t inOffset, uint32_t backgroundOffset, uint32_t outOffset,
                              Format inPixelFormat, Format backgroundPixelFormat, Format outPixelFormat, uintptr_t backCLT, uintptr_t frontCLT) const;
 
+        void DmaBlend(uintptr_t inputMem, uintptr_t backgroundMem, uintptr_t outputMem, uint32_t PixelsPerLine,
+                      uint32_t NumberOfLines, uint32_t inOffset, uint32_t backgroundOffset, uint32_t outOffset,
+                      Format inPixelFormat, Format backgroundPixelFormat, Format outPixelFormat, uint8_t alpha) const;
+
         void DmaFill(uintptr_t outputMem, uint32_t PixelsPerLine, uint32_t NumberOfLines, uint32_t outOffset,
                      uint32_t color_index, Format pixel_format) const;
 
@@ -173,6 +209,13 @@ namespace grvl {
                           int32_t width, int32_t height, int32_t totalImageWidth, int32_t totalImageHeight, uint32_t activeFrame,
                           uint32_t frames, Format inPixelFormat, Format outPixelFormat, bool hasAlpha, uintptr_t imageCLT = 0) const;
 
+        /// Draws compressed image content, decoding the visible part of each line into a strip buffer which is then blitted.
+        void DmaMoveCompressedImage(const ImageContent* image, uint32_t frame, uintptr_t fb_dst, const ImageRegion& region, int32_t x_dst, int32_t y_dst) const;
+
+        /// Draws scaled image content, sampling the source lines into a strip buffer which is then blitted.
+        void DmaMoveScaledImage(const ImageContent* image, uint32_t frame, uintptr_t fb_dst, const ImageRegion& region, int32_t x_dst, int32_t y_dst,
+                                int32_t width, int32_t height, ImageFilter filter) const;
+
         void DmaMoveFont(uintptr_t font_src, uintptr_t font_dst, int32_t x_src, int32_t y_src, int32_t x_dst, int32_t y_dst,
                          int32_t width, int32_t height, int32_t fontWidth, int32_t fontHeight, Format outPixelFormat,
                          uint32_t fontColor) const;
@@ -234,12 +277,36 @@ namespace grvl {
         ContentManager* contentManager;
         bool is_rotated;
         ImageContent* shadowImage;
+
+        // Compressed and scaled images are decoded into alternating strips, so the next strip can be decoded while the previous one is blitted
+        static constexpr uint32_t decodeStripSize = 8 * 1024;
+        mutable std::array<std::vector<uint8_t>, 2> decodeStrips {};
+        mutable uint8_t decodeStripIndex { 0 };
+        mutable std::array<BlitFence, 2> decodeStripFences {};
+
+        // Blitter operations are queued into a batch, until one of them uses memory written by another,
+        // the drawing bounds change or the CPU accesses the results
+        static constexpr uint32_t blitBatchSize = 64;
+        mutable std::array<BlitDescriptor, blitBatchSize> blitBatch {};
+        mutable uint32_t blitBatchCount { 0 };
+
+        void QueueBlit(const BlitDescriptor& descriptor) const;
+
+        // Source lines of a scaled image converted to ARGB8888, two are needed for bilinear sampling
+        mutable std::array<std::vector<uint32_t>, 2> scaleSourceLines {};
+
+        uint32_t PrepareDecodeStrips() const;
+
+        /// @return Index of the next decode strip, once the blits from it are done.
+        uint8_t NextDecodeStrip() const;
+
         void DrawSpansBetweenEdges(const Edge& e1, const Edge& e2) const;
         void DrawSpan(int x1, int x2, uint32_t color, int y) const;
 
         constexpr float ToRadians(float eulerAngles) const;
 
     private:
+        void DecompressBackgroundImage();
         void InnerDisplayAntialiasedString(Font* Font, int16_t Xpos, int16_t Ypos, const char* Text, uint32_t text_color, bool bounded, int16_t ParentX,
                                            int16_t ParentY, int16_t ParentWidth, int16_t ParentHeight, uint32_t background = 0) const;
     };
@@ -0,0 +1,43 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GRVL_PIXELCONVERSION_H_
+#define GRVL_PIXELCONVERSION_H_
+
+#include <grvl/Format.h>
+
+#include <stdint.h>
+
+namespace grvl {
+
+    /// Converts a run of pixels to another format, the same way as ConvertPixel does for a single one.
+    ///
+    /// The conversion is chosen once for the pair of formats, so the loop over the pixels has no branches
+    /// and the compiler can vectorize it. The input and output must not overlap, unless both formats are the same.
+    void ConvertPixels(const uint8_t* in, uint8_t* out, uint32_t count, Format input, Format output);
+
+    /// Swaps the red and blue channels of ARGB8888 pixels in place,
+    /// turning the RGBA byte order of decoded images into the channel order of grvl.
+    void SwapRedBlue(uint8_t* pixels, uint32_t count);
+
+    /// Rotates a frame CCW into the output, which must not overlap the input (see ImageContent::Rotate90).
+    ///
+    /// The frame is transposed in small blocks, so both the rows read and the columns written stay in the cache.
+    void RotatePixels90(const uint8_t* in, uint8_t* out, uint32_t width, uint32_t height, uint32_t stride);
+
+} /* namespace grvl */
+
+#endif /* GRVL_PIXELCONVERSION_H_ */
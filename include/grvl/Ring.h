@@ -0,0 +1,113 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GRVL_RING_H_
+#define GRVL_RING_H_
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+namespace grvl {
+
+    /// Bounded queue with preallocated slots, which any thread may push to and a single thread pops from.
+    ///
+    /// Neither end allocates or takes a lock. Every slot has a sequence number, telling producers whether
+    /// the slot is free in the current round and the consumer whether the element in it has been written.
+    template <class T, size_t Capacity>
+    class Ring {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Ring capacity has to be a power of two");
+
+    public:
+        Ring();
+
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+
+        /// @return False if the ring is full, the element is dropped then.
+        bool push(T element);
+        /// Must only be called by the consumer thread.
+        std::optional<T> pop();
+
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence;
+            T element;
+        };
+
+        std::array<Slot, Capacity> slots;
+
+        // producers and the consumer write to separate cache lines
+        alignas(64) std::atomic<size_t> head { 0 };
+        alignas(64) size_t tail { 0 };
+    };
+
+    template <class T, size_t Capacity>
+    Ring<T, Capacity>::Ring()
+    {
+        for(size_t i = 0; i < Capacity; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template <class T, size_t Capacity>
+    bool Ring<T, Capacity>::push(T element)
+    {
+        size_t position = head.load(std::memory_order_relaxed);
+
+        while(true) {
+            Slot& slot = slots[position & (Capacity - 1)];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if(difference == 0) {
+                // the slot is free, claim it unless another producer did
+                if(head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.element = std::move(element);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(difference < 0) {
+                // the slot still holds the element of the previous round
+                return false;
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <class T, size_t Capacity>
+    std::optional<T> Ring<T, Capacity>::pop()
+    {
+        Slot& slot = slots[tail & (Capacity - 1)];
+
+        // empty, or the producer which claimed the slot is still writing it
+        if(slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+            return std::nullopt;
+        }
+
+        std::optional<T> result { std::move(slot.element) };
+        slot.sequence.store(tail + Capacity, std::memory_order_release);
+        tail++;
+        return result;
+    }
+
+} /* namespace grvl */
+
+#endif /* GRVL_RING_H_ */
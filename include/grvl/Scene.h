@@ -0,0 +1,97 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GRVL_SCENE_H_
+#define GRVL_SCENE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tinyxml2.h>
+
+namespace grvl {
+
+    static constexpr char sceneMagic[8] = {'g', 'r', 'v', 'l', 's', 'c', 'n', '\0'};
+    static constexpr uint32_t sceneVersion = 0;
+
+    // Marks a missing child, sibling or text of an element
+    static constexpr uint32_t sceneNone = 0xFFFFFFFF;
+
+    // All fields are stored big endian, the header is followed by the element table, the attribute table
+    // and the table of null terminated strings, all references are offsets or indices into them.
+    // Element 0 is the root of the layout, with the stylesheet already applied to the attributes.
+    struct SceneHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t elements;
+        uint32_t attributes;
+        uint32_t strings; // size of the string table in bytes
+    };
+
+    struct SceneElement {
+        uint32_t name; // offset of the tag name in the string table
+        uint32_t text; // offset of the text content in the string table, or sceneNone
+        uint32_t firstAttribute; // index of the first attribute of the element
+        uint32_t attributeCount;
+        uint32_t firstChild; // index of the first child element, or sceneNone
+        uint32_t nextSibling; // index of the next sibling element, or sceneNone
+    };
+
+    struct SceneAttribute {
+        uint32_t name; // offset of the name in the string table
+        uint32_t value; // offset of the value in the string table
+    };
+
+    static_assert(sizeof(SceneHeader) == 24, "Scene header has unexpected padding");
+    static_assert(sizeof(SceneElement) == 24, "Scene element has unexpected padding");
+    static_assert(sizeof(SceneAttribute) == 8, "Scene attribute has unexpected padding");
+
+    /// Layout compiled ahead of time by the gscn utility, used in place from memory.
+    ///
+    /// A scene holds the element tree of a layout without any text to parse, and without the stylesheet,
+    /// as the attributes it sets are already stored in the elements it applies to.
+    class Scene {
+    public:
+        /// Uses a scene that is already in memory, which has to outlive the scene object.
+        Scene(const uint8_t* data, size_t size);
+
+        bool IsValid() const
+        {
+            return elements != nullptr;
+        }
+
+        /// Builds the element tree in the document, for the widget builders which take XML elements.
+        /// Only the tree is built, there is no text to tokenize and no stylesheet to apply.
+        /// @return Root element of the layout, or nullptr if the scene is invalid.
+        tinyxml2::XMLElement* Load(tinyxml2::XMLDocument& document) const;
+
+    private:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+
+        const uint8_t* elements = nullptr;
+        uint32_t elementCount = 0;
+        const uint8_t* attributes = nullptr;
+        const char* strings = nullptr;
+
+        bool Parse();
+        SceneElement GetElement(uint32_t index) const;
+        SceneAttribute GetAttribute(uint32_t index) const;
+        const char* GetString(uint32_t offset) const;
+    };
+
+} /* namespace grvl */
+
+#endif /* GRVL_SCENE_H_ */
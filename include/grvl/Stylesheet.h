@@ -0,0 +1,91 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef GRVL_STYLESHEET_H_
+#define GRVL_STYLESHEET_H_
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <tinyxml2.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace grvl {
+
+    /// Attributes set by the stylesheet of a layout, by the widget, class ('.') or id ('#') they apply to.
+    ///
+    /// All names and values are interned, so properties are compared by pointer and rules are found
+    /// without building a key. While building a layout, the rules applying to an element are merged
+    /// into a single block the first time it is looked up.
+    class Stylesheet {
+    public:
+        struct Property {
+            const char* name;
+            const char* value;
+        };
+
+        using PropertyBlock = std::vector<Property>;
+
+        /// Keeps the resolved blocks of elements for as long as it exists, the elements must outlive it.
+        class Scope {
+        public:
+            explicit Scope(Stylesheet& stylesheet);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Stylesheet& stylesheet;
+        };
+
+        /// Adds the rules of the stylesheet text, later rules replace earlier ones.
+        void Parse(const char* text);
+        void AddProperty(const char* object, const char* attribute, const char* value);
+        void Clear();
+
+        bool IsEmpty() const
+        {
+            return widgetRules.empty() && classRules.empty() && idRules.empty();
+        }
+
+        /// @return Value the stylesheet sets for the attribute of the element, or nullptr.
+        const char* Find(const tinyxml2::XMLElement* element, const char* attributeName);
+
+        /// Merges the rules of the id, class and widget of the element, in that order of precedence.
+        PropertyBlock Resolve(const tinyxml2::XMLElement* element) const;
+
+    private:
+        using Rules = std::unordered_map<std::string_view, PropertyBlock>;
+
+        std::unordered_set<std::string> strings;
+        Rules widgetRules;
+        Rules classRules;
+        Rules idRules;
+
+        std::unordered_map<const tinyxml2::XMLElement*, PropertyBlock> resolved;
+        uint32_t scopes = 0;
+
+        const char* Intern(const char* text);
+        static const char* FindInBlock(const PropertyBlock& block, const char* attributeName);
+        static void Merge(PropertyBlock& block, const Rules& rules, const char* name);
+    };
+
+} /* namespace grvl */
+
+#endif /* GRVL_STYLESHEET_H_ */
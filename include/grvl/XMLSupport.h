@@ -20,6 +20,7 @@
 #include <grvl/Alignment.h>
 #include <grvl/CallbackDefinition.h>
 
+#include <functional>
 #include <string>
 #include <tinyxml2.h>
 #include <unordered_map>
@@ -30,6 +31,9 @@ namespace grvl {
 
     class XMLSupport {
     public:
+        /// Called for every attribute set by a stylesheet, the object keeps its '.' or '#' prefix.
+        using StyleCallback = std::function<void(const char* object, const char* attribute, const char* value)>;
+
         static uint32_t GetAttributeOrDefault(XMLElement* element, const char* attributeName, uint32_t defaultValue);
         static int32_t GetAttributeOrDefault(XMLElement* element, const char* attributeName, int32_t defaultValue);
         static bool GetAttributeOrDefault(XMLElement* element, const char* attributeName, bool defaultValue);
@@ -44,6 +48,8 @@ namespace grvl {
 
         static uint32_t ParseColor(XMLElement* xmlElement, const char* attributeName, const char* defaultValue);
         static uint32_t ParseColor(XMLElement* xmlElement, const char* attributeName, uint32_t defaultValue);
+
+        static void ParseStylesheet(const char* stylesheet, const StyleCallback& callback);
     };
 
 } /* namespace grvl */
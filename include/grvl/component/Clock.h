@@ -78,6 +78,7 @@ namespace grvl {
         static Clock* BuildFromXML(XMLElement* xmlElement);
 
         void Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY) override;
+        bool IsDirty() const override;
 
         void SetTimeFormat(const char* fmt);
 
@@ -29,13 +29,15 @@
 #include <tinyxml2.h>
 
 #include <stdint.h>
+#include <type_traits>
 #include <unordered_map>
 
 namespace grvl {
 
 #define WIDGET2(id, name)                                                                                                    \
     static Component* WidgetCreate##name##id(XMLElement* xmlElement) { return (Component*)name::BuildFromXML(xmlElement); }; \
-    void __attribute__((used))* TEMP_##name##id = register_widget_constructor((void*)&WidgetCreate##name##id, (char*)#name);
+    void __attribute__((used))* TEMP_##name##id = register_widget_constructor((void*)&WidgetCreate##name##id, #name,        \
+                                                                              std::integral_constant<uint32_t, HashWidgetName(#name)>::value);
 #define WIDGET1(id, name) WIDGET2(id, name)
 #define WIDGET(name) WIDGET1(__COUNTER__, name)
 
@@ -90,17 +92,22 @@ namespace grvl {
         return 0;                                                        \
     }
 
-    typedef struct {
-        void* fun;
-        char name[80];
-    } component_list_item;
-
-    extern int ComponentCount;
-    extern component_list_item list[150];
+    /// Case insensitive FNV-1a hash of a widget tag, widgets registered with WIDGET get it at compile time
+    constexpr uint32_t HashWidgetName(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for(; *name; name++) {
+            const char lower = (*name >= 'A' && *name <= 'Z') ? *name - 'A' + 'a' : *name;
+            hash = (hash ^ static_cast<uint8_t>(lower)) * 16777619u;
+        }
+        return hash;
+    }
 
+    void* register_widget_constructor(void* con, const char* nm, uint32_t hash);
     void* register_widget_constructor(void* con, char* nm);
     class Component;
     Component* create_component(const char* nm, void* el);
+    bool component_exists(const char* nm);
 
     /// Represents base class for all widgets.
     class Component {
@@ -204,7 +211,7 @@ namespace grvl {
         void SetOnLongPressEvent(const Event& event);
         void SetOnLongPressRepeatEvent(const Event& event);
 
-        virtual void SetIsFocused(bool value) { isFocused = value; }
+        virtual void SetIsFocused(bool value) { isFocused = value; Invalidate(); }
         bool IsFocused() const { return isFocused; }
 
         virtual Touch::TouchResponse ProcessTouch(const Touch& tp, int32_t ParentX, int32_t ParentY, int32_t modificator = 0);
@@ -215,6 +222,14 @@ namespace grvl {
 
         virtual void Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY) = 0;
 
+        /// Marks the component as changed since it was last drawn.
+        ///
+        /// Containers retaining previously rendered pixels (see VerticalScrollView)
+        /// redraw only the children that report themselves as dirty.
+        void Invalidate();
+        virtual bool IsDirty() const;
+        virtual void ClearDirty();
+
         void AddMetadata(std::string key, std::string value);
         const char* GetMetadata(const char* key);
 
@@ -224,6 +239,9 @@ namespace grvl {
 
         void PushJSObjectOnStack(duk_context* ctx);
 
+        /// Moves the JavaScript object of the other component to this one, e.g. when the other one is rebuilt.
+        void TakeJavaScriptObject(Component& other);
+
         GENERATE_DUK_STRING_GETTER(Component, ID, GetID)
         GENERATE_DUK_STRING_GETTER(Component, ParentID, GetParentID)
 
@@ -297,6 +315,7 @@ namespace grvl {
         Event onLongPressRepeat {};
 
         bool Visible { true };
+        bool Dirty { true };
 
         std::unordered_map<std::string, std::string> metadata;
 
@@ -313,6 +332,8 @@ namespace grvl {
         virtual void InitFromXML(tinyxml2::XMLElement* xmlElement);
 
         void* JavascriptObject { nullptr };
+        duk_uarridx_t JavascriptObjectSlot { 0 }; // slot in the remembered objects of JSEngine
+        uint32_t JavascriptObjectHeap { 0 }; // heap generation the object was created in
     };
 
 } /* namespace grvl */
@@ -48,8 +48,8 @@ namespace grvl {
         void SetTextColor(uint32_t textColor);
         void SetTextFont(Font* font);
 
-        void SetStartingGradientColor(uint32_t startingGradientColor) { GradientStartColor = startingGradientColor; }
-        void SetEndingGradientColor(uint32_t endingGradientColor) { GradientEndColor = endingGradientColor; }
+        void SetStartingGradientColor(uint32_t startingGradientColor) { GradientStartColor = startingGradientColor; Invalidate(); }
+        void SetEndingGradientColor(uint32_t endingGradientColor) { GradientEndColor = endingGradientColor; Invalidate(); }
 
         void AddData(float value);
         void ClearData();
@@ -38,10 +38,14 @@ namespace grvl {
     /// * y                       - widget position on y axis in pixels
     /// * visible                 - indicates if the widget is visible
     ///
+    /// * width                   - width the image is scaled to (default: deduced from image content)
+    /// * height                  - height the image is scaled to (default: deduced from image content)
+    /// * filter                  - sampling of scaled images, nearest or bilinear (default: bilinear)
+    ///
     /// * contentId               - identifier of image content to display (default: none)
     ///
     /// @remark
-    /// Width and height of a widget are deduced from image content.
+    /// If only one of width and height is given, the other one keeps the aspect ratio of image content.
     class Image : public Component {
     public:
         Image()
@@ -72,6 +76,11 @@ namespace grvl {
 
         void RestartAnimation();
 
+        /// Sets the size the image content is scaled to when drawn, 0 keeps the content size or its aspect ratio if the other one is set.
+        void SetScaledSize(int32_t width, int32_t height);
+
+        void SetFilter(ImageFilter filter);
+
         ImageContent* GetContent()
         {
             return HasContent() ? Delegate->Get() : nullptr;
@@ -127,6 +136,7 @@ namespace grvl {
         static Image* BuildFromXML(XMLElement* xmlElement);
 
         void Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY) override;
+        bool IsDirty() const override;
 
     private:
         uint32_t ActiveFrame;
@@ -136,7 +146,13 @@ namespace grvl {
         bool AnimationLoop;
         std::chrono::steady_clock::time_point LastFrameChange;
 
+        int32_t ScaledWidth{0};
+        int32_t ScaledHeight{0};
+        ImageFilter Filter{ImageFilter::Bilinear};
+
         void updateAnimation();
+        bool isNextFrameDue() const;
+        void requestNextFrame() const;
     };
 
 } /* namespace grvl */
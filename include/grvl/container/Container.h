@@ -52,6 +52,12 @@ namespace grvl {
         virtual void AddElement(Component* el);
         virtual void RemoveElement(const char* elementId);
 
+        /// Replaces all elements, the previous ones are not deleted.
+        void ReplaceElements(const std::vector<Component*>& elements);
+
+        /// Whether the container positions its elements itself while they are added.
+        virtual bool LaysOutElements() const { return false; }
+
         void SetIsFocused(bool value) override;
         bool IsSelection() const { return isSelection; }
         virtual void SetAsSelection(bool value);
@@ -61,6 +67,9 @@ namespace grvl {
 
         Touch::TouchResponse ProcessTouch(const Touch& tp, int32_t ParentX, int32_t ParentY, int32_t modificator = 0) override;
 
+        bool IsDirty() const override;
+        void ClearDirty() override;
+
         void PopulateJavaScriptObject(JSObjectBuilder& jsObjectBuilder) override;
         static duk_ret_t JSGetElementByIdWrapper(duk_context* ctx);
         static duk_ret_t JSGetElementByIndexWrapper(duk_context* ctx);
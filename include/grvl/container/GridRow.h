@@ -54,6 +54,7 @@ namespace grvl {
         Component* Clone() const override;
 
         void AddElement(Component* item) override;
+        bool LaysOutElements() const override { return true; }
 
         void SetSize(int32_t width, int32_t height) override;
 
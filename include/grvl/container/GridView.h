@@ -46,6 +46,7 @@ namespace grvl {
     /// * overscrollColor         - overscrolled area color (default: light gray)
     /// * overscrollHeight        - overscrolled area height in pixels (default: 50)
     /// * scrollIndicatorColor    - scroll indicator color (default: transparent)
+    /// * scrollBlitting          - indicates if pixels rendered in the previous frame are reused while scrolling (default: true)
     ///
     /// * elementWidth            - grid element width in pixels (default: 0)
     /// * elementHeight           - grid element height in pixel (default: 0)
@@ -20,10 +20,30 @@
 #include <grvl/Painter.h>
 #include <grvl/component/ListItem.h>
 #include <grvl/container/VerticalScrollView.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace grvl {
 
+    /// Describes items of a virtualized ListView.
+    struct ListDataSource {
+        using BindCallback = std::function<void(Component* item, uint32_t index)>;
+        using HeightCallback = std::function<int32_t(uint32_t index)>;
+
+        /// Number of items in the list.
+        uint32_t itemCount { 0 };
+
+        /// Fills the recycled item component with the content of the item at the given index.
+        BindCallback bindItem {};
+
+        /// Optional, returns the height of the item at the given index. The item template height is used if not set.
+        HeightCallback itemHeight {};
+    };
+
     /// Vertical list view widget.
     ///
     /// XML parameters:
@@ -38,6 +58,7 @@ namespace grvl {
     /// * overscrollColor         - overscrolled area color (default: light gray)
     /// * overscrollHeight        - overscrolled area height in pixels (default: 50)
     /// * scrollIndicatorColor    - scroll indicator color (default: transparent)
+    /// * scrollBlitting          - indicates if pixels rendered in the previous frame are reused while scrolling (default: true)
     ///
     /// * splitLineColor          - color of the line drawn between list elements (default: transparent)
     ///
@@ -45,9 +66,14 @@ namespace grvl {
     /// * backgroundColor         - widget background color (default: transparent)
     /// * collection              - collection of elements
     ///
+    /// * itemCount               - number of items of a virtualized list (default: 0)
+    /// * itemTemplate            - identifier of the prefab used as a virtualized list item (default: none)
+    ///
     /// XML events:
     /// * onSlideLeft             - event invoked when widget is scrolled to the left
     /// * onSlideRight            - event invoked when widget is scrolled to the right
+    /// * onBindItem              - event invoked when a virtualized list item is bound to a new index,
+    ///                             with the item and its index as arguments
     ///
     /// @remark
     /// XML node describing this widget can contain child nodes
@@ -55,6 +81,10 @@ namespace grvl {
     /// * listItem
     /// * panel (as a header)
     ///
+    /// A list with an item template is virtualized: instead of holding a component for every item,
+    /// it keeps only the components covering the visible part of the list, and binds them to item
+    /// indices as they scroll into the view.
+    ///
     class ListView : public VerticalScrollView {
     public:
         ListView()
@@ -74,6 +104,8 @@ namespace grvl {
         void AddElement(Component* component) override;
         void RemoveElement(const char* elementId) override;
 
+        void Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY) override;
+
         void SetVerticalGap(float value);
 
         void Refresh();
@@ -82,10 +114,67 @@ namespace grvl {
         void ClearList();
         bool AddToList(Manager* man, std::string& listContent);
 
+        /// Makes the list virtualized, replacing its current elements.
+        ///
+        /// Called while the list is being drawn (e.g. by the bind callback), the change is applied before it is drawn next,
+        /// same as ClearList, Refresh and SetItemCount.
+        ///
+        /// @param itemTemplate Component cloned to create the recycled item components.
+        /// @param source Describes the items of the list.
+        void SetDataSource(const Component& itemTemplate, const ListDataSource& source);
+
+        /// Same as above, using a prefab as the item template and a C++ or JavaScript bind callback.
+        ///
+        /// @return false if there is no prefab with the given identifier.
+        bool SetDataSource(const char* prefabId, uint32_t itemCount, const std::string& bindCallbackName);
+
+        /// Changes the number of items of a virtualized list, all visible items are bound again.
+        void SetItemCount(uint32_t count);
+        uint32_t GetItemCount() const;
+
+        /// Binds all visible items of a virtualized list again, e.g. after their content has changed.
+        void ReloadItems();
+
+        bool IsVirtualized() const;
+
         static ListView* BuildFromXML(XMLElement* xmlElement);
 
+        void PopulateJavaScriptObject(JSObjectBuilder& jsObjectBuilder) override;
+        static duk_ret_t JSSetDataSourceWrapper(duk_context* ctx);
+        static duk_ret_t JSReloadItemsWrapper(duk_context* ctx);
+
+        GENERATE_DUK_UNSIGNED_INT_GETTER(ListView, ItemCount, GetItemCount)
+        GENERATE_DUK_UNSIGNED_INT_SETTER(ListView, ItemCount, SetItemCount)
+
+    protected:
+        void PrepareVisibleElements(int32_t scroll) override;
+
     private:
+        static constexpr uint32_t unboundItem = UINT32_MAX;
+
         uint32_t verticalGap { 0 };
+
+        std::shared_ptr<Component> itemTemplate {};
+        ListDataSource dataSource {};
+        std::vector<int32_t> itemOffsets {}; // Cumulative heights, itemCount + 1 entries
+        std::vector<uint32_t> boundItems {}; // Index of the item bound to each element
+        bool reloadRequested { false };
+
+        // Changes requested while the list is being drawn, applied before it is drawn next
+        bool beingDrawn { false };
+        bool clearRequested { false };
+        bool refreshRequested { false };
+        std::optional<uint32_t> requestedItemCount {};
+        std::unique_ptr<Component> requestedItemTemplate {};
+        ListDataSource requestedDataSource {};
+
+        bool IsBeingDrawn() const;
+        void ApplyRequestedChanges();
+
+        void UpdateScrollIndicator();
+        void UpdateItemOffsets();
+        uint32_t FindFirstVisibleItem(int32_t scroll) const;
+        void BindElement(uint32_t element, uint32_t index);
     };
 
 } /* namespace grvl */
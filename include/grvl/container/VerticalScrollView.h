@@ -22,10 +22,17 @@
 #include <grvl/component/ListItem.h>
 #include <grvl/container/AbstractView.h>
 
+#include <vector>
+
 namespace grvl {
 
     /// Represents widget allowing to scroll its content vertically.
     ///
+    /// While the content is being scrolled, the view keeps a copy of the pixels it rendered
+    /// in the previous frame and shifts them by the scroll change, drawing only the newly
+    /// exposed rows and the children reporting themselves as dirty (see Component::Invalidate).
+    /// A still view is always drawn from scratch.
+    ///
     class VerticalScrollView : public AbstractView {
     public:
         VerticalScrollView()
@@ -40,6 +47,7 @@ namespace grvl {
 
         void AddElement(Component* component) override;
         void RemoveElement(const char* elementId) override;
+        bool LaysOutElements() const override { return true; }
 
         void SetScrollingValue(int32_t scrollVal);
         void SetSplitLineColor(uint32_t color);
@@ -64,6 +72,11 @@ namespace grvl {
         void SetOverscrollBar(bool enable);
         void SetOverscrollBarSize(int32_t size);
 
+        /// Enables reusing previously rendered pixels while scrolling.
+        ///
+        /// Costs an additional buffer of the view size in the framebuffer pixel format.
+        void SetScrollBlitting(bool enable);
+
         void Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY) override;
 
         virtual void SetSize(int32_t width, int32_t height);
@@ -110,8 +123,33 @@ namespace grvl {
         Mutex ClearWhileDrawMutex {};
         Mutex ClearWhileTouchMutex {};
 
+        struct RowSpan {
+            int32_t start;
+            int32_t end;
+        };
+
+        bool scrollBlittingEnabled { true };
+        bool retainedContentValid { false };
+        int32_t retainedX { 0 };
+        int32_t retainedY { 0 };
+        int32_t retainedScroll { 0 };
+        Format retainedFormat { Format::ARGB8888 };
+        std::vector<uint8_t> retainedContent {};
+        std::vector<RowSpan> damagedRows {};
+
         virtual void AdjustScrollViewHeight(Component* child);
 
+        /// Called before drawing, allows to update elements intersecting the visible part of the content.
+        ///
+        /// @param scroll Offset of the visible part of the content, including overscroll.
+        virtual void PrepareVisibleElements(int32_t /*scroll*/) { }
+
+        bool CanRetainContent(const Painter& painter, int32_t renderX, int32_t renderY) const;
+        bool CanReuseRetainedContent(const Painter& painter, int32_t renderX, int32_t renderY, int32_t scrollShift) const;
+        void CollectDamagedRows(int32_t scroll, int32_t scrollShift);
+        void RestoreRetainedContent(const Painter& painter, int32_t renderX, int32_t renderY, int32_t scrollShift) const;
+        void StoreRetainedContent(const Painter& painter, int32_t renderX, int32_t renderY, int32_t scroll);
+
         void InitFromXML(XMLElement* xmlElement);
 
         virtual Component* TryToGetElementFromChildContainer(Component* possible_container, const char* searched_component_id);
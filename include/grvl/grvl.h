@@ -44,6 +44,16 @@ namespace grvl {
         [[deprecated("Use .logger")]]
         void (*gui_printf)(const char* text, va_list argList);
         uint64_t (*get_timestamp)(void);
+
+        // optional, for blitters completing operations asynchronously
+        BlitFenceFunction blit_fence;
+        BlitWaitFunction wait_for_blit;
+
+        // optional, runs many operations at once, by default the operations are sorted by their formats
+        DmaBlitBatchFunction blit_batch;
+
+        // optional, blends the input over the background with the given opacity
+        DmaBlendFunction blend;
     } gui_callbacks_t;
 
     /// Class used to initialize the library.
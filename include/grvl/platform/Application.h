@@ -20,6 +20,7 @@ namespace grvl {
         int height = 100;
         bool sideways = false;
         bool should_run = true;
+        bool frame_drawn = false;
 
         static inline Application* instance;
         uint8_t* framebuffer;
@@ -44,8 +45,8 @@ namespace grvl {
         // of the main render loop, from the same thread as Render(), after all rendering is complete.
         virtual void Swap() = 0;
 
-        // Poll user inputs (non-blocking). This method should be called at the end
-        // of the main render loop, from the same thread as Render().
+        // Poll user inputs, then wait until the next frame is due or an input arrives. This method should be called
+        // at the end of the main render loop, from the same thread as Render().
         virtual void Poll() = 0;
 
         // Check if the application should exit the main loop and terminate,
@@ -3,8 +3,7 @@
 
 #if defined(GRVL_LINUX_NATIVE_SUPPORT)
 
-#include <functional>
-#include <grvl/Queue.h>
+#include <grvl/Ring.h>
 #include <grvl/platform/PosixApp.h>
 #include <unistd.h>
 
@@ -19,6 +18,7 @@
 #include <libdrm/drm_fourcc.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -74,7 +74,16 @@ namespace grvl {
         drmModeEncoderPtr encoder = nullptr;
         drmModeCrtcPtr crtc = nullptr;
 
-        Queue<std::function<void()>> events;
+        // input sent by the input thread to the main thread, kept in the event so that sending it doesn't allocate
+        struct InputEvent {
+            enum Type : uint8_t { KEY, TEXT } type;
+            bool pressed;
+            uint32_t keycode;
+            char text[16]; // null terminated UTF-8 text of the key
+        };
+
+        // events over the capacity are dropped until the main thread catches up
+        Ring<InputEvent, 256> events;
         std::atomic<bool> thread_run;
         std::thread drm_thread, input_thread;
 
@@ -97,9 +106,13 @@ namespace grvl {
             std::atomic<bool> pending = false;
         } cursor_state;
 
-        // to limit how often we draw we make sure the previous frame is shown before the next one starts rendering
-        // this is done using this mutex, the Render() method wait for it, and the drm_thread signals it.
-        std::mutex render_mutex;
+        // set when there is a new frame or cursor position to show, the planes are not committed otherwise
+        std::atomic<bool> commit_requested = true;
+
+        // frames are paced by the frame scheduler, Swap() only waits for the page flip of the previous frame
+        // before overwriting the primary plane. The drm_thread sleeps until there is a commit or a page flip to handle.
+        std::mutex commit_mutex;
+        std::condition_variable commit_changed;
 
         drmEventContext ev = {};
         struct libinput* li = nullptr;
@@ -133,6 +146,7 @@ namespace grvl {
         void HandleInput();
         void UpdateCursorPos();
         bool Setup() override;
+        void RequestCommit();
         void CommitPlanes();
         void DRMWait();
 
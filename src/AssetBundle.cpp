@@ -0,0 +1,221 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <grvl/AssetBundle.h>
+#include <grvl/Endian.h>
+#include <grvl/grvl.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#ifndef __ZEPHYR__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace grvl {
+
+    AssetBundle::AssetBundle(const uint8_t* data, size_t size)
+        : data(data)
+        , size(size)
+    {
+        if(!Parse()) {
+            Log(ERROR, "Asset bundle at %p is invalid", data);
+        }
+    }
+
+    AssetBundle::AssetBundle(const char* path)
+    {
+#ifndef __ZEPHYR__
+        int fd = open(path, O_RDONLY);
+        if(fd < 0) {
+            Log(ERROR, "No such asset bundle: %s", path);
+            return;
+        }
+
+        struct stat file_stat;
+        if(fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+            void* mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping != MAP_FAILED) {
+                data = static_cast<const uint8_t*>(mapping);
+                size = file_stat.st_size;
+                mapped = true;
+            }
+        }
+        close(fd);
+#else
+        FILE* file = fopen(path, "rb");
+        if(file == nullptr) {
+            Log(ERROR, "No such asset bundle: %s", path);
+            return;
+        }
+
+        fseek(file, 0, SEEK_END);
+        const long length = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        uint8_t* buffer = length > 0 ? static_cast<uint8_t*>(malloc(length)) : nullptr;
+        if(buffer && fread(buffer, 1, length, file) == static_cast<size_t>(length)) {
+            data = buffer;
+            size = length;
+            owned = true;
+        } else {
+            free(buffer);
+        }
+        fclose(file);
+#endif
+
+        if(!data) {
+            Log(ERROR, "Unable to load asset bundle %s", path);
+            return;
+        }
+
+        if(!Parse()) {
+            Log(ERROR, "Asset bundle %s is invalid", path);
+        }
+    }
+
+    AssetBundle::~AssetBundle()
+    {
+#ifndef __ZEPHYR__
+        if(mapped) {
+            munmap(const_cast<uint8_t*>(data), size);
+        }
+#endif
+        if(owned) {
+            free(const_cast<uint8_t*>(data));
+        }
+    }
+
+    bool AssetBundle::Parse()
+    {
+        if(size < sizeof(AssetBundleHeader)) {
+            return false;
+        }
+
+        AssetBundleHeader header;
+        memcpy(&header, data, sizeof(header));
+
+        if(memcmp(header.magic, assetBundleMagic, sizeof(assetBundleMagic)) != 0 || BigEndian32(header.version) != assetBundleVersion) {
+            return false;
+        }
+
+        const uint64_t count = BigEndian32(header.entries);
+        const uint64_t namesLength = BigEndian32(header.names);
+        const uint64_t directoryEnd = sizeof(header) + count * sizeof(AssetBundleEntry);
+        if(directoryEnd + namesLength > size || (namesLength > 0 && data[directoryEnd + namesLength - 1] != '\0')) {
+            return false;
+        }
+
+        // entries are copied, the bundle may be at any address
+        std::vector<AssetBundleEntry> directory(count);
+        memcpy(directory.data(), data + sizeof(header), count * sizeof(AssetBundleEntry));
+
+        for(const AssetBundleEntry& entry : directory) {
+            const auto compression = static_cast<AssetCompression>(entry.compression);
+            if(BigEndian32(entry.name) >= namesLength
+               || static_cast<uint64_t>(BigEndian32(entry.offset)) + BigEndian32(entry.storedSize) > size
+               || (compression != AssetCompression::None && compression != AssetCompression::Zlib)
+               || (compression == AssetCompression::None && BigEndian32(entry.size) != BigEndian32(entry.storedSize))) {
+                return false;
+            }
+        }
+
+        entries = std::move(directory);
+        names = reinterpret_cast<const char*>(data + directoryEnd);
+        valid = true;
+        return true;
+    }
+
+    const AssetBundleEntry* AssetBundle::Find(const char* name) const
+    {
+        uint32_t low = 0, high = entries.size();
+
+        while(low < high) {
+            const uint32_t middle = low + (high - low) / 2;
+            const int order = strcmp(names + BigEndian32(entries[middle].name), name);
+
+            if(order == 0) {
+                return &entries[middle];
+            }
+
+            if(order < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const uint8_t* AssetBundle::GetData(const AssetBundleEntry* entry) const
+    {
+        if(static_cast<AssetCompression>(entry->compression) != AssetCompression::None) {
+            return nullptr;
+        }
+        return data + BigEndian32(entry->offset);
+    }
+
+    uint32_t AssetBundle::GetSize(const AssetBundleEntry* entry) const
+    {
+        return BigEndian32(entry->size);
+    }
+
+    const uint8_t* AssetBundle::GetStoredData(const AssetBundleEntry* entry, uint32_t& storedSize) const
+    {
+        storedSize = BigEndian32(entry->storedSize);
+        return data + BigEndian32(entry->offset);
+    }
+
+    int32_t AssetBundle::Read(const AssetBundleEntry* entry, uint8_t* buffer, int32_t length) const
+    {
+        const uint8_t* stored = data + BigEndian32(entry->offset);
+        const uint32_t storedSize = BigEndian32(entry->storedSize);
+        const uint32_t entrySize = BigEndian32(entry->size);
+        const int32_t bytes = std::min<int64_t>(length, entrySize);
+
+        if(static_cast<AssetCompression>(entry->compression) == AssetCompression::None) {
+            memcpy(buffer, stored, bytes);
+            return bytes;
+        }
+
+        // a partial read still needs the whole entry decompressed
+        uint8_t* output = bytes == static_cast<int32_t>(entrySize) ? buffer : static_cast<uint8_t*>(malloc(entrySize));
+        uLongf outputSize = entrySize;
+        const int result = output ? uncompress(output, &outputSize, stored, storedSize) : Z_MEM_ERROR;
+
+        if(output != buffer) {
+            if(result == Z_OK) {
+                memcpy(buffer, output, bytes);
+            }
+            free(output);
+        }
+
+        if(result != Z_OK || outputSize != entrySize) {
+            Log(ERROR, "Unable to decompress asset %s (%d)", names + BigEndian32(entry->name), result);
+            return -1;
+        }
+
+        return bytes;
+    }
+
+} /* namespace grvl */
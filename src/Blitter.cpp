@@ -19,6 +19,8 @@
 #include <grvl/ImageContent.h>
 #include <grvl/grvl.h>
 
+#include <algorithm>
+
 // unless stated otherwise enable default blitter
 #ifndef __ZEPHYR__
 #ifndef CONFIG_GRVL_ENABLE_DEFAULT_BLITTER
@@ -78,6 +80,61 @@ namespace grvl {
         grvl::Callbacks()->blit(imem, bmem, omem, columns, rows, ioff, boff, ooff, ifmt, bfmt, ofmt, font_color);
     }
 
+#if CONFIG_GRVL_ENABLE_DEFAULT_BLITTER
+    static void DefaultBlend(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint8_t alpha);
+#endif
+
+    void UseBlitAsBlend(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff,
+        uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint8_t alpha)
+    {
+#if CONFIG_GRVL_ENABLE_DEFAULT_BLITTER
+        // synchronous blits are done when they return, so the CPU can read and blend the pixels
+        if(!grvl::Callbacks()->wait_for_blit) {
+            DefaultBlend(imem, bmem, omem, columns, rows, ioff, boff, ooff, ifmt, bfmt, ofmt, alpha);
+            return;
+        }
+#endif
+
+        // asynchronous blits may still write the pixels, so they aren't blended, the result switches
+        // from the background to the input halfway through
+        if(alpha < 0x80) {
+            grvl::Callbacks()->blit(bmem, 0, omem, columns, rows, boff, 0, ooff, bfmt, bfmt, ofmt, 0);
+        } else {
+            grvl::Callbacks()->blit(imem, 0, omem, columns, rows, ioff, 0, ooff, ifmt, ifmt, ofmt, 0);
+        }
+    }
+
+    void RunBlitDescriptor(const BlitDescriptor& d)
+    {
+        switch(d.operation) {
+            case BlitOperation::Fill:
+                grvl::Callbacks()->fill(d.outputMem, d.columns, d.rows, d.outOffset, d.color, d.outPixelFormat);
+                break;
+
+            case BlitOperation::Blit:
+                grvl::Callbacks()->blit(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                                        d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color);
+                break;
+
+            case BlitOperation::BlitClt:
+                grvl::Callbacks()->blit_clt(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                                            d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color, d.backCLT, d.frontCLT);
+                break;
+
+            case BlitOperation::Blend:
+                grvl::Callbacks()->blend(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                                         d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color);
+                break;
+        }
+    }
+
+    void UseOperationsAsBlitBatch(const BlitDescriptor* descriptors, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++) {
+            RunBlitDescriptor(descriptors[i]);
+        }
+    }
+
 #if CONFIG_GRVL_ENABLE_DEFAULT_BLITTER
 
     /*
@@ -85,7 +142,7 @@ namespace grvl {
      */
 
     using BakedFillFunc = void (*) (uint8_t* dst, uint32_t color, uint32_t columns, uint32_t rows, uint32_t offset);
-    using BakedBlitFunc = void (*) (uintptr_t omem, uintptr_t imem, uintptr_t bmem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL);
+    using BakedBlitKernel = void (*) (uintptr_t omem, uintptr_t imem, uintptr_t bmem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL);
 
     template <Format format>
     static uint32_t LookupClt(uint8_t* mem, uint8_t* clt)
@@ -171,7 +228,7 @@ namespace grvl {
     template <bool transparency, Format ifmt, Format bfmt, Format ofmt>
     struct FastBlitPixel_tibo {
 
-        void operator() (uintptr_t omem, uintptr_t imem, uintptr_t bmem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL) const
+        static void call(uintptr_t omem, uintptr_t imem, uintptr_t bmem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL)
         {
 
             constexpr size_t istride = GetFormatStride(ifmt);
@@ -199,15 +256,16 @@ namespace grvl {
     struct FastBlitPixel_tib {
 
         template <Format T>
-        using Next = FastBlitPixel_tibo<transparency, ifmt, bfmt, T>;
+        struct Next {
+            void operator() (BakedBlitKernel* kernel) const
+            {
+                *kernel = FastBlitPixel_tibo<transparency, ifmt, bfmt, T>::call;
+            }
+        };
 
-        void operator() (uintptr_t omem, uintptr_t imem, uintptr_t bmem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL) const
+        void operator() (Format ofmt, BakedBlitKernel* kernel) const
         {
-            static_format_lookup<Next>(
-                ofmt,
-                omem, imem, bmem, columns, rows, ioff, boff, ooff, font_color, backCLT, frontCTL
-            );
-
+            static_format_lookup<Next>(ofmt, kernel);
         };
 
     };
@@ -218,13 +276,9 @@ namespace grvl {
         template <Format T>
         using Next = FastBlitPixel_tib<transparency, ifmt, T>;
 
-        void operator() (uintptr_t omem, uintptr_t imem, uintptr_t bmem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL) const
+        void operator() (Format bfmt, Format ofmt, BakedBlitKernel* kernel) const
         {
-            static_format_lookup<Next>(
-                bfmt,
-                omem, imem, bmem, columns, rows, ioff, boff, ooff, ofmt, font_color, backCLT, frontCTL
-            );
-
+            static_format_lookup<Next>(bfmt, ofmt, kernel);
         };
 
     };
@@ -235,27 +289,33 @@ namespace grvl {
         template <Format T>
         using Next = FastBlitPixel_ti<transparency, T>;
 
-        static void call(uintptr_t omem, uintptr_t imem, uintptr_t bmem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL)
+        static BakedBlitKernel resolve(Format ifmt, Format bfmt, Format ofmt)
         {
-            static_format_lookup<Next>(
-                ifmt,
-                omem, imem, bmem, columns, rows, ioff, boff, ooff, bfmt, ofmt, font_color, backCLT, frontCTL
-            );
+            BakedBlitKernel kernel = nullptr;
+            static_format_lookup<Next>(ifmt, bfmt, ofmt, &kernel);
+            return kernel;
         }
 
     };
 
-    static void DefaultBlitClt(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL)
+    static BakedBlitKernel ResolveBlitKernel(uintptr_t bmem, Format ifmt, Format bfmt, Format ofmt)
     {
         const bool blend = GetFormatAlphaChannel(ifmt) && (bmem != 0);
 
-        BakedBlitFunc blit = blend
-            ? FastBlitPixel_t<true>::call
-            : FastBlitPixel_t<false>::call;
-
         // we will now jump though a chain of functions lookups in a effort to bake strides into the functions at compile time
         // so that memcpy call can be optimized away instead of making a call to glibc
-        blit(omem, imem, bmem, columns, rows, ioff, boff, ooff, ifmt, bfmt, ofmt, font_color, backCLT, frontCTL);
+        return blend
+            ? FastBlitPixel_t<true>::resolve(ifmt, bfmt, ofmt)
+            : FastBlitPixel_t<false>::resolve(ifmt, bfmt, ofmt);
+    }
+
+    static void DefaultBlitClt(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCTL)
+    {
+        BakedBlitKernel blit = ResolveBlitKernel(bmem, ifmt, bfmt, ofmt);
+
+        if (blit) {
+            blit(omem, imem, bmem, columns, rows, ioff, boff, ooff, font_color, backCLT, frontCTL);
+        }
     }
 
     void DefaultBlit(uintptr_t imem, uintptr_t bmem, uintptr_t omem,
@@ -265,6 +325,43 @@ namespace grvl {
         DefaultBlitClt(imem, bmem, omem, columns, rows, ioff, boff, ooff, ifmt, bfmt, ofmt, font_color, 0, 0);
     }
 
+    /*
+     * Default Blender
+     */
+
+    static void DefaultBlend(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint8_t alpha)
+    {
+        const uint32_t istride = GetFormatStride(ifmt);
+        const uint32_t bstride = GetFormatStride(bfmt);
+        const uint32_t ostride = GetFormatStride(ofmt);
+
+        for (uint32_t y = 0; y < rows; y++) {
+            for (uint32_t x = 0; x < columns; x++) {
+                uint32_t icol = 0;
+                uint32_t bcol = 0;
+                memcpy(&icol, (const void*)imem, istride);
+                memcpy(&bcol, (const void*)bmem, bstride);
+
+                icol = ConvertColorFormat(icol, ifmt, Format::ARGB8888);
+                bcol = ConvertColorFormat(bcol, bfmt, Format::ARGB8888);
+
+                const uint32_t ialpha = ((icol >> 24) * alpha) / 255;
+                uint32_t ocol = Blend(bcol, (icol & 0x00ffffff) | (ialpha << 24));
+
+                ocol = ConvertColorFormat(ocol, Format::ARGB8888, ofmt);
+                memcpy((void*)omem, &ocol, ostride);
+
+                omem += ostride;
+                imem += istride;
+                bmem += bstride;
+            }
+
+            omem += ooff * ostride;
+            imem += ioff * istride;
+            bmem += boff * bstride;
+        }
+    }
+
     /*
      * Default Filler
      */
@@ -302,6 +399,75 @@ namespace grvl {
         func[stride - 1]((uint8_t*) dst, color, columns, rows, offset);
     }
 
+    /*
+     * Default Batch
+     */
+
+    // Operations with the same kernel are next to each other once sorted, blits and CLT blits share kernels
+    static uint32_t BatchOrder(const BlitDescriptor& d)
+    {
+        const bool blit = d.operation == BlitOperation::Blit || d.operation == BlitOperation::BlitClt;
+        const bool blend = GetFormatAlphaChannel(d.inPixelFormat) && (d.backgroundMem != 0);
+
+        return (blit ? 0 : static_cast<uint32_t>(d.operation)) << 24 | blend << 23
+            | static_cast<uint32_t>(d.inPixelFormat) << 16 | static_cast<uint32_t>(d.backgroundPixelFormat) << 8 | static_cast<uint32_t>(d.outPixelFormat);
+    }
+
+    static void DefaultBlitBatch(const BlitDescriptor* descriptors, uint32_t count)
+    {
+        static constexpr uint32_t maxSortedCount = 256;
+
+        // larger batches are split, the operations are independent anyway
+        while (count > maxSortedCount) {
+            DefaultBlitBatch(descriptors, maxSortedCount);
+            descriptors += maxSortedCount;
+            count -= maxSortedCount;
+        }
+
+        uint32_t keys[maxSortedCount];
+        uint16_t order[maxSortedCount];
+
+        for (uint32_t i = 0; i < count; i++) {
+            keys[i] = BatchOrder(descriptors[i]);
+            order[i] = i;
+        }
+
+        std::sort(order, order + count, [&keys](uint16_t a, uint16_t b) { return keys[a] < keys[b]; });
+
+        BakedBlitKernel kernel = nullptr;
+        uint32_t kernelKey = UINT32_MAX;
+
+        for (uint32_t i = 0; i < count; i++) {
+            const BlitDescriptor& d = descriptors[order[i]];
+
+            switch (d.operation) {
+                case BlitOperation::Fill:
+                    DefaultFill(d.outputMem, d.columns, d.rows, d.outOffset, d.color, d.outPixelFormat);
+                    break;
+
+                case BlitOperation::Blit:
+                case BlitOperation::BlitClt:
+                    // the lookup chain is only walked once for every format triple
+                    if (keys[order[i]] != kernelKey) {
+                        kernelKey = keys[order[i]];
+                        kernel = ResolveBlitKernel(d.backgroundMem, d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat);
+                    }
+
+                    if (kernel) {
+                        const bool clt = d.operation == BlitOperation::BlitClt;
+                        kernel(d.outputMem, d.inputMem, d.backgroundMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                               d.color, clt ? d.backCLT : 0, clt ? d.frontCLT : 0);
+                    }
+                    break;
+
+                case BlitOperation::Blend:
+                    DefaultBlend(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                                 d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color);
+                    break;
+            }
+        }
+    }
+
 #endif
 
     /*
@@ -311,6 +477,7 @@ namespace grvl {
     static void FallbackFill(uintptr_t dst, uint32_t columns, uint32_t rows, uint32_t offset, uint32_t color_index, Format fmt) {}
     static void FallbackBlit(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff,  uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t fcol) {}
     static void FallbackBlitClt(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff, uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t bctl, uintptr_t fctl) {}
+    static void FallbackBlend(uintptr_t, uintptr_t, uintptr_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, Format, Format, Format, uint8_t) {}
 
     /*
      * Getters
@@ -343,4 +510,22 @@ namespace grvl {
 #endif
     }
 
+    DmaBlendFunction GetBlendFunction()
+    {
+#if CONFIG_GRVL_ENABLE_DEFAULT_BLITTER
+        return DefaultBlend;
+#else
+        return FallbackBlend;
+#endif
+    }
+
+    DmaBlitBatchFunction GetBlitBatchFunction()
+    {
+#if CONFIG_GRVL_ENABLE_DEFAULT_BLITTER
+        return DefaultBlitBatch;
+#else
+        return UseOperationsAsBlitBatch;
+#endif
+    }
+
 }
@@ -0,0 +1,289 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <grvl/BlitterThread.h>
+
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace grvl {
+
+    // The blitter callbacks are plain functions, so the queue is shared by the whole process
+    static struct {
+        DmaFillFunction fill = nullptr;
+        DmaBlitFunction blit = nullptr;
+        DmaBlitCltFunction blitClt = nullptr;
+        DmaBlendFunction blend = nullptr;
+        DmaBlitBatchFunction batch = nullptr;
+
+        pthread_t worker;
+        pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+        pthread_cond_t queued = PTHREAD_COND_INITIALIZER;
+        pthread_cond_t completed = PTHREAD_COND_INITIALIZER;
+
+        // a batch is queued as a run of descriptors, its length is kept at its first descriptor
+        std::vector<BlitDescriptor> ring;
+        std::vector<uint32_t> batchLengths;
+        uint32_t head = 0;
+        uint32_t count = 0;
+        // read without the lock, so waiting for a completed fence is cheap enough for every pixel access
+        std::atomic<BlitFence> submittedFence {0};
+        std::atomic<BlitFence> completedFence {0};
+        bool running = false;
+        bool stopRequested = false;
+    } blitter;
+
+    static BlitFence AdvanceFence(BlitFence fence, uint32_t operations)
+    {
+        // 0 is reserved for no operation at all, so it is skipped when the fence wraps around
+        const BlitFence next = fence + operations;
+        return next < fence ? next + 1 : next;
+    }
+
+    static bool IsFenceCompleted(BlitFence fence)
+    {
+        return fence == 0 || static_cast<int32_t>(blitter.completedFence.load() - fence) >= 0;
+    }
+
+    static void Execute(const BlitDescriptor& d)
+    {
+        switch(d.operation) {
+            case BlitOperation::Fill:
+                blitter.fill(d.outputMem, d.columns, d.rows, d.outOffset, d.color, d.outPixelFormat);
+                break;
+
+            case BlitOperation::Blit:
+                blitter.blit(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                             d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color);
+                break;
+
+            case BlitOperation::BlitClt:
+                // same as UseBlitAsBlitClt, which would queue the operation again
+                if(!blitter.blitClt) {
+                    blitter.blit(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                                 d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color);
+                    break;
+                }
+
+                blitter.blitClt(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                                d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color, d.backCLT, d.frontCLT);
+                break;
+
+            case BlitOperation::Blend:
+                // same as UseBlitAsBlend, which would queue the operation again
+                if(!blitter.blend) {
+                    if(d.color < 0x80) {
+                        blitter.blit(d.backgroundMem, 0, d.outputMem, d.columns, d.rows, d.backgroundOffset, 0, d.outOffset,
+                                     d.backgroundPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, 0);
+                    } else {
+                        blitter.blit(d.inputMem, 0, d.outputMem, d.columns, d.rows, d.inOffset, 0, d.outOffset,
+                                     d.inPixelFormat, d.inPixelFormat, d.outPixelFormat, 0);
+                    }
+                    break;
+                }
+
+                blitter.blend(d.inputMem, d.backgroundMem, d.outputMem, d.columns, d.rows, d.inOffset, d.backgroundOffset, d.outOffset,
+                              d.inPixelFormat, d.backgroundPixelFormat, d.outPixelFormat, d.color);
+                break;
+        }
+    }
+
+    static void* WorkerEntry(void*)
+    {
+        std::vector<BlitDescriptor> batch;
+        batch.reserve(blitter.ring.size());
+
+        pthread_mutex_lock(&blitter.m);
+
+        while(true) {
+            while(blitter.count == 0 && !blitter.stopRequested) {
+                pthread_cond_wait(&blitter.queued, &blitter.m);
+            }
+
+            if(blitter.count == 0) {
+                break;
+            }
+
+            // the descriptors stay in the ring until they are done, so their slots are not reused by the submitting thread
+            const uint32_t length = blitter.batchLengths[blitter.head];
+            batch.clear();
+            for(uint32_t i = 0; i < length; i++) {
+                batch.push_back(blitter.ring[(blitter.head + i) % blitter.ring.size()]);
+            }
+            pthread_mutex_unlock(&blitter.m);
+
+            if(length > 1 && blitter.batch) {
+                blitter.batch(batch.data(), length);
+            } else {
+                for(const BlitDescriptor& descriptor : batch) {
+                    Execute(descriptor);
+                }
+            }
+
+            pthread_mutex_lock(&blitter.m);
+            blitter.head = (blitter.head + length) % blitter.ring.size();
+            blitter.count -= length;
+            blitter.completedFence.store(AdvanceFence(blitter.completedFence.load(), length));
+            pthread_cond_broadcast(&blitter.completed);
+        }
+
+        pthread_mutex_unlock(&blitter.m);
+        return nullptr;
+    }
+
+    static void Submit(const BlitDescriptor* descriptors, uint32_t count)
+    {
+        pthread_mutex_lock(&blitter.m);
+
+        // batches longer than the queue are split, their operations are independent anyway
+        while(count > 0) {
+            const uint32_t length = std::min<uint32_t>(count, blitter.ring.size());
+            while(blitter.ring.size() - blitter.count < length) {
+                pthread_cond_wait(&blitter.completed, &blitter.m);
+            }
+
+            const uint32_t tail = (blitter.head + blitter.count) % blitter.ring.size();
+            for(uint32_t i = 0; i < length; i++) {
+                blitter.ring[(tail + i) % blitter.ring.size()] = descriptors[i];
+            }
+            blitter.batchLengths[tail] = length;
+            blitter.count += length;
+            blitter.submittedFence.store(AdvanceFence(blitter.submittedFence.load(), length));
+            pthread_cond_signal(&blitter.queued);
+
+            descriptors += length;
+            count -= length;
+        }
+
+        pthread_mutex_unlock(&blitter.m);
+    }
+
+    static void QueueFill(uintptr_t dst, uint32_t columns, uint32_t rows, uint32_t offset, uint32_t color_index, Format pixel_format)
+    {
+        const BlitDescriptor descriptor {BlitOperation::Fill, 0, 0, dst, columns, rows, 0, 0, offset, pixel_format, pixel_format, pixel_format, color_index, 0, 0};
+        Submit(&descriptor, 1);
+    }
+
+    static void QueueBlit(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff,
+                          uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color)
+    {
+        const BlitDescriptor descriptor {BlitOperation::Blit, imem, bmem, omem, columns, rows, ioff, boff, ooff, ifmt, bfmt, ofmt, font_color, 0, 0};
+        Submit(&descriptor, 1);
+    }
+
+    static void QueueBlitClt(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff,
+                             uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint32_t font_color, uintptr_t backCLT, uintptr_t frontCLT)
+    {
+        const BlitDescriptor descriptor {BlitOperation::BlitClt, imem, bmem, omem, columns, rows, ioff, boff, ooff, ifmt, bfmt, ofmt, font_color, backCLT, frontCLT};
+        Submit(&descriptor, 1);
+    }
+
+    static void QueueBlend(uintptr_t imem, uintptr_t bmem, uintptr_t omem, uint32_t columns, uint32_t rows, uint32_t ioff, uint32_t boff,
+                           uint32_t ooff, Format ifmt, Format bfmt, Format ofmt, uint8_t alpha)
+    {
+        const BlitDescriptor descriptor {BlitOperation::Blend, imem, bmem, omem, columns, rows, ioff, boff, ooff, ifmt, bfmt, ofmt, alpha, 0, 0};
+        Submit(&descriptor, 1);
+    }
+
+    static void QueueBatch(const BlitDescriptor* descriptors, uint32_t count)
+    {
+        Submit(descriptors, count);
+    }
+
+    static BlitFence QueueFence()
+    {
+        return blitter.submittedFence.load();
+    }
+
+    static void WaitForFence(BlitFence fence)
+    {
+        if(IsFenceCompleted(fence)) {
+            return;
+        }
+
+        pthread_mutex_lock(&blitter.m);
+        while(!IsFenceCompleted(fence)) {
+            pthread_cond_wait(&blitter.completed, &blitter.m);
+        }
+        pthread_mutex_unlock(&blitter.m);
+    }
+
+    bool BlitterThread::Start(uint32_t queueSize)
+    {
+        if(blitter.running || queueSize == 0) {
+            return false;
+        }
+
+        // the fallbacks set by grvl::Init go through the callbacks, they are run with the blit of the worker instead
+        gui_callbacks_t* callbacks = grvl::Callbacks();
+        blitter.fill = callbacks->fill;
+        blitter.blit = callbacks->blit;
+        blitter.blitClt = callbacks->blit_clt != UseBlitAsBlitClt ? callbacks->blit_clt : nullptr;
+        blitter.blend = callbacks->blend != UseBlitAsBlend ? callbacks->blend : nullptr;
+        blitter.batch = callbacks->blit_batch != UseOperationsAsBlitBatch ? callbacks->blit_batch : nullptr;
+
+        blitter.ring.resize(queueSize);
+        blitter.batchLengths.resize(queueSize);
+        blitter.head = 0;
+        blitter.count = 0;
+        blitter.submittedFence.store(0);
+        blitter.completedFence.store(0);
+        blitter.stopRequested = false;
+
+        blitter.running = pthread_create(&blitter.worker, nullptr, WorkerEntry, nullptr) == 0;
+        if(!blitter.running) {
+            Log(ERROR, "Failed to start the blitter thread");
+            return false;
+        }
+
+        callbacks->fill = QueueFill;
+        callbacks->blit = QueueBlit;
+        callbacks->blit_clt = QueueBlitClt;
+        callbacks->blend = QueueBlend;
+        callbacks->blit_batch = QueueBatch;
+        callbacks->blit_fence = QueueFence;
+        callbacks->wait_for_blit = WaitForFence;
+        return true;
+    }
+
+    void BlitterThread::Stop()
+    {
+        if(!blitter.running) {
+            return;
+        }
+
+        pthread_mutex_lock(&blitter.m);
+        blitter.stopRequested = true;
+        pthread_cond_signal(&blitter.queued);
+        pthread_mutex_unlock(&blitter.m);
+
+        // queued operations are done before the worker exits
+        pthread_join(blitter.worker, nullptr);
+        blitter.running = false;
+
+        gui_callbacks_t* callbacks = grvl::Callbacks();
+        callbacks->fill = blitter.fill;
+        callbacks->blit = blitter.blit;
+        callbacks->blit_clt = blitter.blitClt ? blitter.blitClt : UseBlitAsBlitClt;
+        callbacks->blend = blitter.blend ? blitter.blend : UseBlitAsBlend;
+        callbacks->blit_batch = blitter.batch ? blitter.batch : UseOperationsAsBlitBatch;
+        callbacks->blit_fence = nullptr;
+        callbacks->wait_for_blit = nullptr;
+    }
+
+} /* namespace grvl */
@@ -15,6 +15,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <grvl/ContentManager.h>
+#include <grvl/Manager.h>
 #include <grvl/component/Image.h>
 
 namespace grvl {
@@ -22,19 +23,58 @@ namespace grvl {
     void ContentManager::RegisterContent(const std::string& name, ImageContent* ic)
     {
         GetByName(name)->Set(ic);
+        Manager::RequestRedraw();
+    }
+
+    void ContentManager::RegisterAtlas(const std::string& name, ImageContent* ic, const AtlasRegions& regions)
+    {
+        atlas_registry[name] = regions;
+        GetByName(name)->Set(ic);
+
+        const std::string prefix = name + AtlasSeparator;
+        for (auto& [delegateName, delegate] : content_registry) {
+            if (delegateName.compare(0, prefix.size(), prefix) == 0) {
+                ResolveRegion(delegateName, *delegate);
+            }
+        }
+
+        Manager::RequestRedraw();
     }
 
     std::shared_ptr<ImageDelegate> ContentManager::RequestImage(const std::string& name)
     {
         auto delegate = GetByName(name);
 
-        if (!delegate->HasContent()) {
+        if (!delegate->HasContent() && !ResolveRegion(name, *delegate)) {
             loader_callback(name);
         }
 
         return delegate;
     }
 
+    bool ContentManager::ResolveRegion(const std::string& name, ImageDelegate& delegate)
+    {
+        const size_t separator = name.find(AtlasSeparator);
+        if (separator == std::string::npos) {
+            return false;
+        }
+
+        const std::string atlasName = name.substr(0, separator);
+        auto atlas = atlas_registry.find(atlasName);
+        if (atlas == atlas_registry.end()) {
+            return false;
+        }
+
+        auto region = atlas->second.find(name.substr(separator + 1));
+        if (region == atlas->second.end()) {
+            Log(WARN, "Atlas %s has no region named %s", atlasName.c_str(), name.c_str() + separator + 1);
+            return false;
+        }
+
+        delegate.SetRegion(GetByName(atlasName), region->second);
+        return true;
+    }
+
     std::shared_ptr<ImageDelegate> ContentManager::GetByName(const std::string& name)
     {
         auto it = content_registry.find(name);
@@ -14,6 +14,7 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <grvl/AssetBundle.h>
 #include <grvl/File.h>
 #include <grvl/grvl.h>
 
@@ -22,24 +23,88 @@
 #include <string.h>
 #include <zlib.h>
 
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
 #include <string>
 
 namespace grvl {
-    static constexpr auto bufferSize = 128;
+    static constexpr size_t readChunkSize = 16 * 1024;
+    static constexpr size_t probeSize = 256;
+
+    // The last 4 bytes of gzip data hold the uncompressed size modulo 2^32, little endian.
+    // zlib reads files without the gzip header as they are, so their own size is used.
+    static uint32_t GzipSize(int fd)
+    {
+        static constexpr off_t minimumGzipSize = 18;
+        uint8_t magic[2] = {0, 0};
+        uint8_t trailer[4] = {0, 0, 0, 0};
+        uint32_t size = 0;
+
+        const off_t length = lseek(fd, 0, SEEK_END);
+        if(length >= minimumGzipSize && lseek(fd, 0, SEEK_SET) == 0 && read(fd, magic, sizeof(magic)) == sizeof(magic)
+           && magic[0] == 0x1f && magic[1] == 0x8b && lseek(fd, length - sizeof(trailer), SEEK_SET) >= 0
+           && read(fd, trailer, sizeof(trailer)) == sizeof(trailer)) {
+            size = trailer[0] | trailer[1] << 8 | trailer[2] << 16 | static_cast<uint32_t>(trailer[3]) << 24;
+        } else if(length > 0) {
+            size = length;
+        }
+
+        lseek(fd, 0, SEEK_SET);
+        return size;
+    }
 
     bool File::noFS = false;
     std::unordered_map<std::string, std::pair<unsigned char*, uint64_t>>* File::files;
+    AssetBundle* File::bundle = nullptr;
+    std::string File::bundleMountPoint;
 
     void File::NoFilesystem(std::unordered_map<std::string, std::pair<unsigned char*, uint64_t>>* _files) {
         noFS = true;
         files = _files;
     }
 
+    static bool MountLoadedBundle(AssetBundle* loaded, const char* mountPoint, AssetBundle*& bundle, std::string& bundleMountPoint)
+    {
+        if(!loaded->IsValid()) {
+            delete loaded;
+            return false;
+        }
+
+        delete bundle;
+        bundle = loaded;
+        bundleMountPoint = mountPoint;
+        return true;
+    }
+
+    bool File::MountBundle(const char* path, const char* mountPoint)
+    {
+        return MountLoadedBundle(new AssetBundle(path), mountPoint, bundle, bundleMountPoint);
+    }
+
+    bool File::MountBundle(const uint8_t* data, size_t size, const char* mountPoint)
+    {
+        return MountLoadedBundle(new AssetBundle(data, size), mountPoint, bundle, bundleMountPoint);
+    }
+
+    void File::UnmountBundle()
+    {
+        delete bundle;
+        bundle = nullptr;
+        bundleMountPoint.clear();
+    }
+
     File::File(const char* path)
         : path(path)
     {
-        if(noFS) {
+        if(bundle && strncmp(path, bundleMountPoint.c_str(), bundleMountPoint.size()) == 0
+           && (bundleEntry = bundle->Find(path + bundleMountPoint.size()))) {
+            readOnly = true;
+            storage = BUNDLE;
+        }
+
+        else if(noFS) {
             readOnly = true;
             storage = DICTIONARY;
         }
@@ -64,6 +129,10 @@ namespace grvl {
 
     bool File::Exists() const
     {
+        if(storage == BUNDLE) {
+            return true;
+        }
+
         if(storage == DICTIONARY) {
             std::string name = GetName();
             return files->find(name) != files->end();
@@ -91,6 +160,10 @@ namespace grvl {
 
     int32_t File::GetSize() const
     {
+        if(storage == BUNDLE) {
+            return bundle->GetSize(bundleEntry);
+        }
+
         if(storage == DICTIONARY) {
             std::string name = GetName();
             auto it = files->find(name);
@@ -112,20 +185,14 @@ namespace grvl {
         }
 
         if(storage == GZIPPED) {
-            // TODO: is it possible to check the size without decompression ?
-            gzFile file = gzopen(path, "r");
-            if(file == nullptr) {
+            const int fd = open(path, O_RDONLY);
+            if(fd < 0) {
                 return 0;
             }
-            uint32_t offset = 0;
-            int read_bytes = 0;
-            char buffer[bufferSize];
-            while((read_bytes = gzread(file, buffer, bufferSize)) > 0) {
-                offset += read_bytes;
-            }
 
-            gzclose(file);
-            return offset;
+            const uint32_t size = GzipSize(fd);
+            close(fd);
+            return size;
         }
 
         return 0;
@@ -133,6 +200,10 @@ namespace grvl {
 
     int32_t File::ReadToBuffer(uint8_t* buffer, int32_t size) const
     {
+        if(storage == BUNDLE) {
+            return bundle->Read(bundleEntry, buffer, size);
+        }
+
         if(storage == DICTIONARY) {
             std::string name = GetName();
             const auto it = files->find(name);
@@ -149,41 +220,13 @@ namespace grvl {
             return bytes;
         }
 
-        if(storage == GZIPPED) {
-            size_t read_bytes = 0;
-
-            gzFile file = gzopen(path, "r");
-            if(file == nullptr) {
-                Log(ERROR, "No such file: %s", path);
-                return -1;
-            }
-
-            while((size > 0) && ((read_bytes = gzread(file, buffer, size)) > 0)) {
-                buffer += read_bytes;
-                size -= read_bytes;
-            }
-
-            gzclose(file);
-            return read_bytes;
-        }
-
-        if (storage == NORMAL) {
-            uint32_t offset = 0;
-            size_t read_bytes = 0;
-
-            FILE* file = fopen(path, "rb");
-            if(file == nullptr) {
-                Log(ERROR, "No such file: %s", path);
+        if(storage == GZIPPED || storage == NORMAL) {
+            Reader reader(*this);
+            if(!reader.IsOpen()) {
                 return -1;
             }
 
-            while((size > 0) && ((read_bytes = fread(buffer, 1, size, file)) > 0)) {
-                buffer += read_bytes;
-                size -= read_bytes;
-            }
-
-            fclose(file);
-            return read_bytes;
+            return reader.Read(buffer, size);
         }
 
         return -1;
@@ -218,25 +261,198 @@ namespace grvl {
         return -1;
     }
 
-    std::vector<char> File::Read() const
+    const uint8_t* File::GetMappedData() const
     {
-        std::vector<char> buffer(GetSize());
+        if(storage == BUNDLE) {
+            return bundle->GetData(bundleEntry);
+        }
+
+        if(storage == DICTIONARY) {
+            const auto it = files->find(GetName());
+            return it == files->end() ? nullptr : it->second.first;
+        }
 
-        uint8_t* data = reinterpret_cast<uint8_t*>(buffer.data());
-        ReadToBuffer(data, buffer.size());
+        return nullptr;
+    }
 
+    std::vector<char> File::Read() const
+    {
+        std::vector<char> buffer;
+        Reader reader(*this);
+        reader.ReadToEnd(buffer);
         return buffer;
     }
 
     std::string File::ReadString() const
     {
         std::string buffer;
-        buffer.resize(GetSize());
+        Reader reader(*this);
+        reader.ReadToEnd(buffer);
+        return buffer;
+    }
+
+    File::Reader::Reader(const File& source)
+    {
+        switch(source.storage) {
+            case BUNDLE: {
+                sizeHint = bundle->GetSize(source.bundleEntry);
+                memory = bundle->GetData(source.bundleEntry);
+                if(memory) {
+                    memorySize = sizeHint;
+                    open = true;
+                    break;
+                }
+
+                uint32_t storedSize = 0;
+                const uint8_t* stored = bundle->GetStoredData(source.bundleEntry, storedSize);
+                inflater = new z_stream {};
+                inflater->next_in = const_cast<Bytef*>(stored);
+                inflater->avail_in = storedSize;
+                open = inflateInit(inflater) == Z_OK;
+                break;
+            }
 
-        uint8_t* data = reinterpret_cast<uint8_t*>(buffer.data());
-        ReadToBuffer(data, buffer.size());
+            case DICTIONARY: {
+                const auto it = files->find(source.GetName());
+                if(it != files->end()) {
+                    memory = it->second.first;
+                    memorySize = sizeHint = it->second.second;
+                    open = true;
+                }
+                break;
+            }
 
-        return buffer;
+            case GZIPPED: {
+                // the size comes from the trailer, so the data is only decompressed once, while reading
+                const int fd = ::open(source.path, O_RDONLY);
+                if(fd < 0) {
+                    break;
+                }
+
+                sizeHint = GzipSize(fd);
+                gzfile = gzdopen(fd, "rb");
+                if(gzfile == nullptr) {
+                    close(fd);
+                    break;
+                }
+
+                gzbuffer(gzfile, readChunkSize);
+                open = true;
+                break;
+            }
+
+            case NORMAL: {
+                file = fopen(source.path, "rb");
+                if(file == nullptr) {
+                    break;
+                }
+
+                struct stat file_stat;
+                if(stat(source.path, &file_stat) == 0) {
+                    sizeHint = file_stat.st_size;
+                }
+                open = true;
+                break;
+            }
+        }
+
+        if(!open) {
+            Log(ERROR, "No such file: %s", source.path);
+        }
+    }
+
+    File::Reader::~Reader()
+    {
+        if(file) {
+            fclose(file);
+        }
+
+        if(gzfile) {
+            gzclose(gzfile);
+        }
+
+        if(inflater) {
+            inflateEnd(inflater);
+            delete inflater;
+        }
+    }
+
+    int32_t File::Reader::Read(uint8_t* buffer, int32_t size)
+    {
+        if(!open) {
+            return -1;
+        }
+
+        if(size <= 0) {
+            return 0;
+        }
+
+        if(file) {
+            const size_t bytes = fread(buffer, 1, size, file);
+            return bytes < static_cast<size_t>(size) && ferror(file) ? -1 : static_cast<int32_t>(bytes);
+        }
+
+        if(gzfile) {
+            return gzread(gzfile, buffer, size);
+        }
+
+        if(inflater) {
+            inflater->next_out = buffer;
+            inflater->avail_out = size;
+
+            const int result = inflate(inflater, Z_NO_FLUSH);
+            if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+                Log(ERROR, "Unable to decompress file (%d)", result);
+                return -1;
+            }
+            return size - inflater->avail_out;
+        }
+
+        const int32_t bytes = std::min<uint32_t>(size, memorySize - position);
+        memcpy(buffer, memory + position, bytes);
+        position += bytes;
+        return bytes;
+    }
+
+    // The buffer is sized from the hint up front, once it is full a small probe read finds out whether it has to grow
+    template <typename Buffer>
+    static bool ReadRemaining(File::Reader& reader, Buffer& buffer)
+    {
+        size_t length = buffer.size();
+        buffer.resize(std::max<size_t>(length, reader.GetSizeHint()));
+
+        while(true) {
+            if(length == buffer.size()) {
+                uint8_t probe[probeSize];
+                const int32_t bytes = reader.Read(probe, sizeof(probe));
+                if(bytes <= 0) {
+                    buffer.resize(length);
+                    return bytes == 0;
+                }
+
+                buffer.resize(length + std::max(length / 2, readChunkSize));
+                memcpy(&buffer[length], probe, bytes);
+                length += bytes;
+                continue;
+            }
+
+            const int32_t bytes = reader.Read(reinterpret_cast<uint8_t*>(&buffer[length]), buffer.size() - length);
+            if(bytes <= 0) {
+                buffer.resize(length);
+                return bytes == 0;
+            }
+            length += bytes;
+        }
+    }
+
+    bool File::Reader::ReadToEnd(std::vector<char>& buffer)
+    {
+        return open && ReadRemaining(*this, buffer);
+    }
+
+    bool File::Reader::ReadToEnd(std::string& buffer)
+    {
+        return open && ReadRemaining(*this, buffer);
     }
 
     bool File::Write(const std::vector<char>& buffer)
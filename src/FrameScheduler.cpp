@@ -0,0 +1,167 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <grvl/FrameScheduler.h>
+#include <grvl/grvl.h>
+
+#include <time.h>
+
+namespace grvl {
+
+    FrameScheduler::FrameScheduler()
+    {
+        pthread_mutex_init(&m, nullptr);
+        pthread_cond_init(&frameRequested, nullptr);
+    }
+
+    FrameScheduler::~FrameScheduler()
+    {
+        pthread_cond_destroy(&frameRequested);
+        pthread_mutex_destroy(&m);
+    }
+
+    void FrameScheduler::RequestFrame()
+    {
+        // the time of the request, so a frame requested after a while without any isn't late from the start
+        RequestFrame(grvl::Callbacks()->get_timestamp());
+    }
+
+    void FrameScheduler::RequestFrame(uint64_t timestamp)
+    {
+        pthread_mutex_lock(&m);
+        if(timestamp < requestedTimestamp) {
+            requestedTimestamp = timestamp;
+            pthread_cond_broadcast(&frameRequested);
+        }
+        pthread_mutex_unlock(&m);
+    }
+
+    void FrameScheduler::ReportVblank(uint64_t timestamp)
+    {
+        pthread_mutex_lock(&m);
+        lastVblank = timestamp;
+        pthread_mutex_unlock(&m);
+    }
+
+    void FrameScheduler::SetFrameInterval(uint32_t interval)
+    {
+        pthread_mutex_lock(&m);
+        frameInterval = interval;
+        pthread_mutex_unlock(&m);
+    }
+
+    uint32_t FrameScheduler::GetFrameInterval() const
+    {
+        return frameInterval;
+    }
+
+    uint64_t FrameScheduler::GetNextFrameTimestampLocked() const
+    {
+        if(requestedTimestamp == noFrame) {
+            return noFrame;
+        }
+
+        // Never render more than one frame per interval
+        uint64_t timestamp = requestedTimestamp;
+        if(lastFrameStart != 0 && timestamp < lastFrameStart + frameInterval) {
+            timestamp = lastFrameStart + frameInterval;
+        }
+
+        // Start rendering right after the vblank following the requested timestamp
+        if(lastVblank != 0 && frameInterval != 0 && timestamp > lastVblank) {
+            uint64_t intervals = (timestamp - lastVblank + frameInterval - 1) / frameInterval;
+            timestamp = lastVblank + intervals * frameInterval;
+        }
+
+        return timestamp;
+    }
+
+    uint64_t FrameScheduler::GetNextFrameTimestamp() const
+    {
+        pthread_mutex_lock(&m);
+        uint64_t timestamp = GetNextFrameTimestampLocked();
+        pthread_mutex_unlock(&m);
+        return timestamp;
+    }
+
+    bool FrameScheduler::IsFrameDue(uint64_t now) const
+    {
+        return GetNextFrameTimestamp() <= now;
+    }
+
+    uint64_t FrameScheduler::GetTimeout(uint64_t now) const
+    {
+        uint64_t timestamp = GetNextFrameTimestamp();
+        if(timestamp == noFrame) {
+            return noFrame;
+        }
+
+        return timestamp > now ? timestamp - now : 0;
+    }
+
+    void FrameScheduler::WaitForFrame(uint64_t now, uint64_t maxTimeout)
+    {
+        pthread_mutex_lock(&m);
+
+        uint64_t timestamp = GetNextFrameTimestampLocked();
+        uint64_t timeout = timestamp == noFrame ? noFrame : (timestamp > now ? timestamp - now : 0);
+        if(maxTimeout < timeout) {
+            timeout = maxTimeout;
+        }
+
+        if(timeout > 0) {
+            // Woken up early by any new request, the caller checks if the frame is due
+            if(timeout == noFrame) {
+                pthread_cond_wait(&frameRequested, &m);
+            } else {
+                timespec deadline;
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_sec += timeout / 1000;
+                deadline.tv_nsec += (timeout % 1000) * 1000000;
+                if(deadline.tv_nsec >= 1000000000) {
+                    deadline.tv_sec++;
+                    deadline.tv_nsec -= 1000000000;
+                }
+                pthread_cond_timedwait(&frameRequested, &m, &deadline);
+            }
+        }
+
+        pthread_mutex_unlock(&m);
+    }
+
+    bool FrameScheduler::BeginFrame(uint64_t now)
+    {
+        pthread_mutex_lock(&m);
+
+        uint64_t deadline = GetNextFrameTimestampLocked();
+        bool onTime = deadline == noFrame || now <= deadline + frameInterval;
+        if(!onTime) {
+            missedDeadlines++;
+        }
+
+        requestedTimestamp = noFrame;
+        lastFrameStart = now;
+
+        pthread_mutex_unlock(&m);
+        return onTime;
+    }
+
+    uint32_t FrameScheduler::GetMissedDeadlines() const
+    {
+        return missedDeadlines;
+    }
+
+} /* namespace grvl */
@@ -18,10 +18,17 @@
 
 #include <grvl/ImageContent.h>
 #include <grvl/grvl.h>
+#include <grvl/Manager.h>
 #include <grvl/Misc.h>
 #include <grvl/Painter.h>
+#include <grvl/PixelConversion.h>
 #include <grvl/Endian.h>
 
+#include <algorithm>
+#include <pthread.h>
+#include <stdio.h>
+#include <unordered_map>
+
 // save on binary size
 #define STBI_ONLY_JPEG
 #define STBI_ONLY_PNG
@@ -34,11 +41,574 @@
 
 namespace grvl {
 
-    union Pixel {
-        Color channels;
+    struct ImageFileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t frames;
+        uint32_t format;
+        uint32_t flags;
+        uint32_t durations;
+        uint32_t lines;
+        uint32_t palette;
         uint32_t data;
     };
 
+    // make sure that the struct is tightly packed in memory
+    static_assert(sizeof(ImageFileHeader) == 48);
+
+    static constexpr char imageFileMagic[8] = "grvlimg";
+    static constexpr uint32_t imageFileRotated = 1;
+
+    // Palette entries are blue, green and red bytes, as read by LookupClt
+    static constexpr uint32_t paletteEntries = 256;
+
+    struct GifFrame {
+        size_t control = 0; // graphic control extension of the frame, if any
+        size_t controlEnd = 0;
+        size_t image = 0; // image descriptor, followed by the local color table and the image data
+        size_t imageEnd = 0;
+        int32_t x = 0, y = 0, width = 0, height = 0;
+        uint8_t disposal = 0;
+    };
+
+    struct GifLayout {
+        int32_t width = 0;
+        int32_t height = 0;
+        std::vector<uint32_t> frameDurations;
+        std::vector<GifFrame> frames;
+        size_t colorTableEnd = 0; // end of the header and the global color table
+    };
+
+    static constexpr uint8_t gifDisposeBackground = 2;
+    static constexpr uint8_t gifDisposeRestorePrevious = 3;
+
+    // Walks the GIF block structure without decompressing the frames,
+    // to learn the number of frames, their durations and where they are stored up front
+    static bool ScanGif(const uint8_t* gif, size_t size, GifLayout& layout)
+    {
+        static constexpr size_t headerSize = 13;
+        static constexpr size_t imageDescriptorSize = 9;
+        static constexpr uint8_t extensionIntroducer = 0x21;
+        static constexpr uint8_t imageSeparator = 0x2C;
+        static constexpr uint8_t trailer = 0x3B;
+        static constexpr uint8_t graphicControlLabel = 0xF9;
+
+        if(size < headerSize || memcmp(gif, "GIF8", 4) != 0) {
+            return false;
+        }
+
+        auto read16 = [gif](size_t pos) -> uint32_t { return gif[pos] | (gif[pos + 1] << 8); };
+        auto colorTableSize = [](uint8_t flags) -> size_t { return (flags & 0x80) ? 3 * (2 << (flags & 0x07)) : 0; };
+
+        layout.width = read16(6);
+        layout.height = read16(8);
+
+        size_t pos = headerSize + colorTableSize(gif[10]);
+        layout.colorTableEnd = pos;
+        GifFrame frame;
+        uint32_t delay = 0;
+
+        auto skipSubBlocks = [&]() {
+            while(pos < size) {
+                uint8_t length = gif[pos++];
+                if(length == 0) {
+                    return true;
+                }
+                pos += length;
+            }
+            return false;
+        };
+
+        while(pos < size) {
+            const size_t start = pos;
+            uint8_t block = gif[pos++];
+            if(block == trailer) {
+                break;
+            }
+
+            if(block == extensionIntroducer) {
+                if(pos >= size) {
+                    return false;
+                }
+                uint8_t label = gif[pos++];
+                const bool control = label == graphicControlLabel && pos + 4 < size && gif[pos] >= 4;
+                if(control) {
+                    // same units as stb: hundredths of a second
+                    delay = 10 * read16(pos + 2);
+                    frame.disposal = (gif[pos + 1] >> 2) & 0x07;
+                }
+                if(!skipSubBlocks() || pos > size) {
+                    return false;
+                }
+                if(control) {
+                    frame.control = start;
+                    frame.controlEnd = pos;
+                }
+            } else if(block == imageSeparator) {
+                if(pos + imageDescriptorSize >= size) {
+                    return false;
+                }
+                frame.image = start;
+                frame.x = read16(pos);
+                frame.y = read16(pos + 2);
+                frame.width = read16(pos + 4);
+                frame.height = read16(pos + 6);
+                pos += imageDescriptorSize + colorTableSize(gif[pos + imageDescriptorSize - 1]);
+                pos++; // LZW minimum code size
+                if(!skipSubBlocks() || pos > size) {
+                    return false;
+                }
+                frame.imageEnd = pos;
+                layout.frames.push_back(frame);
+                layout.frameDurations.push_back(delay > 0 ? delay : 100);
+
+                // graphic control extensions only apply to the next image
+                frame = GifFrame();
+            } else {
+                return false;
+            }
+        }
+
+        return !layout.frameDurations.empty();
+    }
+
+    // Feeds stb_image from a File::Reader, starting with the bytes already read to recognize the file,
+    // so still images are decoded while reading instead of from a copy of the whole file
+    struct ImageReader {
+        File::Reader& reader;
+        const std::vector<char>& pending;
+        size_t position = 0;
+        bool eof = false;
+
+        static int Read(void* user, char* data, int size)
+        {
+            auto* stream = static_cast<ImageReader*>(user);
+            int bytes = 0;
+
+            if(stream->position < stream->pending.size()) {
+                bytes = std::min<size_t>(size, stream->pending.size() - stream->position);
+                memcpy(data, stream->pending.data() + stream->position, bytes);
+                stream->position += bytes;
+            }
+
+            if(bytes < size) {
+                const int32_t read = stream->reader.Read(reinterpret_cast<uint8_t*>(data) + bytes, size - bytes);
+                stream->eof = read < size - bytes;
+                bytes += std::max<int32_t>(read, 0);
+            }
+
+            return bytes;
+        }
+
+        static void Skip(void* user, int bytes)
+        {
+            char buffer[256];
+
+            while(bytes > 0 && !static_cast<ImageReader*>(user)->eof) {
+                bytes -= Read(user, buffer, std::min<int>(bytes, sizeof(buffer)));
+            }
+        }
+
+        static int Eof(void* user)
+        {
+            auto* stream = static_cast<ImageReader*>(user);
+            return stream->position >= stream->pending.size() && stream->eof;
+        }
+
+        static constexpr stbi_io_callbacks callbacks {Read, Skip, Eof};
+    };
+
+    /// Decodes animated GIFs a few frames ahead of the ones being displayed.
+    ///
+    /// Only the compressed file and a ring of decoded frames, in the target format, are kept in memory.
+    /// All streams share a single worker thread, started with the first stream and stopped with the last one.
+    class FrameStream {
+    public:
+        static constexpr uint32_t ringSize = 3;
+
+        FrameStream(std::shared_ptr<const std::vector<char>> source, std::shared_ptr<const GifLayout> layout);
+        ~FrameStream();
+
+        /// Starts decoding into the given ring, which must hold ringSize frames in the given format.
+        void Start(uint8_t* ring, Format format, bool rotated);
+        /// Waits until the worker is done with the frame of this stream it may be decoding.
+        void Stop();
+
+        /// Never blocks, until the frame is decoded the previously returned one is given,
+        /// nullptr until the first frame is decoded.
+        const uint8_t* GetFrame(uint32_t frame);
+
+        std::shared_ptr<const std::vector<char>> GetSource() const
+        {
+            return source;
+        }
+
+        std::shared_ptr<const GifLayout> GetLayout() const
+        {
+            return layout;
+        }
+
+    private:
+        static void* WorkerEntry(void* generation);
+        static void Work(uintptr_t generation);
+        bool FindWork(uint32_t& frame, int32_t& slot) const;
+        int32_t FindSlot(uint32_t frame) const;
+        bool IsWanted(int32_t frame) const;
+
+        void Rewind();
+        bool DecodeNext();
+        void StoreFrame(const stbi_uc* canvas, uint8_t* output) const;
+
+        // shared by all streams, guarded by m
+        static pthread_mutex_t m;
+        static pthread_cond_t changed;
+        static std::vector<FrameStream*> streams;
+        static FrameStream* decoding; // stream the worker is decoding, with m released
+        static size_t nextStream;
+        static pthread_t worker;
+        static uintptr_t workerGeneration; // workers of previous generations exit
+
+        std::shared_ptr<const std::vector<char>> source;
+        std::shared_ptr<const GifLayout> layout;
+        int32_t width, height, frames;
+        uint8_t* ring { nullptr };
+        uint32_t frameLength { 0 };
+        Format format { Format::ARGB8888 };
+        bool rotated { false };
+
+        // decoder state, only used by the worker
+        std::vector<stbi_uc> canvas {};
+        std::vector<stbi_uc> previousCanvas {}; // before the last frame, needed by frames restoring it
+        std::vector<stbi_uc> singleFrame {};
+        int32_t decodedFrames { 0 };
+
+        bool running { false };
+        bool failed { false };
+        bool missed { false };
+        int32_t slotFrames[ringSize];
+        BlitFence slotFences[ringSize]; // covers the blits of the frame last shown from the slot
+        int32_t shownSlot { -1 };
+        uint32_t requestedFrame { 0 };
+    };
+
+    pthread_mutex_t FrameStream::m = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t FrameStream::changed = PTHREAD_COND_INITIALIZER;
+    std::vector<FrameStream*> FrameStream::streams;
+    FrameStream* FrameStream::decoding = nullptr;
+    size_t FrameStream::nextStream = 0;
+    pthread_t FrameStream::worker;
+    uintptr_t FrameStream::workerGeneration = 0;
+
+    FrameStream::FrameStream(std::shared_ptr<const std::vector<char>> source, std::shared_ptr<const GifLayout> layout)
+        : source(source)
+        , layout(layout)
+        , width(layout->width)
+        , height(layout->height)
+        , frames(layout->frames.size())
+    {
+    }
+
+    FrameStream::~FrameStream()
+    {
+        Stop();
+    }
+
+    void FrameStream::Start(uint8_t* ring, Format format, bool rotated)
+    {
+        this->ring = ring;
+        this->format = format;
+        this->rotated = rotated;
+        frameLength = width * height * GetFormatStride(format);
+        memset(ring, 0, frameLength * ringSize);
+
+        for(uint32_t i = 0; i < ringSize; i++) {
+            slotFrames[i] = -1;
+            slotFences[i] = 0;
+        }
+        shownSlot = -1;
+        requestedFrame = 0;
+        failed = false;
+        missed = false;
+
+        canvas.resize(width * height * 4);
+        Rewind();
+
+        pthread_mutex_lock(&m);
+        if(streams.empty()) {
+            // a worker of a previous generation may still be exiting, it does not pick up new streams
+            if(pthread_create(&worker, nullptr, WorkerEntry, reinterpret_cast<void*>(workerGeneration)) != 0) {
+                Log(ERROR, "Failed to start the animation decoding thread");
+                failed = true;
+                pthread_mutex_unlock(&m);
+                return;
+            }
+        }
+        streams.push_back(this);
+        running = true;
+        pthread_cond_broadcast(&changed);
+        pthread_mutex_unlock(&m);
+    }
+
+    void FrameStream::Stop()
+    {
+        if(!running) {
+            return;
+        }
+
+        pthread_mutex_lock(&m);
+        streams.erase(std::find(streams.begin(), streams.end(), this));
+        while(decoding == this) {
+            pthread_cond_wait(&changed, &m);
+        }
+        running = false;
+
+        if(!streams.empty()) {
+            pthread_mutex_unlock(&m);
+            return;
+        }
+
+        // the last stream stops the worker
+        workerGeneration++;
+        const pthread_t stopped = worker;
+        pthread_cond_broadcast(&changed);
+        pthread_mutex_unlock(&m);
+
+        pthread_join(stopped, nullptr);
+    }
+
+    const uint8_t* FrameStream::GetFrame(uint32_t frame)
+    {
+        pthread_mutex_lock(&m);
+
+        frame %= frames;
+        if(frame != requestedFrame) {
+            requestedFrame = frame;
+            pthread_cond_broadcast(&changed);
+        }
+
+        int32_t slot = FindSlot(frame);
+        if(slot < 0) {
+            // keep displaying the previous frame, a redraw is requested once this one is ready
+            missed = true;
+            slot = shownSlot;
+        }
+
+        // slots are only shown once the worker stored a frame in them, until then there is nothing to draw
+        if(slot < 0) {
+            pthread_mutex_unlock(&m);
+            return nullptr;
+        }
+
+        if(slot != shownSlot) {
+            // the displayed frame is not overwritten, the previous one once its blits are done
+            if(shownSlot >= 0) {
+                slotFences[shownSlot] = Manager::GetInstance().painter.GetBlitFence();
+            }
+            shownSlot = slot;
+        }
+        const uint8_t* result = ring + slot * frameLength;
+
+        pthread_mutex_unlock(&m);
+        return result;
+    }
+
+    void* FrameStream::WorkerEntry(void* generation)
+    {
+        Work(reinterpret_cast<uintptr_t>(generation));
+        return nullptr;
+    }
+
+    void FrameStream::Work(uintptr_t generation)
+    {
+        pthread_mutex_lock(&m);
+        while(generation == workerGeneration) {
+            FrameStream* stream = nullptr;
+            uint32_t frame = 0;
+            int32_t slot = -1;
+            for(size_t i = 0; i < streams.size() && !stream; i++) {
+                FrameStream* candidate = streams[(nextStream + i) % streams.size()];
+                if(candidate->FindWork(frame, slot)) {
+                    stream = candidate;
+                    nextStream = (nextStream + i + 1) % streams.size();
+                }
+            }
+            if(!stream) {
+                pthread_cond_wait(&changed, &m);
+                continue;
+            }
+
+            // streams take turns decoding a single frame, so a long seek does not stall the others,
+            // GIF frames can only be decoded in order, going back means starting over
+            const bool rewind = static_cast<int32_t>(frame) + 1 < stream->decodedFrames;
+            const bool store = (rewind ? 0 : stream->decodedFrames) >= static_cast<int32_t>(frame);
+            BlitFence fence = 0;
+            if(store) {
+                stream->slotFrames[slot] = -1;
+                fence = stream->slotFences[slot];
+                stream->slotFences[slot] = 0;
+            }
+            decoding = stream;
+            pthread_mutex_unlock(&m);
+
+            if(rewind) {
+                stream->Rewind();
+            }
+            const bool decoded = stream->decodedFrames > static_cast<int32_t>(frame) || stream->DecodeNext();
+            if(decoded && store) {
+                Manager::GetInstance().painter.WaitForBlit(fence);
+                stream->StoreFrame(stream->canvas.data(), stream->ring + slot * stream->frameLength);
+            }
+
+            pthread_mutex_lock(&m);
+            decoding = nullptr;
+            pthread_cond_broadcast(&changed);
+
+            if(!decoded) {
+                Log(ERROR, "Failed to decode animation frame %d: %s", stream->decodedFrames, stbi_failure_reason());
+                stream->failed = true;
+                continue;
+            }
+
+            if(store) {
+                stream->slotFrames[slot] = frame;
+                if(stream->missed && frame == stream->requestedFrame) {
+                    stream->missed = false;
+                    pthread_mutex_unlock(&m);
+                    Manager::RequestRedraw();
+                    pthread_mutex_lock(&m);
+                }
+            }
+        }
+        pthread_mutex_unlock(&m);
+    }
+
+    bool FrameStream::FindWork(uint32_t& frame, int32_t& slot) const
+    {
+        if(failed) {
+            return false;
+        }
+
+        for(uint32_t ahead = 0; ahead < ringSize; ahead++) {
+            const uint32_t wanted = (requestedFrame + ahead) % frames;
+            if(FindSlot(wanted) >= 0) {
+                continue;
+            }
+
+            for(int32_t i = 0; i < static_cast<int32_t>(ringSize); i++) {
+                if(i != shownSlot && !IsWanted(slotFrames[i])) {
+                    frame = wanted;
+                    slot = i;
+                    return true;
+                }
+            }
+            return false;
+        }
+        return false;
+    }
+
+    int32_t FrameStream::FindSlot(uint32_t frame) const
+    {
+        for(int32_t i = 0; i < static_cast<int32_t>(ringSize); i++) {
+            if(slotFrames[i] == static_cast<int32_t>(frame)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool FrameStream::IsWanted(int32_t frame) const
+    {
+        return frame >= 0 && static_cast<uint32_t>(frame - requestedFrame + frames) % frames < ringSize;
+    }
+
+    void FrameStream::Rewind()
+    {
+        std::fill(canvas.begin(), canvas.end(), 0);
+        decodedFrames = 0;
+    }
+
+    bool FrameStream::DecodeNext()
+    {
+        const uint8_t* gif = reinterpret_cast<const uint8_t*>(source->data());
+        const GifFrame& frame = layout->frames[decodedFrames];
+
+        if(decodedFrames > 0) {
+            const GifFrame& previous = layout->frames[decodedFrames - 1];
+            if(previous.disposal == gifDisposeBackground) {
+                const int32_t left = std::min(previous.x, width);
+                const int32_t right = std::min(previous.x + previous.width, width);
+                for(int32_t y = previous.y; y < previous.y + previous.height && y < height; y++) {
+                    memset(canvas.data() + (y * width + left) * 4, 0, (right - left) * 4);
+                }
+            } else if(previous.disposal == gifDisposeRestorePrevious) {
+                canvas = previousCanvas;
+            }
+        }
+        if(frame.disposal == gifDisposeRestorePrevious) {
+            previousCanvas = canvas;
+        }
+
+        // stbi_load_from_memory only decodes the first frame of a GIF, so the frame is copied to a GIF of its own,
+        // sized to the frame so all of its pixels are decoded, and drawn over the canvas here
+        auto push16 = [this](uint32_t value) {
+            singleFrame.push_back(value & 0xFF);
+            singleFrame.push_back(value >> 8);
+        };
+        singleFrame.assign(gif, gif + 6);
+        push16(frame.width);
+        push16(frame.height);
+        singleFrame.push_back(gif[10]); // global color table flags
+        singleFrame.push_back(0); // background color
+        singleFrame.push_back(0); // pixel aspect ratio
+        singleFrame.insert(singleFrame.end(), gif + 13, gif + layout->colorTableEnd);
+        singleFrame.insert(singleFrame.end(), gif + frame.control, gif + frame.controlEnd);
+        singleFrame.push_back(gif[frame.image]);
+        push16(0);
+        push16(0);
+        singleFrame.insert(singleFrame.end(), gif + frame.image + 5, gif + frame.imageEnd);
+        singleFrame.push_back(0x3B);
+
+        int frameWidth = 0;
+        int frameHeight = 0;
+        int channels = 0;
+        stbi_uc* pixels = stbi_load_from_memory(singleFrame.data(), static_cast<int>(singleFrame.size()), &frameWidth, &frameHeight, &channels, 4);
+        if(!pixels) {
+            return false;
+        }
+
+        // transparent pixels keep what the previous frames left
+        for(int32_t y = 0; y < frameHeight && frame.y + y < height; y++) {
+            for(int32_t x = 0; x < frameWidth && frame.x + x < width; x++) {
+                const stbi_uc* rgba = pixels + (y * frameWidth + x) * 4;
+                if(rgba[3] != 0) {
+                    memcpy(canvas.data() + ((frame.y + y) * width + frame.x + x) * 4, rgba, 4);
+                }
+            }
+        }
+        stbi_image_free(pixels);
+
+        decodedFrames++;
+        return true;
+    }
+
+    void FrameStream::StoreFrame(const stbi_uc* canvas, uint8_t* output) const
+    {
+        const uint32_t stride = GetFormatStride(format);
+
+        for(int32_t y = 0; y < height; y++) {
+            for(int32_t x = 0; x < width; x++) {
+                const stbi_uc* rgba = canvas + (y * width + x) * 4;
+                const uint32_t color = ConvertColorFormat(rgba[3] << 24 | rgba[0] << 16 | rgba[1] << 8 | rgba[2], Format::ARGB8888, format);
+
+                // same layout as ImageContent::Rotate90
+                const uint32_t index = rotated ? (width - x - 1) * height + y : y * width + x;
+                memcpy(output + index * stride, &color, stride);
+            }
+        }
+    }
+
 
     ImageContent::ImageContent(const char* path, Format format)
     {
@@ -48,9 +618,31 @@ namespace grvl {
             image_format = format;
         }
 
+        // files already in memory, e.g. uncompressed bundle entries, are decoded in place
         File file(path);
-        const std::vector<char> fileData = file.Read();
-        if(fileData.empty()) {
+        std::vector<char> fileData;
+        const uint8_t* fileBytes = file.GetMappedData();
+        size_t fileSize = fileBytes ? file.GetSize() : 0;
+
+        // other files are read once, the header tells whether the image can be decoded while reading,
+        // image files and GIFs are parsed from memory, so they are read whole
+        std::unique_ptr<File::Reader> reader;
+        if(!fileBytes) {
+            reader = std::make_unique<File::Reader>(file);
+            fileData.resize(sizeof(ImageFileHeader));
+            const int32_t headerSize = reader->Read(reinterpret_cast<uint8_t*>(fileData.data()), fileData.size());
+            fileData.resize(std::max<int32_t>(headerSize, 0));
+
+            if(fileData.size() < sizeof(imageFileMagic) || memcmp(fileData.data(), imageFileMagic, sizeof(imageFileMagic)) == 0 || memcmp(fileData.data(), "GIF8", 4) == 0) {
+                reader->ReadToEnd(fileData);
+                reader.reset();
+            }
+
+            fileBytes = reinterpret_cast<const uint8_t*>(fileData.data());
+            fileSize = fileData.size();
+        }
+
+        if(fileSize == 0) {
             Log(ERROR, "Failed to read image %s", path);
             this->data = nullptr;
             this->width = 0;
@@ -61,37 +653,71 @@ namespace grvl {
             return;
         }
 
+        // images prepared with ImageContent::Save are used as stored, in their own format
+        if(fileSize >= sizeof(ImageFileHeader) && memcmp(fileBytes, imageFileMagic, sizeof(imageFileMagic)) == 0) {
+            // mapped files are used in place, they stay in memory until their bundle is unmounted
+            if(LoadImageFile(fileBytes, fileSize, path, fileData.empty())) {
+                Log(INFO, "Loaded %dx%d image %s as %s", width, height, path, GetFormatName(this->format));
+            }
+            return;
+        }
+
+        // long animations are decoded during playback, keeping only the compressed file in memory
+        GifLayout layout;
+        if(ScanGif(fileBytes, fileSize, layout)
+           && layout.frameDurations.size() > FrameStream::ringSize) {
+            this->width = layout.width;
+            this->height = layout.height;
+            this->frames = layout.frameDurations.size();
+            this->format = format;
+            this->frameDurations = std::move(layout.frameDurations);
+            this->data = nullptr;
+            if(fileData.empty()) {
+                fileData.assign(fileBytes, fileBytes + fileSize);
+            }
+            StartStream(std::make_shared<const std::vector<char>>(std::move(fileData)), std::make_shared<const GifLayout>(std::move(layout)));
+
+            Log(INFO, "Streaming %dx%d animation %s (%d frames) as %s", width, height, path, frames, GetFormatName(format));
+            return;
+        }
+
         int32_t file_channels;
         const int channels = GetFormatChannelCount(image_format);
 
         int* gifDelays = nullptr;
         int gifFrames = 0;
-        this->data = stbi_load_gif_from_memory(
-            reinterpret_cast<const stbi_uc*>(fileData.data()),
-            static_cast<int>(fileData.size()),
-            &gifDelays,
-            &width,
-            &height,
-            &gifFrames,
-            &file_channels,
-            channels);
-
-        if(this->data) {
-            this->frames = gifFrames;
-            frameDurations.reserve(gifFrames);
-            for(int frame = 0; frame < gifFrames; ++frame) {
-                frameDurations.push_back(gifDelays[frame] > 0 ? gifDelays[frame] : 100);
-            }
-            STBI_FREE(gifDelays);
+        if(reader) {
+            ImageReader stream {*reader, fileData};
+            this->data = stbi_load_from_callbacks(&ImageReader::callbacks, &stream, &width, &height, &file_channels, channels);
+            this->frames = this->data ? 1 : 0;
         } else {
-            this->data = stbi_load_from_memory(
-                reinterpret_cast<const stbi_uc*>(fileData.data()),
-                static_cast<int>(fileData.size()),
+            this->data = stbi_load_gif_from_memory(
+                reinterpret_cast<const stbi_uc*>(fileBytes),
+                static_cast<int>(fileSize),
+                &gifDelays,
                 &width,
                 &height,
+                &gifFrames,
                 &file_channels,
                 channels);
-            this->frames = this->data ? 1 : 0;
+
+            if(this->data) {
+                this->frames = gifFrames;
+                frameDurations.reserve(gifFrames);
+                for(int frame = 0; frame < gifFrames; ++frame) {
+                    frameDurations.push_back(gifDelays[frame] > 0 ? gifDelays[frame] : 100);
+                }
+                STBI_FREE(gifDelays);
+            } else {
+                this->data = stbi_load_from_memory(
+                    reinterpret_cast<const stbi_uc*>(fileBytes),
+                    static_cast<int>(fileSize),
+                    &width,
+                    &height,
+                    &file_channels,
+                    channels);
+                this->frames = this->data ? 1 : 0;
+            }
         }
 
         if (!this->data) {
@@ -108,18 +734,7 @@ namespace grvl {
 
         // grvl and STB use a different channel order, we swap them here
         if (image_format == Format::ARGB8888) {
-            Pixel* pixels = reinterpret_cast<Pixel*>(this->data);
-            const uint32_t length = width * height * frames;
-
-            for (uint32_t i = 0; i < length; i ++) {
-                Pixel& pixel = pixels[i];
-
-#if GRVL_BIG_ENDIAN
-                pixel.data = (pixel.data >> 8) | (pixel.channels.a << 24);
-#else
-                std::swap(pixel.channels.r, pixel.channels.b);
-#endif
-            }
+            SwapRedBlue(this->data, width * height * frames);
         }
 
         // if the format could not have been loaded directly we perform transcoding
@@ -151,32 +766,39 @@ namespace grvl {
 
     ImageContent::ImageContent(const ImageContent& other)
     {
-        const auto size = other.GetDataLength();
-        data = static_cast<uint8_t*>(malloc(size));
-        if (data && other.data) {
-            memcpy(data, other.data, size);
-        }
-
         width = other.width;
         height = other.height;
         frames = other.frames;
         format = other.format;
         rotated = other.rotated;
         frameDurations = other.frameDurations;
-    }
+        lineIndex = other.lineIndex;
+        palette = other.palette;
+        for (const auto& level : other.mipLevels) {
+            mipLevels.push_back(std::make_unique<ImageContent>(*level));
+        }
 
-    ImageContent& ImageContent::operator=(const ImageContent& other)
-    {
-        if (this == &other) {
-            return *this;
+        if (other.stream) {
+            data = nullptr;
+            StartStream(other.stream->GetSource(), other.stream->GetLayout());
+            return;
         }
 
         const auto size = other.GetDataLength();
-        if (data) free(data);
         data = static_cast<uint8_t*>(malloc(size));
         if (data && other.data) {
             memcpy(data, other.data, size);
         }
+    }
+
+    ImageContent& ImageContent::operator=(const ImageContent& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        stream.reset();
+        FreeData();
 
         width = other.width;
         height = other.height;
@@ -184,16 +806,69 @@ namespace grvl {
         format = other.format;
         rotated = other.rotated;
         frameDurations = other.frameDurations;
+        lineIndex = other.lineIndex;
+        palette = other.palette;
+        mipLevels.clear();
+        for (const auto& level : other.mipLevels) {
+            mipLevels.push_back(std::make_unique<ImageContent>(*level));
+        }
+
+        if (other.stream) {
+            StartStream(other.stream->GetSource(), other.stream->GetLayout());
+            return *this;
+        }
+
+        const auto size = other.GetDataLength();
+        data = static_cast<uint8_t*>(malloc(size));
+        if (data && other.data) {
+            memcpy(data, other.data, size);
+        }
 
         return *this;
     }
 
     ImageContent::~ImageContent()
     {
-        if (data) {
+        // the decoding thread writes to data
+        stream.reset();
+        FreeData();
+    }
+
+    void ImageContent::FreeData()
+    {
+        if (data && ownsData) {
             free(data);
-            data = nullptr;
         }
+        data = nullptr;
+        ownsData = true;
+    }
+
+    uint8_t* ImageContent::GetFrameData(uint32_t frame)
+    {
+        if (stream) {
+            return const_cast<uint8_t*>(stream->GetFrame(frame));
+        }
+        return data + GetFrameDataLength() * frame;
+    }
+
+    const uint8_t* ImageContent::GetFrameData(uint32_t frame) const
+    {
+        if (stream) {
+            return stream->GetFrame(frame);
+        }
+        return data + GetFrameDataLength() * frame;
+    }
+
+    uint32_t ImageContent::GetNumberOfStoredFrames() const
+    {
+        return stream ? FrameStream::ringSize : frames;
+    }
+
+    void ImageContent::StartStream(std::shared_ptr<const std::vector<char>> source, std::shared_ptr<const GifLayout> layout)
+    {
+        stream.reset(new FrameStream(source, layout));
+        data = static_cast<uint8_t*>(malloc(GetDataLength()));
+        stream->Start(data, format, rotated);
     }
 
     void ImageContent::Transcode(Format target)
@@ -202,6 +877,30 @@ namespace grvl {
             return;
         }
 
+        for (auto& level : mipLevels) {
+            level->Transcode(target);
+        }
+
+        if (IsCompressed()) {
+            Decompress();
+            if (IsEmpty()) {
+                return;
+            }
+            Transcode(target);
+            Compress();
+            return;
+        }
+
+        if (stream) {
+            // only the frames in the ring are stored, decode them again in the new format
+            stream->Stop();
+            FreeData();
+            this->format = target;
+            data = static_cast<uint8_t*>(malloc(GetDataLength()));
+            stream->Start(data, format, rotated);
+            return;
+        }
+
         const int input_stride = GetBytesPerPixel();
         const int output_stride = GetFormatStride(target);
 
@@ -211,15 +910,21 @@ namespace grvl {
         const uint8_t* input_buffer = data;
         uint8_t* output_buffer = static_cast<uint8_t*>(malloc(output_size));
 
-        for (uint32_t j = 0, i = 0; i < input_size; i += input_stride) {
-            ConvertPixel(input_buffer + i, output_buffer + j, format, target);
-            j += output_stride;
+        if (palette.empty()) {
+            ConvertPixels(input_buffer, output_buffer, width * height * frames, format, target);
+        } else {
+            for (uint32_t j = 0, i = 0; i < input_size; i += input_stride) {
+                const uint32_t color = ConvertColorFormat(GetPixelColor(input_buffer + i), Format::ARGB8888, target);
+                memcpy(output_buffer + j, &color, output_stride);
+                j += output_stride;
+            }
         }
 
         // update object
-        free(this->data);
+        FreeData();
         this->data = output_buffer;
         this->format = target;
+        this->palette.clear();
     }
 
     // Rotates image content CCW
@@ -233,6 +938,35 @@ namespace grvl {
             return;
         }
 
+        for (auto& level : mipLevels) {
+            level->Rotate90();
+        }
+
+        if (IsCompressed()) {
+            Decompress();
+            if (IsEmpty()) {
+                return;
+            }
+            Rotate90();
+            Compress();
+            return;
+        }
+
+        if (stream) {
+            stream->Stop();
+            this->rotated = true;
+            stream->Start(data, format, rotated);
+            return;
+        }
+
+
+        // data used in place is read only, it's rotated in a copy
+        if (!ownsData) {
+            uint8_t* copy = static_cast<uint8_t*>(malloc(GetDataLength()));
+            memcpy(copy, data, GetDataLength());
+            data = copy;
+            ownsData = true;
+        }
 
         uint8_t* frame_copy = static_cast<uint8_t*>(malloc(GetFrameDataLength()));
         uint32_t bytes_per_pixel = GetBytesPerPixel();
@@ -241,18 +975,663 @@ namespace grvl {
             uint8_t* frame_data = GetFrameData(f);
             memcpy(frame_copy, frame_data, GetFrameDataLength());
 
-            for(uint32_t y = 0; y < height; y++) {
-                for(uint32_t x = 0; x < width; x++) {
-                    uint32_t new_x = y;
-                    uint32_t new_y = width - x - 1;
-                    memcpy(frame_data + (new_y * height + new_x) * bytes_per_pixel, frame_copy + (y * width + x) * bytes_per_pixel, bytes_per_pixel);
-                }
-            }
+            RotatePixels90(frame_copy, frame_data, width, height, bytes_per_pixel);
         }
         free(frame_copy);
         this->rotated = true;
     }
 
+    // Every line is a sequence of packets, starting with a header byte.
+    // Headers with the top bit set are followed by a single pixel repeated (header & 0x7F) + 1 times,
+    // other headers are followed by (header + 1) literal pixels.
+    static constexpr uint8_t runFlag = 0x80;
+    static constexpr uint32_t maxPacketLength = 128;
+
+    static void EncodeLine(const uint8_t* line, uint32_t pixels, uint32_t stride, std::vector<uint8_t>& output)
+    {
+        auto samePixels = [line, stride](uint32_t a, uint32_t b) { return memcmp(line + a * stride, line + b * stride, stride) == 0; };
+
+        uint32_t i = 0;
+        while (i < pixels) {
+            uint32_t run = 1;
+            while (i + run < pixels && run < maxPacketLength && samePixels(i, i + run)) {
+                run++;
+            }
+
+            if (run > 1) {
+                output.push_back(runFlag | (run - 1));
+                output.insert(output.end(), line + i * stride, line + (i + 1) * stride);
+                i += run;
+                continue;
+            }
+
+            // literal pixels until the next run
+            const uint32_t start = i;
+            while (i < pixels && i - start < maxPacketLength && !(i + 1 < pixels && samePixels(i, i + 1))) {
+                i++;
+            }
+            output.push_back(i - start - 1);
+            output.insert(output.end(), line + start * stride, line + i * stride);
+        }
+    }
+
+    // Lines of loaded files have to cover exactly their pixels, and end where the next line starts
+    static bool IsValidLine(const uint8_t* packet, uint32_t size, uint32_t pixels, uint32_t stride)
+    {
+        uint32_t position = 0;
+        uint32_t consumed = 0;
+        while (position < pixels) {
+            if (consumed == size) {
+                return false;
+            }
+
+            const uint8_t header = packet[consumed++];
+            const uint32_t length = (header & ~runFlag) + 1;
+            const uint32_t bytes = (header & runFlag) ? stride : length * stride;
+            if (size - consumed < bytes) {
+                return false;
+            }
+
+            consumed += bytes;
+            position += length;
+        }
+
+        return position == pixels && consumed == size;
+    }
+
+    bool ImageContent::Compress()
+    {
+        if (IsCompressed()) {
+            return true;
+        }
+
+        if (IsEmpty() || stream) {
+            return false;
+        }
+
+        for (auto& level : mipLevels) {
+            level->Compress();
+        }
+
+        const uint32_t stride = GetBytesPerPixel();
+        const uint32_t lines = GetNumberOfLines();
+        const uint32_t pixelsPerLine = GetPixelsPerLine();
+
+        std::vector<uint8_t> encoded;
+        std::vector<uint32_t> index;
+        index.reserve(lines * frames + 1);
+
+        for (int32_t f = 0; f < frames; f++) {
+            for (uint32_t line = 0; line < lines; line++) {
+                index.push_back(encoded.size());
+                EncodeLine(data + (f * lines + line) * pixelsPerLine * stride, pixelsPerLine, stride, encoded);
+            }
+        }
+        index.push_back(encoded.size());
+
+        const uint32_t rawLength = GetDataLength();
+        if (encoded.size() + index.size() * sizeof(uint32_t) >= rawLength) {
+            Log(INFO, "Image %dx%d does not compress (%u >= %u bytes), keeping it uncompressed", width, height, (uint32_t)encoded.size(), rawLength);
+            return false;
+        }
+
+        uint8_t* compressed = static_cast<uint8_t*>(malloc(encoded.size()));
+        if (!compressed) {
+            Log(ERROR, "Failed to allocate %u bytes for a compressed image", (uint32_t)encoded.size());
+            return false;
+        }
+        memcpy(compressed, encoded.data(), encoded.size());
+
+        FreeData();
+        data = compressed;
+        lineIndex = std::move(index);
+
+        Log(INFO, "Compressed %dx%d image from %u to %u bytes", width, height, rawLength, GetDataLength());
+        return true;
+    }
+
+    void ImageContent::Decompress()
+    {
+        if (!IsCompressed()) {
+            return;
+        }
+
+        for (auto& level : mipLevels) {
+            level->Decompress();
+        }
+
+        const uint32_t lines = GetNumberOfLines();
+        const uint32_t lineLength = GetPixelsPerLine() * GetBytesPerPixel();
+
+        uint8_t* pixels = static_cast<uint8_t*>(malloc(lineLength * lines * frames));
+        if (!pixels) {
+            // the content is left empty, rather than compressed lines drawn as raw pixels
+            Log(ERROR, "Failed to allocate %u bytes for a decompressed image", lineLength * lines * frames);
+            FreeData();
+            lineIndex.clear();
+            return;
+        }
+
+        for (int32_t f = 0; f < frames; f++) {
+            for (uint32_t line = 0; line < lines; line++) {
+                DecodeLine(f, line, 0, GetPixelsPerLine(), pixels + (f * lines + line) * lineLength);
+            }
+        }
+
+        FreeData();
+        data = pixels;
+        lineIndex.clear();
+    }
+
+    void ImageContent::DecodeLine(uint32_t frame, uint32_t line, uint32_t firstPixel, uint32_t pixels, uint8_t* output) const
+    {
+        const uint32_t stride = GetBytesPerPixel();
+        const uint32_t end = firstPixel + pixels;
+        const uint8_t* packet = data + lineIndex[frame * GetNumberOfLines() + line];
+
+        uint32_t position = 0;
+        while (position < end) {
+            const uint8_t header = *packet++;
+            const uint32_t length = (header & ~runFlag) + 1;
+            const bool run = header & runFlag;
+
+            // copy the part of the packet within the requested pixels
+            const uint32_t from = position > firstPixel ? position : firstPixel;
+            const uint32_t to = position + length < end ? position + length : end;
+            if (from < to) {
+                if (run) {
+                    for (uint32_t i = from; i < to; i++) {
+                        memcpy(output, packet, stride);
+                        output += stride;
+                    }
+                } else {
+                    memcpy(output, packet + (from - position) * stride, (to - from) * stride);
+                    output += (to - from) * stride;
+                }
+            }
+
+            packet += run ? stride : length * stride;
+            position += length;
+        }
+    }
+
+    uint32_t ImageContent::GetPixelColor(const uint8_t* pixel) const
+    {
+        const uint32_t color = ConvertPixel(pixel, format, Format::ARGB8888);
+        if (palette.empty()) {
+            return color;
+        }
+
+        // L8 and AL88 store the palette index in the first byte
+        const uint8_t* entry = palette.data() + pixel[0] * 3;
+        return (color & 0xFF000000) | entry[2] << 16 | entry[1] << 8 | entry[0];
+    }
+
+    struct HistogramEntry {
+        uint32_t color;
+        uint32_t count;
+    };
+
+    static int32_t ColorChannel(uint32_t color, int channel)
+    {
+        return (color >> (channel * 8)) & 0xFF;
+    }
+
+    void ImageContent::GenerateMipLevels(uint32_t levels)
+    {
+        mipLevels.clear();
+
+        if (IsEmpty() || stream) {
+            Log(WARN, "Mip levels are not available for empty or streamed images");
+            return;
+        }
+
+        const ImageContent* previous = this;
+        while (mipLevels.size() < levels && previous->width >= 2 && previous->height >= 2) {
+            mipLevels.push_back(previous->Downsample());
+            previous = mipLevels.back().get();
+        }
+    }
+
+    void ImageContent::ClearMipLevels()
+    {
+        mipLevels.clear();
+    }
+
+    // Every pixel of the level averages a 2x2 block of stored pixels, colors are weighted by their alpha
+    // so that transparent pixels do not darken the edges
+    std::unique_ptr<ImageContent> ImageContent::Downsample() const
+    {
+        auto level = std::make_unique<ImageContent>(width / 2, height / 2, frames, Format::ARGB8888);
+        level->rotated = rotated;
+        level->frameDurations = frameDurations;
+
+        const uint32_t stride = GetBytesPerPixel();
+        const uint32_t pixelsPerLine = GetPixelsPerLine();
+        const uint32_t levelLines = level->GetNumberOfLines();
+        const uint32_t levelPixelsPerLine = level->GetPixelsPerLine();
+        std::vector<uint8_t> decoded(IsCompressed() ? 2 * pixelsPerLine * stride : 0);
+        uint32_t* output = reinterpret_cast<uint32_t*>(level->data);
+
+        for (int32_t f = 0; f < frames; f++) {
+            for (uint32_t line = 0; line < levelLines; line++) {
+                const uint8_t* rows[2];
+                for (uint32_t i = 0; i < 2; i++) {
+                    if (IsCompressed()) {
+                        rows[i] = decoded.data() + i * pixelsPerLine * stride;
+                        DecodeLine(f, line * 2 + i, 0, pixelsPerLine, decoded.data() + i * pixelsPerLine * stride);
+                    } else {
+                        rows[i] = GetFrameData(f) + (line * 2 + i) * pixelsPerLine * stride;
+                    }
+                }
+
+                for (uint32_t x = 0; x < levelPixelsPerLine; x++) {
+                    uint32_t alpha = 0, channels[3] = {0, 0, 0};
+                    for (uint32_t i = 0; i < 4; i++) {
+                        const uint32_t color = GetPixelColor(rows[i / 2] + (x * 2 + i % 2) * stride);
+                        const uint32_t weight = color >> 24;
+                        alpha += weight;
+                        for (int channel = 0; channel < 3; channel++) {
+                            channels[channel] += ColorChannel(color, channel) * weight;
+                        }
+                    }
+
+                    uint32_t color = (alpha / 4) << 24;
+                    for (int channel = 0; channel < 3; channel++) {
+                        color |= (alpha ? channels[channel] / alpha : 0) << (channel * 8);
+                    }
+                    *output++ = color;
+                }
+            }
+        }
+
+        if (!palette.empty()) {
+            level->Palettize(0xFF);
+        } else {
+            level->Transcode(format);
+        }
+
+        if (IsCompressed()) {
+            level->Compress();
+        }
+
+        return level;
+    }
+
+    // Median cut, the box with the widest range of a color channel is split at its median until there are enough boxes,
+    // the palette holds the average color of every box
+    static std::vector<uint32_t> MedianCut(std::vector<HistogramEntry>& entries, uint32_t colors)
+    {
+        struct Box {
+            size_t begin, end;
+            int channel;
+            int32_t range;
+        };
+
+        auto describe = [&entries](size_t begin, size_t end) {
+            Box box { begin, end, 0, 0 };
+            for (int channel = 0; channel < 3; channel++) {
+                int32_t low = 0xFF, high = 0;
+                for (size_t i = begin; i < end; i++) {
+                    low = std::min(low, ColorChannel(entries[i].color, channel));
+                    high = std::max(high, ColorChannel(entries[i].color, channel));
+                }
+                if (high - low > box.range) {
+                    box.range = high - low;
+                    box.channel = channel;
+                }
+            }
+            return box;
+        };
+
+        std::vector<Box> boxes { describe(0, entries.size()) };
+
+        while (boxes.size() < colors) {
+            auto widest = std::max_element(boxes.begin(), boxes.end(), [](const Box& a, const Box& b) { return a.range < b.range; });
+            if (widest->range == 0) {
+                break; // every box holds a single color
+            }
+
+            const Box box = *widest;
+            std::sort(entries.begin() + box.begin, entries.begin() + box.end, [&box](const HistogramEntry& a, const HistogramEntry& b) {
+                return ColorChannel(a.color, box.channel) < ColorChannel(b.color, box.channel);
+            });
+
+            uint64_t total = 0;
+            for (size_t i = box.begin; i < box.end; i++) {
+                total += entries[i].count;
+            }
+
+            size_t split = box.begin + 1;
+            uint64_t sum = entries[box.begin].count;
+            while (split < box.end - 1 && (sum + entries[split].count) * 2 <= total) {
+                sum += entries[split++].count;
+            }
+
+            *widest = describe(box.begin, split);
+            boxes.push_back(describe(split, box.end));
+        }
+
+        std::vector<uint32_t> palette;
+        for (const Box& box : boxes) {
+            uint64_t sums[3] = {};
+            uint64_t total = 0;
+            for (size_t i = box.begin; i < box.end; i++) {
+                for (int channel = 0; channel < 3; channel++) {
+                    sums[channel] += static_cast<uint64_t>(ColorChannel(entries[i].color, channel)) * entries[i].count;
+                }
+                total += entries[i].count;
+            }
+
+            uint32_t color = 0;
+            for (int channel = 0; channel < 3 && total > 0; channel++) {
+                color |= ((sums[channel] + total / 2) / total) << (channel * 8);
+            }
+            palette.push_back(color);
+        }
+        return palette;
+    }
+
+    static uint8_t NearestColor(const std::vector<uint32_t>& colors, uint32_t color)
+    {
+        uint8_t nearest = 0;
+        int32_t best = INT32_MAX;
+        for (size_t i = 0; i < colors.size() && best > 0; i++) {
+            int32_t distance = 0;
+            for (int channel = 0; channel < 3; channel++) {
+                const int32_t difference = ColorChannel(color, channel) - ColorChannel(colors[i], channel);
+                distance += difference * difference;
+            }
+            if (distance < best) {
+                best = distance;
+                nearest = i;
+            }
+        }
+        return nearest;
+    }
+
+    bool ImageContent::Palettize(uint8_t tolerance, bool dither)
+    {
+        if (!palette.empty()) {
+            return true;
+        }
+
+        if (IsEmpty() || stream) {
+            return false;
+        }
+
+        if (IsCompressed()) {
+            Decompress();
+            const bool palettized = Palettize(tolerance, dither);
+            Compress();
+            return palettized;
+        }
+
+        const uint32_t stride = GetBytesPerPixel();
+        const uint32_t pixels = width * height * frames;
+
+        // fully transparent pixels can use any palette entry, so they are left out
+        std::unordered_map<uint32_t, uint32_t> histogram;
+        bool transparent = false;
+        for (uint32_t i = 0; i < pixels; i++) {
+            const uint32_t color = GetPixelColor(data + i * stride);
+            transparent |= (color >> 24) != 0xFF;
+            if ((color >> 24) != 0) {
+                histogram[color & 0x00FFFFFF]++;
+            }
+        }
+
+        std::vector<HistogramEntry> entries;
+        entries.reserve(histogram.size());
+        for (const auto& [color, count] : histogram) {
+            entries.push_back({ color, count });
+        }
+
+        const std::vector<uint32_t> colors = MedianCut(entries, paletteEntries);
+
+        std::unordered_map<uint32_t, uint8_t> indices;
+        int32_t maxError = 0;
+        for (const HistogramEntry& entry : entries) {
+            const uint8_t index = NearestColor(colors, entry.color);
+            indices[entry.color] = index;
+            for (int channel = 0; channel < 3; channel++) {
+                maxError = std::max(maxError, std::abs(ColorChannel(entry.color, channel) - ColorChannel(colors[index], channel)));
+            }
+        }
+
+        if (maxError > tolerance) {
+            Log(INFO, "Image %dx%d has %u colors, a palette would differ by up to %d", width, height, (uint32_t)entries.size(), maxError);
+            return false;
+        }
+
+        const Format target = transparent ? Format::AL88 : Format::L8;
+        const uint32_t outputStride = GetFormatStride(target);
+        uint8_t* output = static_cast<uint8_t*>(malloc(pixels * outputStride));
+
+        auto store = [&](uint32_t pixel, uint8_t index, uint8_t alpha) {
+            output[pixel * outputStride] = index;
+            if (target == Format::AL88) {
+                output[pixel * outputStride + 1] = alpha;
+            }
+        };
+
+        if (!dither || maxError == 0) {
+            for (uint32_t i = 0; i < pixels; i++) {
+                const uint32_t color = GetPixelColor(data + i * stride);
+                const uint8_t alpha = color >> 24;
+                store(i, alpha ? indices[color & 0x00FFFFFF] : 0, alpha);
+            }
+        } else {
+            // Floyd-Steinberg, errors are kept in 1/16 units for the current and the next line, with a pixel of padding on both sides
+            const uint32_t lines = GetNumberOfLines();
+            const uint32_t lineLength = GetPixelsPerLine();
+            std::vector<int32_t> errors(2 * (lineLength + 2) * 3);
+
+            for (int32_t f = 0; f < frames; f++) {
+                std::fill(errors.begin(), errors.end(), 0);
+
+                for (uint32_t line = 0; line < lines; line++) {
+                    int32_t* current = errors.data() + (line % 2) * (lineLength + 2) * 3;
+                    int32_t* next = errors.data() + ((line + 1) % 2) * (lineLength + 2) * 3;
+                    std::fill(next, next + (lineLength + 2) * 3, 0);
+
+                    for (uint32_t x = 0; x < lineLength; x++) {
+                        const uint32_t pixel = (f * lines + line) * lineLength + x;
+                        const uint32_t color = GetPixelColor(data + pixel * stride);
+                        const uint8_t alpha = color >> 24;
+                        if (alpha == 0) {
+                            store(pixel, 0, 0);
+                            continue;
+                        }
+
+                        uint32_t wanted = 0;
+                        for (int channel = 0; channel < 3; channel++) {
+                            const int32_t value = ColorChannel(color, channel) + current[(x + 1) * 3 + channel] / 16;
+                            wanted |= std::clamp(value, 0, 0xFF) << (channel * 8);
+                        }
+
+                        auto cached = indices.find(wanted);
+                        const uint8_t index = cached != indices.end() ? cached->second : (indices[wanted] = NearestColor(colors, wanted));
+                        store(pixel, index, alpha);
+
+                        for (int channel = 0; channel < 3; channel++) {
+                            const int32_t error = ColorChannel(wanted, channel) - ColorChannel(colors[index], channel);
+                            current[(x + 2) * 3 + channel] += error * 7;
+                            next[(x + 0) * 3 + channel] += error * 3;
+                            next[(x + 1) * 3 + channel] += error * 5;
+                            next[(x + 2) * 3 + channel] += error * 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        palette.assign(paletteEntries * 3, 0);
+        for (size_t i = 0; i < colors.size(); i++) {
+            for (int channel = 0; channel < 3; channel++) {
+                palette[i * 3 + channel] = ColorChannel(colors[i], channel);
+            }
+        }
+
+        FreeData();
+        data = output;
+        format = target;
+
+        // levels are averaged from the original colors, so they get their own palettes
+        for (auto& level : mipLevels) {
+            level->Palettize(0xFF, dither);
+        }
+
+        Log(INFO, "Palettized %dx%d image to %u colors as %s", width, height, (uint32_t)colors.size(), GetFormatName(format));
+        return true;
+    }
+
+    int ImageContent::Save(const char* path) const
+    {
+        if (IsEmpty() || stream) {
+            Log(ERROR, "Unable to save image %s, the content is empty or streamed", path);
+            return -1;
+        }
+
+        FILE* file = fopen(path, "wb");
+
+        if (file == nullptr) {
+            return -1;
+        }
+
+        ImageFileHeader header {};
+        memcpy(header.magic, imageFileMagic, sizeof(header.magic));
+        header.version = BigEndian32(0UL);
+        header.width = BigEndian32(width);
+        header.height = BigEndian32(height);
+        header.frames = BigEndian32(frames);
+        header.format = BigEndian32(static_cast<uint32_t>(format));
+        header.flags = BigEndian32(rotated ? imageFileRotated : 0);
+        header.durations = BigEndian32(frameDurations.size());
+        header.lines = BigEndian32(lineIndex.size());
+        header.palette = BigEndian32(palette.size());
+        header.data = BigEndian32(GetDataLength());
+        fwrite(&header, 1, sizeof(header), file);
+
+        for (uint32_t duration : frameDurations) {
+            const uint32_t value = BigEndian32(duration);
+            fwrite(&value, 1, sizeof(value), file);
+        }
+
+        for (uint32_t offset : lineIndex) {
+            const uint32_t value = BigEndian32(offset);
+            fwrite(&value, 1, sizeof(value), file);
+        }
+
+        // pixels are written as they are stored in memory
+        fwrite(palette.data(), 1, palette.size(), file);
+        fwrite(data, 1, GetDataLength(), file);
+        fclose(file);
+
+        return 0;
+    }
+
+    bool ImageContent::LoadImageFile(const uint8_t* bytes, size_t size, const char* path, bool inPlace)
+    {
+        this->data = nullptr;
+        this->width = 0;
+        this->height = 0;
+        this->frames = 0;
+        this->format = Format::ARGB8888;
+        this->frameDurations.clear();
+
+        ImageFileHeader header;
+        memcpy(&header, bytes, sizeof(header));
+
+        const uint32_t version = BigEndian32(header.version);
+        const uint32_t format = BigEndian32(header.format);
+        const uint32_t durations = BigEndian32(header.durations);
+        const uint32_t lines = BigEndian32(header.lines);
+        const uint32_t paletteSize = BigEndian32(header.palette);
+        const uint32_t dataSize = BigEndian32(header.data);
+
+        if (version != 0) {
+            Log(ERROR, "Image file %s has unknown version %d!", path, version);
+            return false;
+        }
+
+        const uint64_t expected = sizeof(header) + 4ULL * durations + 4ULL * lines + paletteSize + dataSize;
+        if (format > static_cast<uint32_t>(Format::AXXX8888) || paletteSize > paletteEntries * 3 || expected > size) {
+            Log(ERROR, "Image file %s has invalid header", path);
+            return false;
+        }
+
+        const uint32_t imageWidth = BigEndian32(header.width);
+        const uint32_t imageHeight = BigEndian32(header.height);
+        const uint32_t imageFrames = BigEndian32(header.frames);
+        const bool imageRotated = BigEndian32(header.flags) & imageFileRotated;
+        const uint64_t storedLines = static_cast<uint64_t>(imageRotated ? imageWidth : imageHeight) * imageFrames;
+        const uint64_t rawSize = static_cast<uint64_t>(imageWidth) * imageHeight * imageFrames * GetFormatStride(static_cast<Format>(format));
+        if ((lines == 0 && dataSize != rawSize) || (lines != 0 && lines != storedLines + 1)) {
+            Log(ERROR, "Image file %s has invalid data size", path);
+            return false;
+        }
+
+        const uint8_t* position = bytes + sizeof(header);
+        auto read32 = [&position]() {
+            uint32_t value;
+            memcpy(&value, position, sizeof(value));
+            position += sizeof(value);
+            return BigEndian32(value);
+        };
+
+        for (uint32_t i = 0; i < durations; i++) {
+            frameDurations.push_back(read32());
+        }
+
+        // every line is decoded from its offset up to the next one, so the offsets can't decrease or leave the data
+        bool validIndex = true;
+        lineIndex.clear();
+        for (uint32_t i = 0; i < lines; i++) {
+            const uint32_t offset = read32();
+            validIndex = validIndex && offset <= dataSize && (lineIndex.empty() || offset >= lineIndex.back());
+            lineIndex.push_back(offset);
+        }
+
+        if (!validIndex || (!lineIndex.empty() && lineIndex.back() != dataSize)) {
+            Log(ERROR, "Image file %s has an invalid line index", path);
+            lineIndex.clear();
+            frameDurations.clear();
+            return false;
+        }
+
+        palette.assign(position, position + paletteSize);
+        position += paletteSize;
+
+        const uint32_t linePixels = imageRotated ? imageHeight : imageWidth;
+        const uint32_t stride = GetFormatStride(static_cast<Format>(format));
+        for (size_t line = 0; line + 1 < lineIndex.size(); line++) {
+            if (!IsValidLine(position + lineIndex[line], lineIndex[line + 1] - lineIndex[line], linePixels, stride)) {
+                Log(ERROR, "Image file %s has an invalid line %d", path, static_cast<int>(line));
+                lineIndex.clear();
+                frameDurations.clear();
+                palette.clear();
+                return false;
+            }
+        }
+
+        if (inPlace) {
+            this->data = const_cast<uint8_t*>(position);
+            this->ownsData = false;
+        } else {
+            this->data = static_cast<uint8_t*>(malloc(dataSize));
+            memcpy(this->data, position, dataSize);
+        }
+
+        this->width = imageWidth;
+        this->height = imageHeight;
+        this->frames = imageFrames;
+        this->format = static_cast<Format>(format);
+        this->rotated = imageRotated;
+
+        return true;
+    }
+
     uint32_t ConvertPixel(const uint8_t* data, Format input, Format output)
     {
         uint32_t color = 0;
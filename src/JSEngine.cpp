@@ -14,10 +14,12 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <grvl/Endian.h>
 #include <grvl/JSEngine.h>
 #include <grvl/JSObjectBuilder.h>
 #include <grvl/Manager.h>
 
+#include <algorithm>
 #include <duktape.h>
 #include <filesystem>
 #include <fstream>
@@ -48,6 +50,69 @@ static void guarded_free(void* udata, void* ptr)
 
 namespace grvl {
 
+    static constexpr char bytecodeMagic[8] = {'g', 'r', 'v', 'l', 'j', 's', 'c', '\0'};
+
+    // Header of a cached script, all fields are stored big endian and followed by the bytecode
+    struct BytecodeHeader {
+        char magic[8];
+        uint32_t engineVersion; // DUK_VERSION of the engine which compiled the script
+        uint32_t sourceSize;
+        uint32_t sourceHashHigh;
+        uint32_t sourceHashLow;
+    };
+
+    static_assert(sizeof(BytecodeHeader) == 24, "Bytecode header has unexpected padding");
+
+    static uint64_t HashSource(const char* code, std::size_t size)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; i++) {
+            hash = (hash ^ static_cast<uint8_t>(code[i])) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Duktape throws on invalid bytecode, or when dumping is not supported, so both are done in safe calls
+    static duk_ret_t LoadFunction(duk_context* ctx, void*)
+    {
+        duk_load_function(ctx);
+        return 1;
+    }
+
+    static duk_ret_t DumpFunction(duk_context* ctx, void*)
+    {
+        duk_dump_function(ctx);
+        return 1;
+    }
+
+    // Deadline of the running script, checked by Duktape when built with DUK_USE_EXEC_TIMEOUT_CHECK
+    static uint32_t executionTimeout = 0;
+    static uint64_t executionDeadline = 0;
+    static uint32_t executionDepth = 0;
+
+    extern "C" int grvl_js_exec_timeout_check(void* udata)
+    {
+        (void) udata;
+        return executionDeadline != 0 && grvl::Callbacks()->get_timestamp() > executionDeadline;
+    }
+
+    // Scripts called while another one runs, e.g. callbacks of a popup it shows, share its deadline
+    struct ExecutionScope {
+        ExecutionScope()
+        {
+            if (executionDepth++ == 0 && executionTimeout != 0) {
+                executionDeadline = grvl::Callbacks()->get_timestamp() + executionTimeout;
+            }
+        }
+
+        ~ExecutionScope()
+        {
+            if (--executionDepth == 0) {
+                executionDeadline = 0;
+            }
+        }
+    };
+
     void JSEngine::Initialize()
     {
         InitializeDukContext();
@@ -64,6 +129,21 @@ namespace grvl {
         duk_push_heap_stash(ctx);
         duk_push_array(ctx);
         duk_put_prop_literal(ctx, -2, STASH_REMEBERED_OBJECTS_KEY);
+        duk_push_array(ctx);
+        duk_put_prop_literal(ctx, -2, STASH_CALLBACKS_KEY);
+        duk_push_object(ctx);
+        duk_put_prop_literal(ctx, -2, STASH_TASKS_KEY);
+        duk_pop(ctx);
+
+        // callbacks resolved in a previous heap are resolved again
+        heapGeneration++;
+        callbackSlotCount = 0;
+        freeCallbackSlots.clear();
+        rememberedObjectCount = 0;
+        freeRememberedObjectSlots.clear();
+        timers.clear();
+        animationFrameTasks.clear();
+        microtasks.clear();
     }
 
     void JSEngine::RegisterBasicAPIFunctions()
@@ -77,6 +157,13 @@ namespace grvl {
         AddGlobalFunction("GetTopPanel", JSEngine::GetTopPanel, 0);
         AddGlobalFunction("GetBottomPanel", JSEngine::GetBottomPanel, 0);
         AddGlobalFunction("GetPrefabById", JSEngine::GetPrefabById, 1);
+        AddGlobalFunction("setTimeout", JSEngine::SetTimeout, 2);
+        AddGlobalFunction("setInterval", JSEngine::SetInterval, 2);
+        AddGlobalFunction("clearTimeout", JSEngine::ClearTask, 1);
+        AddGlobalFunction("clearInterval", JSEngine::ClearTask, 1);
+        AddGlobalFunction("requestAnimationFrame", JSEngine::RequestAnimationFrame, 1);
+        AddGlobalFunction("cancelAnimationFrame", JSEngine::ClearTask, 1);
+        AddGlobalFunction("queueMicrotask", JSEngine::QueueMicrotask, 1);
     }
 
     void JSEngine::AddGlobalFunction(const char* functionName, duk_c_function func, duk_idx_t nargs)
@@ -117,6 +204,9 @@ namespace grvl {
     void JSEngine::Destroy()
     {
         duk_destroy_heap(ctx);
+        ctx = nullptr;
+
+        PruneBytecodeCache();
     }
 
     void JSEngine::SetSourceCodeWorkingDirectory(std::string path)
@@ -124,13 +214,43 @@ namespace grvl {
         sourceCodeWorkingDirectory = std::move(path);
     }
 
+    void JSEngine::SetBytecodeCacheDirectory(std::string path)
+    {
+        bytecodeCacheDirectory = std::move(path);
+        usedBytecode.clear();
+    }
+
+    void JSEngine::PruneBytecodeCache()
+    {
+        // caches in asset bundles aren't directories on the filesystem, they are left as they are
+        std::error_code error;
+        if (bytecodeCacheDirectory.empty() || !std::filesystem::is_directory(bytecodeCacheDirectory, error)) {
+            return;
+        }
+
+        std::vector<std::filesystem::path> stale;
+        for (const auto& entry : std::filesystem::directory_iterator(bytecodeCacheDirectory, error)) {
+            if (entry.path().extension() == ".gjsc"
+                && std::find(usedBytecode.begin(), usedBytecode.end(), entry.path().filename().string()) == usedBytecode.end()) {
+                stale.push_back(entry.path());
+            }
+        }
+
+        for (const auto& path : stale) {
+            if (std::filesystem::remove(path, error)) {
+                Log(INFO, "Removed stale bytecode cache %s", path.c_str());
+            }
+        }
+        usedBytecode.clear();
+    }
+
     bool JSEngine::LoadJavaScriptCode(const std::string& filePath)
     {
         if (filePath.empty()) {
             return true;
         }
 
-        std::string finalPath = sourceCodeWorkingDirectory.append("/").append(filePath);
+        std::string finalPath = sourceCodeWorkingDirectory + "/" + filePath;
         std::vector<char> source = LoadCodeFromFile(finalPath.c_str());
 
         return LoadJavaScriptCode(source.data(), source.size());
@@ -144,8 +264,16 @@ namespace grvl {
 
     bool JSEngine::LoadJavaScriptCode(const char* code, std::size_t codeSize)
     {
+        // scripts may define callback functions anew
+        scriptGeneration++;
+
+        if (!bytecodeCacheDirectory.empty()) {
+            return LoadCachedJavaScriptCode(code, codeSize);
+        }
+
         duk_push_lstring(ctx, code, static_cast<duk_size_t>(codeSize));
 
+        ExecutionScope scope {};
         if (duk_peval(ctx) != 0)
         {
             Log(ERROR, "Error occurred while parsing JavaScript code: %s", duk_safe_to_string(ctx, -1));
@@ -156,6 +284,268 @@ namespace grvl {
         return true;
     }
 
+    bool JSEngine::LoadCachedJavaScriptCode(const char* code, std::size_t codeSize)
+    {
+        const uint64_t hash = HashSource(code, codeSize);
+
+        char name[24];
+        snprintf(name, sizeof(name), "%016llx.gjsc", static_cast<unsigned long long>(hash));
+        const std::string path = bytecodeCacheDirectory + "/" + name;
+        usedBytecode.push_back(name);
+
+        if (!LoadBytecode(path, hash, codeSize)) {
+            if (duk_pcompile_lstring(ctx, 0, code, static_cast<duk_size_t>(codeSize)) != 0) {
+                Log(ERROR, "Error occurred while parsing JavaScript code: %s", duk_safe_to_string(ctx, -1));
+                duk_pop(ctx);
+                return false;
+            }
+
+            SaveBytecode(path, hash, codeSize);
+        }
+
+        ExecutionScope scope {};
+        if (duk_pcall(ctx, 0) != 0) {
+            Log(ERROR, "Error occurred while running JavaScript code: %s", duk_safe_to_string(ctx, -1));
+            duk_pop(ctx);
+            return false;
+        }
+
+        duk_pop(ctx);
+        return true;
+    }
+
+    bool JSEngine::LoadBytecode(const std::string& path, uint64_t hash, std::size_t size)
+    {
+        File file {path.c_str()};
+        if (!file.Exists()) {
+            return false;
+        }
+
+        // bytecode in an asset bundle is used in place
+        std::vector<char> buffer;
+        const uint8_t* data = file.GetMappedData();
+        std::size_t dataSize = file.GetSize();
+        if (!data) {
+            buffer = file.Read();
+            data = reinterpret_cast<const uint8_t*>(buffer.data());
+            dataSize = buffer.size();
+        }
+
+        BytecodeHeader header;
+        if (dataSize <= sizeof(header)) {
+            return false;
+        }
+        memcpy(&header, data, sizeof(header));
+
+        if (memcmp(header.magic, bytecodeMagic, sizeof(header.magic)) != 0
+            || BigEndian32(header.engineVersion) != static_cast<uint32_t>(DUK_VERSION)
+            || BigEndian32(header.sourceSize) != size
+            || BigEndian32(header.sourceHashHigh) != static_cast<uint32_t>(hash >> 32)
+            || BigEndian32(header.sourceHashLow) != static_cast<uint32_t>(hash)) {
+            Log(INFO, "Bytecode cache %s is outdated", path.c_str());
+            return false;
+        }
+
+        // the bytecode is only read while the function is loaded, so it isn't copied to a Duktape buffer
+        duk_push_external_buffer(ctx);
+        duk_config_buffer(ctx, -1, const_cast<uint8_t*>(data + sizeof(header)), dataSize - sizeof(header));
+
+        if (duk_safe_call(ctx, LoadFunction, nullptr, 1, 1) != 0) {
+            Log(WARN, "Unable to load bytecode cache %s: %s", path.c_str(), duk_safe_to_string(ctx, -1));
+            duk_pop(ctx);
+            return false;
+        }
+
+        return true;
+    }
+
+    void JSEngine::SaveBytecode(const std::string& path, uint64_t hash, std::size_t size)
+    {
+        duk_dup(ctx, -1);
+        if (duk_safe_call(ctx, DumpFunction, nullptr, 1, 1) != 0) {
+            Log(WARN, "Unable to dump JavaScript bytecode: %s", duk_safe_to_string(ctx, -1));
+            duk_pop(ctx);
+            return;
+        }
+
+        duk_size_t bytecodeSize = 0;
+        const char* bytecode = static_cast<const char*>(duk_get_buffer(ctx, -1, &bytecodeSize));
+
+        BytecodeHeader header;
+        memcpy(header.magic, bytecodeMagic, sizeof(header.magic));
+        header.engineVersion = BigEndian32(static_cast<uint32_t>(DUK_VERSION));
+        header.sourceSize = BigEndian32(static_cast<uint32_t>(size));
+        header.sourceHashHigh = BigEndian32(static_cast<uint32_t>(hash >> 32));
+        header.sourceHashLow = BigEndian32(static_cast<uint32_t>(hash));
+
+        std::vector<char> data(reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header) + sizeof(header));
+        data.insert(data.end(), bytecode, bytecode + bytecodeSize);
+        duk_pop(ctx);
+
+        File file {path.c_str()};
+        if (!file.Write(data)) {
+            Log(INFO, "Unable to write bytecode cache %s", path.c_str());
+        }
+    }
+
+    void JSEngine::SetFrameBudget(uint32_t microseconds)
+    {
+        frameBudget = static_cast<size_t>(microseconds) * 1000;
+    }
+
+    void JSEngine::ResetFrameBudget()
+    {
+        frameBudgetUsed = 0;
+    }
+
+    void JSEngine::SetExecutionTimeout(uint32_t milliseconds)
+    {
+        executionTimeout = milliseconds;
+    }
+
+    void JSEngine::RunScheduledTasks(uint64_t timestamp)
+    {
+        // microtasks queued by event callbacks
+        RunMicrotasks();
+
+        // timers added by the ones which run are left for the next iteration, even when they are due already
+        size_t dueTimers = std::upper_bound(timers.begin(), timers.end(), timestamp, [](uint64_t timestamp, const Timer& timer) {
+            return timestamp < timer.due;
+        }) - timers.begin();
+
+        for (; dueTimers > 0 && !timers.empty() && IsFrameBudgetLeft(); dueTimers--) {
+            Timer timer = timers.front();
+            timers.erase(timers.begin());
+
+            const bool repeat = timer.interval != 0;
+            if (!PushTask(timer.id, repeat)) {
+                continue;
+            }
+            ExecutePreparedJavaScriptFunctionCall("timer callback", 0);
+
+            // intervals may be cleared by their own callback
+            if (repeat && HasTask(timer.id)) {
+                timer.due = timestamp + timer.interval;
+                InsertTimer(timer);
+            }
+
+            RunMicrotasks();
+        }
+
+        // tasks which didn't fit in the budget run in the next frame
+        if (!microtasks.empty() || (!timers.empty() && timers.front().due <= timestamp)) {
+            Manager::RequestRedraw();
+        } else if (!timers.empty()) {
+            Manager::RequestRedraw(timers.front().due);
+        }
+    }
+
+    void JSEngine::RunAnimationFrameCallbacks(uint64_t timestamp)
+    {
+        std::vector<uint32_t> tasks;
+        tasks.swap(animationFrameTasks);
+
+        size_t done = 0;
+        for (; done < tasks.size() && IsFrameBudgetLeft(); done++) {
+            if (PushTask(tasks[done], false)) {
+                duk_push_number(ctx, static_cast<duk_double_t>(timestamp));
+                ExecutePreparedJavaScriptFunctionCall("animation frame callback", 1);
+            }
+        }
+        RunMicrotasks();
+
+        // callbacks over the budget run before the ones requested in this frame
+        animationFrameTasks.insert(animationFrameTasks.begin(), tasks.begin() + done, tasks.end());
+        if (!animationFrameTasks.empty() || !microtasks.empty()) {
+            Manager::RequestRedraw();
+        }
+    }
+
+    uint32_t JSEngine::AddTask(duk_idx_t functionIdx)
+    {
+        duk_require_function(ctx, functionIdx);
+
+        const uint32_t id = ++taskCount;
+        PushTasksObject(ctx);
+        duk_dup(ctx, functionIdx);
+        duk_put_prop_index(ctx, -2, id);
+        duk_pop(ctx);
+        return id;
+    }
+
+    uint32_t JSEngine::AddTimer(uint32_t delay, bool repeat)
+    {
+        const uint32_t id = AddTask(0);
+
+        // an interval of 0 would run the timer in every iteration, and marks timers which run once
+        const Timer timer {id, grvl::Callbacks()->get_timestamp() + delay, repeat ? std::max(delay, 1u) : 0};
+        InsertTimer(timer);
+        Manager::RequestRedraw(timer.due);
+        return id;
+    }
+
+    void JSEngine::InsertTimer(const Timer& timer)
+    {
+        // timers due at the same time run in the order they were added
+        auto position = std::upper_bound(timers.begin(), timers.end(), timer.due, [](uint64_t due, const Timer& other) {
+            return due < other.due;
+        });
+        timers.insert(position, timer);
+    }
+
+    bool JSEngine::PushTask(uint32_t id, bool keep)
+    {
+        PushTasksObject(ctx);
+        duk_get_prop_index(ctx, -1, id);
+        if (!keep) {
+            duk_del_prop_index(ctx, -2, id);
+        }
+        duk_remove(ctx, -2);
+
+        // cleared tasks are not in the stash anymore
+        if (!duk_is_function(ctx, -1)) {
+            duk_pop(ctx);
+            return false;
+        }
+        return true;
+    }
+
+    bool JSEngine::HasTask(uint32_t id)
+    {
+        PushTasksObject(ctx);
+        const bool found = duk_has_prop_index(ctx, -1, id);
+        duk_pop(ctx);
+        return found;
+    }
+
+    void JSEngine::RemoveTask(uint32_t id)
+    {
+        PushTasksObject(ctx);
+        duk_del_prop_index(ctx, -1, id);
+        duk_pop(ctx);
+
+        timers.erase(std::remove_if(timers.begin(), timers.end(), [id](const Timer& timer) { return timer.id == id; }), timers.end());
+        animationFrameTasks.erase(std::remove(animationFrameTasks.begin(), animationFrameTasks.end(), id), animationFrameTasks.end());
+    }
+
+    void JSEngine::RunMicrotasks()
+    {
+        // microtasks queued by microtasks run as well, as long as the budget allows
+        while (!microtasks.empty() && IsFrameBudgetLeft()) {
+            const uint32_t id = microtasks.front();
+            microtasks.pop_front();
+
+            if (PushTask(id, false)) {
+                ExecutePreparedJavaScriptFunctionCall("microtask", 0);
+            }
+        }
+    }
+
+    bool JSEngine::IsFrameBudgetLeft()
+    {
+        return frameBudget == 0 || frameBudgetUsed < frameBudget;
+    }
+
     void JSEngine::MakeJavaScriptFunctionCall(const char* functionName)
     {
         PrepareJavaScriptFunctionCall(functionName);
@@ -173,12 +563,15 @@ namespace grvl {
     {
         Stopwatch watch {};
 
+        ExecutionScope scope {};
         if (duk_pcall(ctx, numOfArgs) != 0) {
             Log(ERROR, "Error while trying to execute JavaScript function call %s: %s", functionName, duk_safe_to_string(ctx, -1));
         }
         duk_pop(ctx);
 
-        Manager::GetInstance().perf.js_time_this_frame += watch.stop();
+        const size_t time = watch.stop();
+        frameBudgetUsed += time;
+        Manager::GetInstance().perf.js_time_this_frame += time;
     }
 
     void JSEngine::ExecuteJavaScriptCallback(const char* functionName, void* caller, const Event::ArgVector& args)
@@ -205,11 +598,116 @@ namespace grvl {
             return Event{};
         }
 
-        auto callback = [=] (void* caller, const Event::ArgVector&) {
-            ExecuteJavaScriptCallback(functionName.c_str(), caller, args);
-        };
+        auto callback = std::make_shared<Callback>(functionName, args);
+        return Event{[callback] (void* caller, const Event::ArgVector&) {
+            callback->Execute(caller);
+        }};
+    }
+
+    JSEngine::Callback::Callback(std::string functionName, Event::ArgVector args)
+        : functionName{std::move(functionName)}, constantArgs{std::move(args)}
+    {
+    }
 
-        return Event{std::move(callback)};
+    JSEngine::Callback::~Callback()
+    {
+        Release();
+    }
+
+    void JSEngine::Callback::Execute(void* caller, const Event::ArgVector& args)
+    {
+        if (!Resolve()) {
+            Log(ERROR, "Error while trying to execute JavaScript function call %s: not a function", functionName.c_str());
+            return;
+        }
+
+        duk_push_heapptr(ctx, function);
+
+        int numOfArgs = arguments.size() + args.size();
+
+        if (auto callerAsComponent = static_cast<Component*>(caller)) {
+            numOfArgs += 1;
+            callerAsComponent->PushJSObjectOnStack(ctx);
+        }
+
+        for (void* argument : arguments) {
+            duk_push_heapptr(ctx, argument);
+        }
+
+        for (const auto& arg : args) {
+            duk_push_string(ctx, arg.c_str());
+        }
+
+        ExecutePreparedJavaScriptFunctionCall(functionName.c_str(), numOfArgs);
+    }
+
+    bool JSEngine::Callback::Resolve()
+    {
+        if (function && scriptGeneration == JSEngine::scriptGeneration && heapGeneration == JSEngine::heapGeneration) {
+            return true;
+        }
+
+        Release();
+
+        duk_get_global_string(ctx, functionName.c_str());
+        if (!duk_is_function(ctx, -1)) {
+            duk_pop(ctx);
+            return false;
+        }
+
+        if (freeCallbackSlots.empty()) {
+            slot = callbackSlotCount++;
+        } else {
+            slot = freeCallbackSlots.back();
+            freeCallbackSlots.pop_back();
+        }
+
+        // the stashed entry keeps the function and the argument strings reachable, so their heap pointers stay valid
+        PushCallbacksArray(ctx);
+        duk_push_array(ctx);
+        duk_dup(ctx, -3);
+        function = duk_get_heapptr(ctx, -1);
+        duk_put_prop_index(ctx, -2, 0);
+
+        for (std::size_t i = 0; i < constantArgs.size(); i++) {
+            duk_push_lstring(ctx, constantArgs[i].data(), constantArgs[i].size());
+            arguments.push_back(duk_get_heapptr(ctx, -1));
+            duk_put_prop_index(ctx, -2, i + 1);
+        }
+
+        duk_put_prop_index(ctx, -2, slot);
+        duk_pop_2(ctx);
+
+        scriptGeneration = JSEngine::scriptGeneration;
+        heapGeneration = JSEngine::heapGeneration;
+        return true;
+    }
+
+    void JSEngine::Callback::Release()
+    {
+        if (function && ctx && heapGeneration == JSEngine::heapGeneration) {
+            PushCallbacksArray(ctx);
+            duk_del_prop_index(ctx, -1, slot);
+            duk_pop(ctx);
+            freeCallbackSlots.push_back(slot);
+        }
+
+        function = nullptr;
+        arguments.clear();
+    }
+
+    void JSEngine::PushCallbacksArray(duk_context* ctx)
+    {
+        duk_push_heap_stash(ctx);
+        duk_get_prop_literal(ctx, -1, STASH_CALLBACKS_KEY);
+        duk_remove(ctx, -2);
+    }
+
+    void JSEngine::PushTasksObject(duk_context* ctx)
+    {
+        duk_push_heap_stash(ctx);
+        duk_get_prop_literal(ctx, -1, STASH_TASKS_KEY);
+        duk_remove(ctx, -2);
     }
 
     void JSEngine::PushRemeberedObjectsArray(duk_context* ctx)
@@ -219,44 +717,46 @@ namespace grvl {
         duk_remove(ctx, -2);
     }
 
-    void JSEngine::RememberObject(void *objectPtr)
+    duk_uarridx_t JSEngine::RememberObject(void *objectPtr)
     {
-        PushRemeberedObjectsArray(ctx);
-        duk_uarridx_t len = duk_get_length(ctx, -1);
-        duk_uarridx_t idx = lowestMaybeEmptyRememberedObjectIdx;
-        while (idx < len) {
-            if (!duk_has_prop_index(ctx, -1, idx)) break;
-            idx += 1;
+        duk_uarridx_t slot;
+        if (freeRememberedObjectSlots.empty()) {
+            slot = rememberedObjectCount++;
+        } else {
+            slot = freeRememberedObjectSlots.back();
+            freeRememberedObjectSlots.pop_back();
         }
-        lowestMaybeEmptyRememberedObjectIdx = idx + 1;
+
+        PushRemeberedObjectsArray(ctx);
         duk_push_heapptr(ctx, objectPtr);
-        duk_put_prop_index(ctx, -2, idx);
+        duk_put_prop_index(ctx, -2, slot);
         duk_pop(ctx);
+        return slot;
     }
 
-    void JSEngine::ForgetObject(void *objectPtr)
+    void JSEngine::ForgetObject(duk_uarridx_t slot, uint32_t heapGeneration)
     {
-        PushRemeberedObjectsArray(ctx);
-        duk_uarridx_t len = duk_get_length(ctx, -1);
-        duk_uarridx_t idx = 0;
-        for (; idx < len; duk_pop(ctx), idx += 1) {
-            if (!duk_get_prop_index(ctx, -1, idx)) {
-                continue;
-            }
-            if (duk_get_heapptr(ctx, -1) != objectPtr) {
-                continue;
-            }
-            duk_pop(ctx);
-            break;
-        }
-        if (idx == len) {
-            // Object was already forgotten?
+        // objects of a destroyed heap are gone already, and their slots may be in use in the current one
+        if (!ctx || heapGeneration != JSEngine::heapGeneration) {
             return;
         }
-        duk_del_prop_index(ctx, -1, idx);
-        if (idx < lowestMaybeEmptyRememberedObjectIdx) {
-            lowestMaybeEmptyRememberedObjectIdx = idx;
-        }
+
+        PushRemeberedObjectsArray(ctx);
+        duk_del_prop_index(ctx, -1, slot);
+        duk_pop(ctx);
+        freeRememberedObjectSlots.push_back(slot);
+    }
+
+    uint32_t JSEngine::GetHeapGeneration()
+    {
+        return heapGeneration;
+    }
+
+    void JSEngine::RetargetObject(void *objectPtr, Component* component)
+    {
+        duk_push_heapptr(ctx, objectPtr);
+        duk_push_pointer(ctx, component);
+        duk_put_prop_string(ctx, -2, JSObject::C_OBJECT_POINTER_KEY);
         duk_pop(ctx);
     }
 
@@ -352,4 +852,46 @@ namespace grvl {
         return RETURN_VALUE_PRESENT;
     }
 
+    duk_ret_t JSEngine::SetTimeout(duk_context* ctx)
+    {
+        duk_push_uint(ctx, AddTimer(duk_to_uint32(ctx, 1), false));
+
+        return RETURN_VALUE_PRESENT;
+    }
+
+    duk_ret_t JSEngine::SetInterval(duk_context* ctx)
+    {
+        duk_push_uint(ctx, AddTimer(duk_to_uint32(ctx, 1), true));
+
+        return RETURN_VALUE_PRESENT;
+    }
+
+    duk_ret_t JSEngine::ClearTask(duk_context* ctx)
+    {
+        // timers, intervals and animation frame callbacks share the ids, so one function clears all of them
+        const duk_uint32_t id = duk_to_uint32(ctx, 0);
+        if (id != 0) {
+            RemoveTask(id);
+        }
+
+        return NO_RETURN_VALUE;
+    }
+
+    duk_ret_t JSEngine::RequestAnimationFrame(duk_context* ctx)
+    {
+        const uint32_t id = AddTask(0);
+        animationFrameTasks.push_back(id);
+        Manager::RequestRedraw();
+        duk_push_uint(ctx, id);
+
+        return RETURN_VALUE_PRESENT;
+    }
+
+    duk_ret_t JSEngine::QueueMicrotask(duk_context* ctx)
+    {
+        microtasks.push_back(AddTask(0));
+
+        return NO_RETURN_VALUE;
+    }
+
 } /* namespace grvl */
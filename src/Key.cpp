@@ -52,7 +52,7 @@ namespace grvl {
     Key::KeyState Key::TriggerOnPressEvent()
     {
         if(onPress.IsSet()) {
-            Manager::GetInstance().GetEventsQueueInstance().push(&onPress);
+            Manager::GetInstance().QueueEvent(&onPress);
             return Key::KeyReleased;
         }
         return Key::NA;
@@ -61,7 +61,7 @@ namespace grvl {
     Key::KeyState Key::TriggerOnReleaseEvent()
     {
         if(onRelease.IsSet()) {
-            Manager::GetInstance().GetEventsQueueInstance().push(&onRelease);
+            Manager::GetInstance().QueueEvent(&onRelease);
             return Key::KeyReleased;
         }
         return Key::NA;
@@ -70,7 +70,7 @@ namespace grvl {
     Key::KeyState Key::TriggerOnLongPressEvent()
     {
         if(onLongPress.IsSet()) {
-            Manager::GetInstance().GetEventsQueueInstance().push(&onLongPress);
+            Manager::GetInstance().QueueEvent(&onLongPress);
             return Key::KeyReleased;
         }
         return Key::NA;
@@ -79,7 +79,7 @@ namespace grvl {
     Key::KeyState Key::TriggerOnLongPressRepeatEvent()
     {
         if(onLongPressRepeat.IsSet()) {
-            Manager::GetInstance().GetEventsQueueInstance().push(&onLongPressRepeat);
+            Manager::GetInstance().QueueEvent(&onLongPressRepeat);
             return Key::KeyReleased;
         }
         return Key::NA;
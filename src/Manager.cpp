@@ -17,10 +17,12 @@
 #include <grvl/JSEngine.h>
 #include <grvl/Manager.h>
 #include <grvl/ParsingUtils.h>
+#include <grvl/Scene.h>
 
 #include <cassert>
 #include <iomanip>
 #include <sstream>
+#include <typeinfo>
 #include <grvl/JSEngine.h>
 #include <grvl/File.h>
 
@@ -110,6 +112,92 @@ namespace grvl {
         man->SwitchKeyboardKeys();
     }
 
+    // Attributes of the element, including the ones set by the stylesheet, sorted by name
+    static Stylesheet::PropertyBlock GetEffectiveAttributes(const XMLElement* element, const Stylesheet& stylesheet)
+    {
+        Stylesheet::PropertyBlock attributes;
+        for(const XMLAttribute* attribute = element->FirstAttribute(); attribute; attribute = attribute->Next()) {
+            attributes.push_back({attribute->Name(), attribute->Value()});
+        }
+
+        for(const Stylesheet::Property& property : stylesheet.Resolve(element)) {
+            if(!element->Attribute(property.name)) {
+                attributes.push_back(property);
+            }
+        }
+
+        std::sort(attributes.begin(), attributes.end(), [](const Stylesheet::Property& a, const Stylesheet::Property& b) {
+            return strcmp(a.name, b.name) < 0;
+        });
+        return attributes;
+    }
+
+    static bool HasSameAttributes(const XMLElement* previous, const Stylesheet& previousStylesheet, const XMLElement* next, const Stylesheet& nextStylesheet)
+    {
+        const char* previousText = previous->GetText();
+        const char* nextText = next->GetText();
+        if(strcmp(previous->Value(), next->Value()) != 0 || strcmp(previousText ? previousText : "", nextText ? nextText : "") != 0) {
+            return false;
+        }
+
+        const Stylesheet::PropertyBlock previousAttributes = GetEffectiveAttributes(previous, previousStylesheet);
+        const Stylesheet::PropertyBlock nextAttributes = GetEffectiveAttributes(next, nextStylesheet);
+        if(previousAttributes.size() != nextAttributes.size()) {
+            return false;
+        }
+
+        for(size_t i = 0; i < previousAttributes.size(); i++) {
+            if(strcmp(previousAttributes[i].name, nextAttributes[i].name) != 0 || strcmp(previousAttributes[i].value, nextAttributes[i].value) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool HasSameTree(const XMLElement* previous, const Stylesheet& previousStylesheet, const XMLElement* next, const Stylesheet& nextStylesheet)
+    {
+        if(!HasSameAttributes(previous, previousStylesheet, next, nextStylesheet)) {
+            return false;
+        }
+
+        const XMLElement* previousChild = previous->FirstChildElement();
+        const XMLElement* nextChild = next->FirstChildElement();
+        for(; previousChild && nextChild; previousChild = previousChild->NextSiblingElement(), nextChild = nextChild->NextSiblingElement()) {
+            if(!HasSameTree(previousChild, previousStylesheet, nextChild, nextStylesheet)) {
+                return false;
+            }
+        }
+        return !previousChild && !nextChild;
+    }
+
+    static XMLElement* FindChildById(XMLNode* parent, const char* name, const char* id)
+    {
+        for(XMLElement* child = parent->FirstChildElement(name); child; child = child->NextSiblingElement(name)) {
+            const char* childId = child->Attribute("id");
+            if(childId && strcmp(childId, id) == 0) {
+                return child;
+            }
+        }
+        return nullptr;
+    }
+
+    // Finds an unused element of the same type and id, elements without an id are matched in their order
+    static int32_t FindMatchingElement(const std::vector<XMLElement*>& elements, const std::vector<bool>& used, const XMLElement* element)
+    {
+        const char* id = element->Attribute("id");
+        for(size_t i = 0; i < elements.size(); i++) {
+            if(used[i] || strcmp(elements[i]->Value(), element->Value()) != 0) {
+                continue;
+            }
+
+            const char* otherId = elements[i]->Attribute("id");
+            if((!id && !otherId) || (id && otherId && strcmp(id, otherId) == 0)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
     static void ChangeScreenCallback(void* sender, const Event::ArgVector& Args)
     {
         int8_t screen_animation = 0;
@@ -186,6 +274,8 @@ namespace grvl {
         static constexpr auto defaultBGColor = 0xFF000000;
         painter.SetBackgroundColor(defaultBGColor);
 
+        frameScheduler.RequestFrame();
+
         AddCallbackToContainer("ChangeScreen", ChangeScreenCallback);
         AddCallbackToContainer("ClosePopup", ClosePopupCallback);
         AddCallbackToContainer("ShowKeyboard", ShowKeyboardCallback);
@@ -200,6 +290,21 @@ namespace grvl {
         return eventsQueue;
     }
 
+    void Manager::QueueEvent(Event* event)
+    {
+        // once the queue overflows, the following events go to the list too, so they are triggered in order
+        if(!eventsOverflowed.load(std::memory_order_acquire) && eventsQueue.push(event)) {
+            return;
+        }
+
+        Guard lock {overflowEventsMutex};
+        if(overflowEvents.empty()) {
+            Log(WARN, "Event queue is full, events wait in a list until the main loop drains it.");
+        }
+        overflowEvents.push_back(event);
+        eventsOverflowed.store(true, std::memory_order_release);
+    }
+
     uint32_t Manager::GetWidth() const
     {
         return width;
@@ -227,6 +332,7 @@ namespace grvl {
             } else {
                 fadeEndTimestamp = fadeBeginTimestamp + milliseconds;
             }
+            RequestRedraw();
         }
         return *this;
     }
@@ -255,11 +361,13 @@ namespace grvl {
 
     std::vector<AbstractView*>& Manager::GetScreensCollection()
     {
+        BuildPendingScreens();
         return Screens;
     }
 
     AbstractView* Manager::GetLastScreen()
     {
+        BuildPendingScreens();
         return Screens.back();
     }
 
@@ -270,6 +378,18 @@ namespace grvl {
         return *this;
     }
 
+    Manager& Manager::SetLayoutReloading(bool enabled)
+    {
+        layoutReloading = enabled;
+        return *this;
+    }
+
+    Manager& Manager::SetLazyScreenLoading(bool enabled)
+    {
+        lazyScreenLoading = enabled;
+        return *this;
+    }
+
     Manager& Manager::AddPopup(Popup* popup)
     {
         if(popup) {
@@ -280,33 +400,29 @@ namespace grvl {
 
     Manager& Manager::SetActiveScreen(const char* activeScreenId, int8_t direction)
     {
-        if(!Screens.empty()) {
-            AbstractView* NewScreen;
-
-            for(uint32_t i = 0; i < Screens.size(); i++) {
-                if(strcmp(Screens[i]->GetID(), activeScreenId) == 0) {
-                    if(ActiveScreen) {
-                        ActiveScreen->ClearTouch();
-                        ActiveScreen->PrepareToClose();
-                    }
+        // builds the screen if it is still kept as XML
+        AbstractView* NewScreen = GetScreen(activeScreenId);
+        if(NewScreen) {
+            if(ActiveScreen) {
+                ActiveScreen->ClearTouch();
+                ActiveScreen->PrepareToClose();
+            }
 
-                    NewScreen = Screens[i];
-                    NewScreen->PrepareToOpen();
+            NewScreen->PrepareToOpen();
 
-                    Screens[i]->CheckPlacement();
-                    if(direction != 0 && ScrollingDuration > 0) {
-                        Animate(ActiveScreen, NewScreen, direction);
-                    } else {
-                        ActiveScreen = NewScreen;
+            NewScreen->CheckPlacement();
+            RequestRedraw();
+            if(direction != 0 && ScrollingDuration > 0) {
+                Animate(ActiveScreen, NewScreen, direction);
+            } else {
+                ActiveScreen = NewScreen;
 
-                        // In case of animation this happens after the animation ends
-                        if(TopPanel) {
-                            TopPanel->SetVisible(ActiveScreen->GetGlobalPanelVisibility());
-                        }
-                    }
-                    return *this;
+                // In case of animation this happens after the animation ends
+                if(TopPanel) {
+                    TopPanel->SetVisible(ActiveScreen->GetGlobalPanelVisibility());
                 }
             }
+            return *this;
         }
         Log(ERROR, "Screen \"%s\" does not exist!", activeScreenId);
         return *this;
@@ -371,6 +487,24 @@ namespace grvl {
                                   (uint32_t)targetHeadersHeight, (uint32_t)targetScreen->GetBackgroundColor());
         }
 
+        if(ManagerState == CrossFade && BackgroundImage.GetContent()) {
+            // Blending is done between opaque snapshots, put the background under both screens once
+            uint8_t bytesPerPixel = painter.GetBytesPerPixel();
+            uint8_t backgroundBytesPerPixel = BackgroundImage.GetContentBytesPerPixel();
+            uintptr_t clt = BackgroundImage.GetContent()->GetColorPalette();
+            uint32_t screenHeight = height - GetTotalHeadersHeight() - GetBottomPanelHeight();
+            bool rotated = painter.IsRotated();
+            uint32_t offset = rotated ? GetTotalHeadersHeight() + GetBottomPanelHeight() : 0;
+            uint32_t firstPixel = rotated ? GetTotalHeadersHeight() : width * GetTotalHeadersHeight();
+
+            for(int buffer = 0; buffer < 2; buffer++) {
+                uintptr_t snapshot = painter.GetBuffer(buffer) + bytesPerPixel * firstPixel;
+                painter.DmaOperationCLT(snapshot, (uintptr_t)(BackgroundImage.GetContentData() + backgroundBytesPerPixel * firstPixel), snapshot,
+                                        rotated ? screenHeight : width, rotated ? width : screenHeight, offset, offset, offset,
+                                        painter.GetPixelFormat(), BackgroundImage.GetContentColorFormat(), painter.GetPixelFormat(), clt, 0);
+            }
+        }
+
         BeginTimestamp = grvl::Callbacks()->get_timestamp();
     }
 
@@ -461,6 +595,68 @@ namespace grvl {
         return *this;
     }
 
+    Manager& Manager::AddImageAtlasToContainer(const std::string& name, ImageContent* image, const ContentManager::AtlasRegions& regions)
+    {
+        if(painter.IsRotated())
+            if(!image->IsRotated())
+                image->Rotate90();
+
+        contentManager.RegisterAtlas(name, image, regions);
+
+        return *this;
+    }
+
+    int32_t Manager::LoadImageAtlas(const std::string& name, const char* manifestPath, Format format)
+    {
+        File file(manifestPath);
+        const std::string manifest = file.ReadString();
+        if(manifest.empty()) {
+            Log(ERROR, "Unable to load atlas manifest %s", manifestPath);
+            return -1;
+        }
+
+        XMLDocument doc;
+        XMLElement* atlas = nullptr;
+        if(doc.Parse(manifest.c_str(), manifest.length()) != XML_SUCCESS || !(atlas = doc.FirstChildElement("atlas"))) {
+            Log(ERROR, "Atlas manifest %s is invalid", manifestPath);
+            return -1;
+        }
+
+        const char* imageName = atlas->Attribute("image");
+        if(!imageName) {
+            Log(ERROR, "Atlas manifest %s does not name an image", manifestPath);
+            return -1;
+        }
+
+        std::string imagePath = imageName;
+        const std::string manifestDirectory = manifestPath;
+        const size_t directoryEnd = manifestDirectory.rfind('/');
+        if(imagePath[0] != '/' && directoryEnd != std::string::npos) {
+            imagePath = manifestDirectory.substr(0, directoryEnd + 1) + imagePath;
+        }
+
+        ImageContent* image = new ImageContent(imagePath.c_str(), format);
+        if(image->IsEmpty()) {
+            Log(ERROR, "Unable to load atlas image %s", imagePath.c_str());
+            delete image;
+            return -1;
+        }
+
+        ContentManager::AtlasRegions regions;
+        for(XMLElement* region = atlas->FirstChildElement("region"); region; region = region->NextSiblingElement("region")) {
+            const char* regionName = region->Attribute("name");
+            if(!regionName) {
+                continue;
+            }
+            regions[regionName] = {
+                region->IntAttribute("x"), region->IntAttribute("y"),
+                region->IntAttribute("width"), region->IntAttribute("height")};
+        }
+
+        AddImageAtlasToContainer(name, image, regions);
+        return 0;
+    }
+
     Manager& Manager::BindImageContentToImage(const std::string& contentName, Image* image)
     {
         image->ReplaceDelegate(contentManager.RequestImage(contentName));
@@ -499,6 +695,22 @@ namespace grvl {
         return GetOrCreateCallback(callbackDefinition.functionName, callbackDefinition.args);
     }
 
+    Event::CallbackFunction Manager::GetOrCreateCallbackFunction(const std::string& callbackFunctionName)
+    {
+        if (callbackFunctionName.empty()) {
+            return {};
+        }
+
+        if (Event::CallbackPointer foundCallback = GetCallbackFromContainer(callbackFunctionName)) {
+            return foundCallback;
+        }
+
+        auto callback = std::make_shared<JSEngine::Callback>(callbackFunctionName);
+        return [callback] (void* caller, const Event::ArgVector& args) {
+            callback->Execute(caller, args);
+        };
+    }
+
     int8_t Manager::IsInitializationFinished()
     {
         return ManagerState != Loading;
@@ -586,16 +798,23 @@ namespace grvl {
     {
         AbstractView* Screen = NULL;
         for(uint32_t i = 0; i < Screens.size(); i++) {
-            if(strcmp(Screens[i]->GetID(), id) == 0) {
+            if(Screens[i] && strcmp(Screens[i]->GetID(), id) == 0) {
                 Screen = Screens[i];
                 break;
             }
         }
+
+        for(size_t i = 0; !Screen && i < pendingScreens.size(); i++) {
+            if(strcmp(pendingScreens[i].element->Attribute("id"), id) == 0) {
+                return BuildPendingScreen(i);
+            }
+        }
         return Screen;
     }
 
     AbstractView* Manager::GetScreen(int id)
     {
+        BuildPendingScreens();
         if((int)Screens.size() > id) {
             return Screens[id];
         }
@@ -823,21 +1042,37 @@ namespace grvl {
                 DrawNextLoadingFrame();
                 ApplyTransparency();
                 painter.FlipSynchronizeBuffers();
+                RequestRedraw(grvl::Callbacks()->get_timestamp());
                 return;
                 break;
             }
             case CrossFade: {
-                if(UpdateAnimationWindowOffset()) {
-                    // TODO: do the actual blending.
+                UpdateAnimationWindowOffset();
+
+                // Both screens were rendered once when the animation started, so every frame is a single blend
+                static constexpr auto opaque = 0xff;
+                uint8_t alpha = opaque - (AnimationWindowOffset * opaque) / (int32_t)width;
+                uint8_t bytesPerPixel = painter.GetBytesPerPixel();
+                uint8_t displayBytesPerPixel = painter.GetDisplayBytesPerPixel();
+                uint32_t screenHeight = height - GetTotalHeadersHeight() - GetBottomPanelHeight();
+
+                if(painter.IsRotated()) {
+                    uint32_t offset = GetTotalHeadersHeight() + GetBottomPanelHeight();
+                    painter.DmaBlend(painter.GetBuffer(1) + bytesPerPixel * GetTotalHeadersHeight(),
+                                     painter.GetBuffer(0) + bytesPerPixel * GetTotalHeadersHeight(),
+                                     painter.GetVisibleBuffer() + displayBytesPerPixel * GetTotalHeadersHeight(),
+                                     screenHeight, width, offset, offset, offset,
+                                     painter.GetPixelFormat(), painter.GetPixelFormat(), painter.GetDisplayPixelFormat(), alpha);
+                } else {
+                    painter.DmaBlend(painter.GetBuffer(1) + bytesPerPixel * width * GetTotalHeadersHeight(),
+                                     painter.GetBuffer(0) + bytesPerPixel * width * GetTotalHeadersHeight(),
+                                     painter.GetVisibleBuffer() + displayBytesPerPixel * width * GetTotalHeadersHeight(),
+                                     width, screenHeight, 0, 0, 0,
+                                     painter.GetPixelFormat(), painter.GetPixelFormat(), painter.GetDisplayPixelFormat(), alpha);
                 }
+
                 if(AnimationWindowOffset <= 0) {
-                    ActiveScreen = TargetScreen;
-                    if(TopPanel) {
-                        TopPanel->SetVisible(ActiveScreen->GetGlobalPanelVisibility());
-                    }
-                    ManagerState = Refreshing;
-                    grvl::Callbacks()->set_layer_pointer(painter.GetBuffer(2));
-                    painter.FillRectangle(0, 0, width, height, COLOR_ARGB8888_TRANSPARENT);
+                    FinishTransition();
                 }
                 break;
             }
@@ -897,11 +1132,8 @@ namespace grvl {
                     }
                 }
                 if(AnimationWindowOffset <= 0) {
-                    ActiveScreen = TargetScreen;
-                    if(TopPanel) {
-                        TopPanel->SetVisible(ActiveScreen->GetGlobalPanelVisibility());
-                    }
-                    ManagerState = Refreshing;
+                    FinishTransition();
+                    RequestRedraw(grvl::Callbacks()->get_timestamp());
                     return;
                 }
                 break;
@@ -974,6 +1206,12 @@ namespace grvl {
             uint8_t alpha = maxAlpha - ((float)(grvl::Callbacks()->get_timestamp() - PointerTimestamp) / touchDelay) * maxAlpha;
             painter.FillCircle(TouchEvent.GetCurrentX(), TouchEvent.GetCurrentY(), 5, //NOLINT
                                alpha << 24 | (0x00FFFFFF & COLOR_ARGB8888_RED)); //NOLINT
+            RequestRedraw(grvl::Callbacks()->get_timestamp()); // fade out the dot
+        }
+
+        // transitions and fading are drawn frame by frame
+        if(ManagerState != Refreshing || currentTransparency != desiredTransparency) {
+            RequestRedraw(grvl::Callbacks()->get_timestamp());
         }
 
         painter.FlipSynchronizeBuffers();
@@ -1014,6 +1252,7 @@ namespace grvl {
         painter.DrawString(font, 4, 60, "D: " + ftos(draw_ns * ns_to_ms, 4) + "ms", fg, bg); // main drawing
         painter.DrawString(font, 4, 80, "S: " + ftos(swap_ns * ns_to_ms, 4) + "ms", fg, bg); // time spent between MainLoopIteration() calls (includes Swaping time)
         painter.DrawString(font, 4, 100, "T: " + ftos((script_ns + draw_ns + swap_ns) * ns_to_ms, 4) + "ms", fg, bg); // total time spent per frame
+        painter.DrawString(font, 4, 120, "M: " + std::to_string(perf.missed_deadlines), fg, bg); // frames started later than scheduled
 
     }
 
@@ -1108,6 +1347,10 @@ namespace grvl {
 
     void Manager::ProcessTouchPoint(bool touched, uint32_t touchX, uint32_t touchY)
     {
+        if(previousTouchState || touched) {
+            frameScheduler.RequestFrame();
+        }
+
         if(!previousTouchState && !touched) { // Idle
             TouchEvent.SetState(Touch::Idle);
         } else if(previousTouchState && touched) { // Moving
@@ -1162,6 +1405,8 @@ namespace grvl {
             return;
         }
 
+        frameScheduler.RequestFrame();
+
         if(pressed && !keyActive) { // Press
             KeyMappingMap::const_iterator searchKey = KeyMappingContainer.find(code);
             if(searchKey != KeyMappingContainer.end() && activeKey.name != searchKey->second.name) {
@@ -1196,12 +1441,33 @@ namespace grvl {
             return;
         }
 
+        frameScheduler.RequestFrame();
+
         size_t len = strlen(text);
         for (int i = 0; i < len; i++) {
             activeInput->AddCharacter(text[i]);
         }
     }
 
+    void Manager::FinishTransition()
+    {
+        if(ManagerState != ToTheRight && ManagerState != ToTheLeft && ManagerState != CrossFade) {
+            return;
+        }
+
+        ActiveScreen = TargetScreen;
+        TargetScreen = NULL;
+        if(TopPanel) {
+            TopPanel->SetVisible(ActiveScreen->GetGlobalPanelVisibility());
+        }
+
+        if(ManagerState == CrossFade) {
+            grvl::Callbacks()->set_layer_pointer(painter.GetBuffer(2));
+            painter.FillRectangle(0, 0, width, height, COLOR_ARGB8888_TRANSPARENT);
+        }
+        ManagerState = Refreshing;
+    }
+
     bool Manager::UpdateAnimationWindowOffset()
     {
         int32_t originalAnimationWindowOffset = AnimationWindowOffset;
@@ -1257,39 +1523,6 @@ namespace grvl {
             nextElement = nextElement->NextSiblingElement("key");
         }
     }
-    // NOLINTBEGIN
-    void Manager::ParseStyle(char* active_object, char* active_parameter, char* active_parameter_value)
-    {
-        char aobject[255];
-        int type = 0;
-        if(active_object[0] == '.')
-            type = 1;
-        if(active_object[0] == '#')
-            type = 2;
-        memmove(aobject, active_object + ((type > 0) ? 1 : 0), strlen(active_object) + ((type > 0) ? 0 : 1));
-
-        std::string key(aobject);
-        key.append("+");
-        key.append(active_parameter);
-
-        size_t value_len = strlen(active_parameter_value) + 1;
-        char* value = (char*)malloc(value_len);
-        strncpy(value, active_parameter_value, value_len);
-
-        switch(type) {
-            case 0:
-                widgetAttributes[key] = value;
-                break;
-            case 1:
-                classAttributes[key] = value;
-                break;
-            case 2:
-                idAttributes[key] = value;
-                break;
-        }
-        // TODO: actually add this style to a list, and interpret those.
-    }
-
     void Manager::ParseFontStyles(XMLElement* styles)
     {
         if(!styles)
@@ -1314,79 +1547,13 @@ namespace grvl {
         }
     }
 
-    void Manager::ParseStylesheet(XMLElement* stylesheet)
+    void Manager::ParseStylesheet(XMLElement* stylesheetElement)
     {
-        if(!stylesheet)
-            return;
-        char* data = (char*)stylesheet->GetText();
-        if(!data)
+        if(!stylesheetElement)
             return;
 
-        size_t SIZE = 255;
-
-        char active_object[SIZE];
-        char active_parameter[SIZE];
-        char active_parameter_value[SIZE];
-        char active[SIZE];
-        int count = 0;
-        int level = 0;
-
-        while(data[0] != 0x0) {
-            switch(data[0]) {
-                case '{': {
-                    if(level != 0)
-                        break;
-                    strncpy(active_object, active, SIZE);
-                    count = 0;
-                    level++;
-                    break;
-                }
-                case ':': {
-                    if(level != 1)
-                        break;
-                    strncpy(active_parameter, active, SIZE);
-                    count = 0;
-                    level++;
-                    break;
-                }
-                case ';': {
-                    if(level == 2) {
-                        level--;
-                        strncpy(active_parameter_value, active, SIZE);
-                        ParseStyle(active_object, active_parameter, active_parameter_value);
-                    }
-                    count = 0;
-                    break;
-                }
-                case '}': {
-                    if(level == 2) {
-                        level--;
-                        strncpy(active_parameter_value, active, SIZE);
-                        ParseStyle(active_object, active_parameter, active_parameter_value);
-                    }
-                    if(level != 1)
-                        break;
-                    level--;
-                    count = 0;
-                    break;
-                }
-                case ' ':
-                case '\n':
-                case '\t': {
-                    count = 0;
-                    break;
-                }
-                default: {
-                    active[count++] = data[0];
-                    if(count > SIZE)
-                        return;
-                    active[count] = 0;
-                }
-            }
-            data++;
-        }
+        stylesheet.Parse(stylesheetElement->GetText());
     }
-    // NOLINTEND
 
     int32_t Manager::BuildFromXMLString(const std::string& document)
     {
@@ -1394,111 +1561,683 @@ namespace grvl {
             return -1; // Parsing failed
         }
 
-        XMLDocument doc;
+        std::unique_ptr<XMLDocument> doc(new XMLDocument());
 
-        XMLError Error = doc.Parse(document.c_str(), document.length());
+        XMLError Error = doc->Parse(document.c_str(), document.length());
 
-        if(Error == XML_SUCCESS) {
-            XMLNode* Root = doc.LastChild();
+        if(Error != XML_SUCCESS) { // Parsing failed
+            Log(ERROR, "XML parsing failed.");
+            doc->Clear();
+            return -1;
+        }
 
-            // Adding screens
-            if(Root) {
+        const size_t previouslyPending = pendingScreens.size();
+        BuildFromDocument(doc->LastChild());
+        Log(INFO, "Parsing done.");
+        KeepScreenDocument(std::move(doc), previouslyPending);
+        if(GetScreen("start"))
+            SetActiveScreen("start", 0);
+        return 0;
+    }
 
-                XMLElement* nextElement = Root->FirstChildElement("guiConfig");
-                if(nextElement) {
-                    ParseGuiConfiguration(nextElement);
-                }
+    int32_t Manager::ReloadFromXML(const char* filename)
+    {
+        File file(filename);
+        return ReloadFromXMLString(file.ReadString());
+    }
 
-                nextElement = Root->FirstChildElement("stylesheet");
-                if(nextElement) {
-                    ParseStylesheet(nextElement);
-                }
+    int32_t Manager::ReloadFromXMLString(const std::string& document)
+    {
+        if(!layoutDocument) {
+            Log(WARN, "No layout to reload, building all screens again.");
+            ResetScreens();
+            return BuildFromXMLString(document);
+        }
 
-                nextElement = Root->FirstChildElement("font-styles");
-                if (nextElement) {
-                    ParseFontStyles(nextElement);
-                }
+        if(document.empty()) {
+            return -1; // Parsing failed
+        }
 
-                for(nextElement = Root->FirstChildElement("script"); nextElement != nullptr; nextElement = nextElement->NextSiblingElement("script")) {
-                    ParseScripts(nextElement);
-                }
+        // the callback's sender and the components of the remaining events may be replaced
+        if(processingEvents) {
+            pendingLayout = document;
+            return 0;
+        }
 
-                nextElement = Root->FirstChildElement("keypadMapping");
-                if(nextElement) {
-                    ParseKeypadMapping(nextElement);
-                }
+        assert((!eventsProcessed || pthread_equal(eventsThread, pthread_self())) && "Layout must be reloaded by the main loop thread");
 
-                nextElement = Root->FirstChildElement("keyboard");
-                if(nextElement) {
-                    keyboard = Keyboard::BuildFromXML(nextElement);
-                }
+        std::unique_ptr<XMLDocument> doc(new XMLDocument());
 
-                nextElement = Root->FirstChildElement("header");
-                if(nextElement) {
-                    TopPanel = Panel::BuildFromXML(nextElement);
+        XMLError Error = doc->Parse(document.c_str(), document.length());
+
+        if(Error != XML_SUCCESS || !doc->LastChild()) { // Parsing failed
+            Log(ERROR, "XML parsing failed.");
+            doc->Clear();
+            return -1;
+        }
+
+        // queued events refer to components which may be replaced
+        ProcessEvents();
+
+        // screens drawn by a transition may be replaced, it's finished with the current ones
+        FinishTransition();
+
+        Stylesheet previousStylesheet(std::move(stylesheet));
+        stylesheet.Clear();
+        {
+            Stylesheet::Scope stylesheetScope(stylesheet);
+            ParseStylesheet(doc->LastChild()->FirstChildElement("stylesheet"));
+            ReloadLayout(layoutDocument->LastChild(), previousStylesheet, doc->LastChild());
+        }
+
+        Log(INFO, "Reloading done.");
+        layoutDocument = std::move(doc);
+        RequestRedraw();
+        return 0;
+    }
+
+    int32_t Manager::BuildFromScene(const char* filename)
+    {
+        File file(filename);
+
+        // scenes in a bundle are used in place, without a copy
+        if(const uint8_t* mapped = file.GetMappedData()) {
+            return BuildFromSceneData(mapped, file.GetSize());
+        }
+
+        const std::vector<char> data = file.Read();
+        return BuildFromSceneData(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    }
+
+    int32_t Manager::BuildFromSceneData(const uint8_t* data, size_t size)
+    {
+        Scene scene(data, size);
+        std::unique_ptr<XMLDocument> doc(new XMLDocument());
+
+        XMLElement* Root = scene.Load(*doc);
+        if(!Root) {
+            Log(ERROR, "Scene loading failed.");
+            return -1;
+        }
+
+        const size_t previouslyPending = pendingScreens.size();
+        BuildFromDocument(Root);
+        Log(INFO, "Scene loading done.");
+        KeepScreenDocument(std::move(doc), previouslyPending);
+        if(GetScreen("start"))
+            SetActiveScreen("start", 0);
+        return 0;
+    }
+
+    void Manager::BuildFromDocument(XMLNode* Root)
+    {
+        // the stylesheet rules of every element are merged once, while the document is alive
+        Stylesheet::Scope stylesheetScope(stylesheet);
+
+        // Adding screens
+        if(Root) {
+
+            XMLElement* nextElement = Root->FirstChildElement("guiConfig");
+            if(nextElement) {
+                ParseGuiConfiguration(nextElement);
+            }
+
+            nextElement = Root->FirstChildElement("stylesheet");
+            if(nextElement) {
+                ParseStylesheet(nextElement);
+            }
+
+            nextElement = Root->FirstChildElement("font-styles");
+            if (nextElement) {
+                ParseFontStyles(nextElement);
+            }
+
+            for(nextElement = Root->FirstChildElement("script"); nextElement != nullptr; nextElement = nextElement->NextSiblingElement("script")) {
+                ParseScripts(nextElement);
+            }
+
+            nextElement = Root->FirstChildElement("keypadMapping");
+            if(nextElement) {
+                ParseKeypadMapping(nextElement);
+            }
+
+            nextElement = Root->FirstChildElement("keyboard");
+            if(nextElement) {
+                keyboard = Keyboard::BuildFromXML(nextElement);
+            }
+
+            nextElement = Root->FirstChildElement("header");
+            if(nextElement) {
+                TopPanel = Panel::BuildFromXML(nextElement);
+            }
+
+            nextElement = Root->FirstChildElement("footer");
+            if(nextElement) {
+                BottomPanel = Panel::BuildFromXML(nextElement);
+            }
+
+            nextElement = Root->FirstChildElement("popup");
+            while(nextElement) {
+                Popup* popup = Popup::BuildFromXML(nextElement);
+                if(popup) {
+                    AddPopup(popup);
                 }
+                nextElement = nextElement->NextSiblingElement("popup");
+            }
 
-                nextElement = Root->FirstChildElement("footer");
-                if(nextElement) {
-                    BottomPanel = Panel::BuildFromXML(nextElement);
+            nextElement = Root->FirstChildElement("prefab");
+            while(nextElement) {
+                Division* prefab = Division::BuildFromXML(nextElement);
+                if(prefab) {
+                    Prefabs.emplace_back(prefab);
                 }
+                nextElement = nextElement->NextSiblingElement("prefab");
+            }
+
+            nextElement = Root->FirstChildElement("customView");
+            while(nextElement) {
+                AddScreenFromXML(nextElement);
+                nextElement = nextElement->NextSiblingElement("customView");
+            }
+
+            nextElement = Root->FirstChildElement("ListView");
+            while(nextElement) {
+                AddScreenFromXML(nextElement);
+                nextElement = nextElement->NextSiblingElement("ListView");
+            }
+
+            nextElement = Root->FirstChildElement("GridView");
+            while(nextElement) {
+                AddScreenFromXML(nextElement);
+                nextElement = nextElement->NextSiblingElement("GridView");
+            }
+        }
+    }
+
+    void Manager::KeepScreenDocument(std::unique_ptr<XMLDocument> document, size_t previouslyPending)
+    {
+        // the layout is compared with its new version when reloading, pending screens may still use the previous one
+        if(layoutReloading) {
+            if(layoutDocument && !pendingScreens.empty()) {
+                screenDocuments.push_back(std::move(layoutDocument));
+            }
+            layoutDocument = std::move(document);
+            return;
+        }
+
+        // pending screens are built from the elements of the document later on
+        if(pendingScreens.size() > previouslyPending) {
+            screenDocuments.push_back(std::move(document));
+        } else {
+            document->Clear();
+        }
+    }
+
+    void Manager::AddScreenFromXML(XMLElement* element)
+    {
+        if(lazyScreenLoading && element->Attribute("id")) {
+            pendingScreens.push_back({element, static_cast<uint32_t>(Screens.size())});
+            Screens.push_back(nullptr);
+            return;
+        }
+
+        AbstractView* Screen = BuildScreen(element);
+        if(Screen) {
+            AddScreen(Screen);
+        }
+    }
+
+    AbstractView* Manager::BuildScreen(XMLElement* element)
+    {
+        if(strcmp(element->Value(), "customView") == 0) {
+            AbstractView* Screen = CustomView::BuildFromXML(element);
+            if(Screen) {
+                Log(INFO, "Added screen for CustomView");
+            }
+            return Screen;
+        }
+
+        if(strcmp(element->Value(), "ListView") == 0) {
+            return ListView::BuildFromXML(element);
+        }
+
+        return GridView::BuildFromXML(element);
+    }
+
+    AbstractView* Manager::BuildPendingScreen(size_t pending)
+    {
+        const PendingScreen screen = pendingScreens[pending];
+        pendingScreens.erase(pendingScreens.begin() + pending);
+
+        AbstractView* Screen = nullptr;
+        {
+            Stylesheet::Scope stylesheetScope(stylesheet);
+            Screen = BuildScreen(screen.element);
+        }
+
+        if(Screen) {
+            Screens[screen.index] = Screen;
+            Screen->SetSize(width, height - GetTopPanelHeight() - GetBottomPanelHeight());
+            FindLikelyScreens(screen.element);
+        } else {
+            // screens which failed to build are left out, the same as when they are built eagerly
+            RemoveScreenAt(screen.index);
+        }
+
+        if(pendingScreens.empty()) {
+            likelyScreens.clear();
+            screenDocuments.clear();
+        }
 
-                nextElement = Root->FirstChildElement("popup");
-                while(nextElement) {
-                    Popup* popup = Popup::BuildFromXML(nextElement);
-                    if(popup) {
-                        AddPopup(popup);
+        return Screen;
+    }
+
+    void Manager::BuildPendingScreens()
+    {
+        while(!pendingScreens.empty()) {
+            BuildPendingScreen(0);
+        }
+    }
+
+    bool Manager::PrebuildScreen(uint64_t timestamp)
+    {
+        if(pendingScreens.empty()) {
+            return false;
+        }
+
+        // screens are built whole, only when the next frame is further away than the longest build so far
+        const uint64_t nextFrame = frameScheduler.GetNextFrameTimestamp();
+        if(nextFrame != FrameScheduler::noFrame && nextFrame < timestamp + prebuildTime) {
+            return false;
+        }
+
+        // screens named by the built ones go first, then the rest in the order of the layout
+        size_t pending = 0;
+        while(!likelyScreens.empty()) {
+            XMLElement* element = likelyScreens.front();
+            likelyScreens.erase(likelyScreens.begin());
+
+            auto likely = std::find_if(pendingScreens.begin(), pendingScreens.end(), [element](const PendingScreen& screen) {
+                return screen.element == element;
+            });
+            if(likely != pendingScreens.end()) {
+                pending = likely - pendingScreens.begin();
+                break;
+            }
+        }
+
+        Stopwatch watch {};
+        BuildPendingScreen(pending);
+        watch.stop();
+        prebuildTime = std::max<uint64_t>(prebuildTime, watch.get<std::chrono::milliseconds>() + 1);
+        return true;
+    }
+
+    void Manager::FindLikelyScreens(XMLElement* element)
+    {
+        std::vector<XMLElement*> elements {element};
+
+        while(!elements.empty()) {
+            XMLElement* next = elements.back();
+            elements.pop_back();
+
+            // attribute values are split into words, e.g. SetActiveScreen('menu') names menu but not menu_settings
+            for(const XMLAttribute* attribute = next->FirstAttribute(); attribute; attribute = attribute->Next()) {
+                const char* value = attribute->Value();
+                while(*value) {
+                    const size_t length = strspn(value, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-");
+                    if(length == 0) {
+                        value++;
+                        continue;
                     }
-                    nextElement = nextElement->NextSiblingElement("popup");
-                }
 
-                nextElement = Root->FirstChildElement("prefab");
-                while(nextElement) {
-                    Division* prefab = Division::BuildFromXML(nextElement);
-                    if(prefab) {
-                        Prefabs.emplace_back(prefab);
+                    for(const PendingScreen& screen : pendingScreens) {
+                        const char* id = screen.element->Attribute("id");
+                        if(strlen(id) == length && strncmp(value, id, length) == 0
+                           && std::find(likelyScreens.begin(), likelyScreens.end(), screen.element) == likelyScreens.end()) {
+                            likelyScreens.push_back(screen.element);
+                        }
                     }
-                    nextElement = nextElement->NextSiblingElement("prefab");
+                    value += length;
                 }
+            }
 
-                nextElement = Root->FirstChildElement("customView");
-                while(nextElement) {
-                    AbstractView* Screen = CustomView::BuildFromXML(nextElement);
-                    if(Screen) {
-                        AddScreen(Screen);
-                        Log(INFO, "Added screen for CustomView");
-                    }
-                    nextElement = nextElement->NextSiblingElement("customView");
+            for(XMLElement* child = next->FirstChildElement(); child; child = child->NextSiblingElement()) {
+                elements.push_back(child);
+            }
+        }
+    }
+
+    void Manager::RemoveScreenAt(size_t index)
+    {
+        Screens.erase(Screens.begin() + index);
+        for(PendingScreen& screen : pendingScreens) {
+            if(screen.index > index) {
+                screen.index--;
+            }
+        }
+    }
+
+    void Manager::ReloadLayout(XMLNode* previousRoot, const Stylesheet& previousStylesheet, XMLNode* root)
+    {
+        TopPanel = ReloadPanel(TopPanel, previousRoot->FirstChildElement("header"), previousStylesheet, root->FirstChildElement("header"));
+        BottomPanel = ReloadPanel(BottomPanel, previousRoot->FirstChildElement("footer"), previousStylesheet, root->FirstChildElement("footer"));
+
+        ReloadPopups(previousRoot, previousStylesheet, root);
+
+        ReloadScreens(previousRoot, previousStylesheet, root, "customView");
+        ReloadScreens(previousRoot, previousStylesheet, root, "ListView");
+        ReloadScreens(previousRoot, previousStylesheet, root, "GridView");
+
+        // the likely screens are elements of the previous layout
+        likelyScreens.clear();
+    }
+
+    void Manager::ReloadScreens(XMLNode* previousRoot, const Stylesheet& previousStylesheet, XMLNode* root, const char* name)
+    {
+        for(XMLElement* next = root->FirstChildElement(name); next; next = next->NextSiblingElement(name)) {
+            // screens without an id can't be shown, so they are left as they are
+            const char* id = next->Attribute("id");
+            if(!id) {
+                continue;
+            }
+
+            XMLElement* previous = FindChildById(previousRoot, name, id);
+            auto pending = std::find_if(pendingScreens.begin(), pendingScreens.end(), [previous](const PendingScreen& screen) {
+                return screen.element == previous;
+            });
+            if(previous && pending != pendingScreens.end()) {
+                pending->element = next;
+                continue;
+            }
+
+            size_t index = 0;
+            while(index < Screens.size() && !(Screens[index] && strcmp(Screens[index]->GetID(), id) == 0)) {
+                index++;
+            }
+
+            if(!previous || index == Screens.size()) {
+                AddScreenFromXML(next);
+                continue;
+            }
+
+            AbstractView* screen = Screens[index];
+            if(ReloadComponent(screen, previous, previousStylesheet, next)) {
+                continue;
+            }
+
+            AbstractView* replacement = BuildScreen(next);
+            if(!replacement) {
+                Log(ERROR, "Screen %s couldn't be reloaded.", id);
+                continue;
+            }
+
+            replacement->SetSize(width, height - GetTopPanelHeight() - GetBottomPanelHeight());
+            TransferJavaScriptObjects(screen, replacement);
+            Screens[index] = replacement;
+            if(ActiveScreen == screen) {
+                ActiveScreen = replacement;
+                ActiveScreen->PrepareToOpen();
+                ActiveScreen->CheckPlacement();
+            }
+            DiscardComponent(screen);
+        }
+
+        for(XMLElement* previous = previousRoot->FirstChildElement(name); previous; previous = previous->NextSiblingElement(name)) {
+            const char* id = previous->Attribute("id");
+            if(!id || FindChildById(root, name, id)) {
+                continue;
+            }
+
+            auto pending = std::find_if(pendingScreens.begin(), pendingScreens.end(), [previous](const PendingScreen& screen) {
+                return screen.element == previous;
+            });
+            if(pending != pendingScreens.end()) {
+                const size_t index = pending->index;
+                pendingScreens.erase(pending);
+                RemoveScreenAt(index);
+                continue;
+            }
+
+            for(size_t index = 0; index < Screens.size(); index++) {
+                if(!Screens[index] || strcmp(Screens[index]->GetID(), id) != 0) {
+                    continue;
                 }
 
-                nextElement = Root->FirstChildElement("ListView");
-                while(nextElement) {
-                    AbstractView* Screen = ListView::BuildFromXML(nextElement);
-                    if(Screen) {
-                        AddScreen(Screen);
-                    }
-                    nextElement = nextElement->NextSiblingElement("ListView");
+                if(Screens[index] == ActiveScreen) {
+                    Log(WARN, "Screen %s removed from the layout is still shown.", id);
+                } else {
+                    DiscardComponent(Screens[index]);
+                    RemoveScreenAt(index);
                 }
+                break;
+            }
+        }
+    }
 
-                nextElement = Root->FirstChildElement("GridView");
-                while(nextElement) {
-                    AbstractView* Screen = GridView::BuildFromXML(nextElement);
-                    if(Screen) {
-                        AddScreen(Screen);
-                    }
-                    nextElement = nextElement->NextSiblingElement("GridView");
+    void Manager::ReloadPopups(XMLNode* previousRoot, const Stylesheet& previousStylesheet, XMLNode* root)
+    {
+        for(XMLElement* next = root->FirstChildElement("popup"); next; next = next->NextSiblingElement("popup")) {
+            const char* id = next->Attribute("id");
+            if(!id) {
+                continue;
+            }
+
+            XMLElement* previous = FindChildById(previousRoot, "popup", id);
+            Popup* popup = GetPopupFromContainer(id);
+            if(!popup) {
+                AddPopup(Popup::BuildFromXML(next));
+                continue;
+            }
+
+            if(!previous || ReloadComponent(popup, previous, previousStylesheet, next)) {
+                continue;
+            }
+
+            Popup* replacement = Popup::BuildFromXML(next);
+            if(!replacement) {
+                Log(ERROR, "Popup %s couldn't be reloaded.", id);
+                continue;
+            }
+
+            TransferJavaScriptObjects(popup, replacement);
+            std::replace(PopupsContainer.begin(), PopupsContainer.end(), popup, replacement);
+            if(CurrentPopup == popup) {
+                CurrentPopup = replacement;
+                CurrentPopup->Show();
+            }
+            DiscardComponent(popup);
+        }
+
+        for(XMLElement* previous = previousRoot->FirstChildElement("popup"); previous; previous = previous->NextSiblingElement("popup")) {
+            const char* id = previous->Attribute("id");
+            if(!id || FindChildById(root, "popup", id)) {
+                continue;
+            }
+
+            Popup* popup = GetPopupFromContainer(id);
+            if(popup && popup != CurrentPopup) {
+                PopupsContainer.erase(std::find(PopupsContainer.begin(), PopupsContainer.end(), popup));
+                DiscardComponent(popup);
+            }
+        }
+    }
+
+    Panel* Manager::ReloadPanel(Panel* panel, XMLElement* previous, const Stylesheet& previousStylesheet, XMLElement* next)
+    {
+        if(!next) {
+            if(panel && previous) {
+                DiscardComponent(panel);
+                return nullptr;
+            }
+            return panel;
+        }
+
+        if(panel && previous && ReloadComponent(panel, previous, previousStylesheet, next)) {
+            return panel;
+        }
+
+        Panel* replacement = Panel::BuildFromXML(next);
+        if(panel) {
+            TransferJavaScriptObjects(panel, replacement);
+            DiscardComponent(panel);
+        }
+        return replacement;
+    }
+
+    bool Manager::ReloadComponent(Component* component, XMLElement* previous, const Stylesheet& previousStylesheet, XMLElement* next)
+    {
+        if(!HasSameAttributes(previous, previousStylesheet, next, stylesheet)) {
+            return false;
+        }
+
+        Container* container = dynamic_cast<Container*>(component);
+        if(!container) {
+            return HasSameTree(previous, previousStylesheet, next, stylesheet);
+        }
+
+        return ReloadElements(container, previous, previousStylesheet, next);
+    }
+
+    bool Manager::ReloadElements(Container* container, XMLElement* previous, const Stylesheet& previousStylesheet, XMLElement* next)
+    {
+        std::vector<Component*>& elements = container->GetElements();
+
+        // elements are built from the widget children in order, other children (e.g. keys) configure the container itself
+        std::vector<XMLElement*> previousWidgets;
+        std::vector<XMLElement*> previousOwn;
+        for(XMLElement* child = previous->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            const char* id = child->Attribute("id");
+            const size_t index = previousWidgets.size();
+            if(index < elements.size() && component_exists(child->Value()) && strcmp(elements[index]->GetID(), id ? id : "") == 0) {
+                previousWidgets.push_back(child);
+            } else {
+                previousOwn.push_back(child);
+            }
+        }
+
+        // elements added by scripts can't be matched with the layout
+        if(previousWidgets.size() != elements.size()) {
+            return false;
+        }
+
+        std::vector<XMLElement*> nextWidgets;
+        std::vector<XMLElement*> nextOwn;
+        for(XMLElement* child = next->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            (component_exists(child->Value()) ? nextWidgets : nextOwn).push_back(child);
+        }
+
+        if(previousOwn.size() != nextOwn.size()) {
+            return false;
+        }
+        for(size_t i = 0; i < previousOwn.size(); i++) {
+            if(!HasSameTree(previousOwn[i], previousStylesheet, nextOwn[i], stylesheet)) {
+                return false;
+            }
+        }
+
+        // positions of elements in such containers depend on all the previous ones
+        const bool layout = container->LaysOutElements();
+        if(layout && previousWidgets.size() != nextWidgets.size()) {
+            return false;
+        }
+
+        std::vector<Component*> reloaded;
+        std::vector<Component*> removed;
+        std::vector<bool> used(previousWidgets.size());
+        bool changed = previousWidgets.size() != nextWidgets.size();
+
+        for(XMLElement* child : nextWidgets) {
+            const int32_t match = FindMatchingElement(previousWidgets, used, child);
+            if(match >= 0) {
+                used[match] = true;
+                if(ReloadComponent(elements[match], previousWidgets[match], previousStylesheet, child)) {
+                    changed |= match != (int32_t)reloaded.size();
+                    reloaded.push_back(elements[match]);
+                    continue;
                 }
             }
-        } else { // Parsing failed
-            Log(ERROR, "XML parsing failed.");
-            doc.Clear();
-            return -1;
+
+            if(layout) {
+                return false;
+            }
+
+            changed = true;
+            Component* element = create_component(child->Value(), child);
+            if(!element) {
+                if(match >= 0) {
+                    reloaded.push_back(elements[match]);
+                }
+                continue;
+            }
+
+            element->SetParentID(container->GetID());
+            if(match >= 0) {
+                TransferJavaScriptObjects(elements[match], element);
+                removed.push_back(elements[match]);
+            }
+            reloaded.push_back(element);
         }
-        Log(INFO, "Parsing done.");
-        doc.Clear();
-        if(GetScreen("start"))
-            SetActiveScreen("start", 0);
-        return 0;
+
+        for(size_t i = 0; i < used.size(); i++) {
+            if(!used[i]) {
+                removed.push_back(elements[i]);
+            }
+        }
+
+        if(changed) {
+            container->ReplaceElements(reloaded);
+        }
+
+        for(Component* element : removed) {
+            DiscardComponent(element);
+        }
+        return true;
+    }
+
+    void Manager::TransferJavaScriptObjects(Component* from, Component* to)
+    {
+        if(typeid(*from) == typeid(*to)) {
+            to->TakeJavaScriptObject(*from);
+        }
+
+        Container* source = dynamic_cast<Container*>(from);
+        Container* target = dynamic_cast<Container*>(to);
+        if(!source || !target) {
+            return;
+        }
+
+        // scripts find elements by id, so these are the ones that can be held by them
+        std::vector<Component*> elements(source->GetElements());
+        while(!elements.empty()) {
+            Component* element = elements.back();
+            elements.pop_back();
+
+            if(Container* container = dynamic_cast<Container*>(element)) {
+                elements.insert(elements.end(), container->GetElements().begin(), container->GetElements().end());
+            }
+
+            if(element->GetID()[0] == '\0') {
+                continue;
+            }
+
+            Component* replacement = target->GetElement(element->GetID());
+            if(replacement && typeid(*replacement) == typeid(*element)) {
+                replacement->TakeJavaScriptObject(*element);
+            }
+        }
+    }
+
+    void Manager::DiscardComponent(Component* component)
+    {
+        if(activeInput) {
+            Container* container = dynamic_cast<Container*>(component);
+            if(component == activeInput || (container && container->GetElement(activeInput->GetID()) == activeInput)) {
+                activeInput = nullptr;
+            }
+        }
+
+        delete component;
     }
 
     void Manager::ParseScripts(XMLElement* script)
@@ -1549,14 +2288,63 @@ namespace grvl {
         return *this;
     }
 
-    void Manager::MainLoopIteration()
+    void Manager::RequestRedraw()
     {
+        if(!instance || IsDrawingThread()) {
+            return;
+        }
+
+        instance->frameScheduler.RequestFrame();
+    }
+
+    void Manager::RequestRedrawAfterFrame()
+    {
+        if(!instance) {
+            return;
+        }
+
+        if(IsDrawingThread()) {
+            instance->redrawAfterFrame.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        instance->frameScheduler.RequestFrame();
+    }
+
+    bool Manager::IsDrawingThread()
+    {
+        return instance && instance->drawing.load(std::memory_order_acquire) && pthread_equal(instance->drawingThread, pthread_self());
+    }
+
+    void Manager::RequestRedraw(uint64_t timestamp)
+    {
+        if(!instance) {
+            return;
+        }
+
+        instance->frameScheduler.RequestFrame(timestamp);
+    }
+
+    FrameScheduler& Manager::GetFrameScheduler()
+    {
+        return frameScheduler;
+    }
+
+    bool Manager::MainLoopIteration()
+    {
+        // perf.js_time_this_frame is only reset by drawn frames, scripts of idle iterations get a budget of their own
+        JSEngine::ResetFrameBudget();
+
         // process popups
         if(timeoutedPopupMode && CurrentPopup && CurrentPopup->GetTimetamp() < grvl::Callbacks()->get_timestamp()) {
             ClosePopup();
             timeoutedPopupMode = false;
         }
 
+        if(timeoutedPopupMode && CurrentPopup) {
+            frameScheduler.RequestFrame(CurrentPopup->GetTimetamp());
+        }
+
         // check key long press
         static constexpr auto keyLongPressDelay = 500;
         if(keyActive) {
@@ -1568,16 +2356,45 @@ namespace grvl {
                 KeyPressTimestamp = grvl::Callbacks()->get_timestamp();
                 ActiveScreen->LongPressRepeatKey(activeKey.name.c_str());
             }
+
+            frameScheduler.RequestFrame(KeyPressTimestamp + (longPressActive ? activeKey.repeat : keyLongPressDelay));
         }
 
         // process events
         ProcessEvents();
 
+        // run due timers and microtasks of scripts, in what is left of the frame budget
+        JSEngine::RunScheduledTasks(grvl::Callbacks()->get_timestamp());
+
+        uint64_t frameTimestamp = grvl::Callbacks()->get_timestamp();
+        if(!frameScheduler.IsFrameDue(frameTimestamp)) {
+            // screens kept as XML are built while there is nothing to draw, one per iteration
+            PrebuildScreen(frameTimestamp);
+            return false;
+        }
+
+        if(!frameScheduler.BeginFrame(frameTimestamp)) {
+            perf.missed_deadlines++;
+        }
+
+        JSEngine::RunAnimationFrameCallbacks(frameTimestamp);
+
         // redraw
         Stopwatch watch {};
+        if(!drawingThreadSet) {
+            drawingThread = pthread_self();
+            drawingThreadSet = true;
+        }
+        drawing.store(true, std::memory_order_release);
         Draw();
+        drawing.store(false, std::memory_order_release);
         watch.stop();
 
+        // BeginFrame cleared the request of the frame just drawn, so the next one is requested after it
+        if(redrawAfterFrame.exchange(false, std::memory_order_relaxed)) {
+            frameScheduler.RequestFrame();
+        }
+
         size_t script_time = perf.js_time_this_frame;
         perf.js_time_this_frame = 0;
 
@@ -1599,10 +2416,16 @@ namespace grvl {
             perf.mspt = (perf.fps == 0) ? 0 : (elapsed / perf.fps);
         }
 
+        return true;
     }
 
+    // The only consumer of the event queue, called by the main loop thread
     void Manager::ProcessEvents()
     {
+        eventsProcessed = true;
+        eventsThread = pthread_self();
+
+        processingEvents = true;
         while (true) {
             auto event = eventsQueue.pop();
 
@@ -1612,6 +2435,27 @@ namespace grvl {
 
             (*event)->Trigger();
         }
+
+        if(eventsOverflowed.load(std::memory_order_acquire)) {
+            std::vector<Event*> overflow;
+            {
+                Guard lock {overflowEventsMutex};
+                overflow.swap(overflowEvents);
+                eventsOverflowed.store(false, std::memory_order_release);
+            }
+
+            for(Event* event : overflow) {
+                event->Trigger();
+            }
+        }
+        processingEvents = false;
+
+        // reloaded by a callback
+        if(!pendingLayout.empty()) {
+            std::string document = std::move(pendingLayout);
+            pendingLayout.clear();
+            ReloadFromXMLString(document);
+        }
     }
 
     void Manager::Initialize(uint32_t xSize, uint32_t ySize, int bpp, bool rotate90)
@@ -1637,6 +2481,9 @@ namespace grvl {
             delete *it;
             it = Screens.erase(it);
         }
+        pendingScreens.clear();
+        likelyScreens.clear();
+        screenDocuments.clear();
         std::vector<Popup*>::iterator itp;
         for(itp = PopupsContainer.begin(); itp != PopupsContainer.end();) {
             delete *itp;
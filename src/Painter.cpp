@@ -22,6 +22,7 @@
 #include <grvl/Painter.h>
 #include <grvl/Blitter.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include <string>
@@ -40,6 +41,52 @@ namespace grvl {
         return !((color & 0xff000000) == 0xff000000);
     }
 
+    // Interpolates two ARGB8888 colors, weight is 0-256, two channels are computed by each multiplication
+    static inline uint32_t LerpColor(uint32_t a, uint32_t b, uint32_t weight)
+    {
+        const uint32_t rb = (((a & 0x00FF00FF) * (256 - weight) + (b & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;
+        const uint32_t ag = (((a >> 8) & 0x00FF00FF) * (256 - weight) + ((b >> 8) & 0x00FF00FF) * weight) & 0xFF00FF00;
+        return rb | ag;
+    }
+
+    // Maps visible destination pixels along one axis to source pixels in 16.16 fixed point, sampling at pixel centers
+    struct ScaleAxis {
+        int32_t sourceStart;
+        int32_t sourceLength;
+        int32_t length;
+        int32_t visibleStart;
+        int32_t visibleLength;
+
+        int32_t Step() const
+        {
+            return (static_cast<int64_t>(sourceLength) << 16) / length;
+        }
+
+        // position of the first visible pixel, relative to the source start
+        int32_t Start(ImageFilter filter) const
+        {
+            const int32_t step = Step();
+            return static_cast<int64_t>(visibleStart) * step + step / 2 - (filter == ImageFilter::Bilinear ? 0x8000 : 0);
+        }
+
+        // index of the nearest source pixel, or the pair of pixels around the position with the weight of the second one
+        int32_t Sample(int32_t position, ImageFilter filter, int32_t& next, uint32_t& weight) const
+        {
+            const int32_t last = sourceLength - 1;
+            if (filter == ImageFilter::Nearest) {
+                next = std::min(position >> 16, last);
+                weight = 0;
+                return next;
+            }
+
+            position = std::clamp(position, 0, last << 16);
+            const int32_t index = position >> 16;
+            next = std::min(index + 1, last);
+            weight = (position >> 8) & 0xFF;
+            return index;
+        }
+    };
+
     Painter::~Painter()
     {
     }
@@ -55,6 +102,7 @@ namespace grvl {
     // Note: this was originally commented out
     void Painter::ShadowBuffer(uint8_t number, uint32_t color)
     {
+        WaitForBlitter();
         memset((void*)shadowImage->GetData(), color >> 24, shadowImage->GetWidth() * 4);
 
         for(uint32_t i = 0; i < YSize; i++) {
@@ -81,6 +129,9 @@ namespace grvl {
             return;
         }
 
+        // a queued blit could overwrite the pixel afterwards
+        WaitForBlitter();
+
         if(GetActiveBufferBytesPerPixel() == 4) {
             uint32_t* pixels = (uint32_t*)ptr;
             pixels[Ypos * GetXSize() + Xpos] = RGB_Code;
@@ -155,6 +206,9 @@ namespace grvl {
             return COLOR_ARGB8888_BLACK;
         }
 
+        // also covers BlendPixel, which reads the pixel first
+        WaitForBlitter();
+
         uintptr_t ptr = GetActiveBuffer();
         if(GetActiveBufferBytesPerPixel() == 4) {
             uint32_t* pixels = (uint32_t*)ptr;
@@ -429,20 +483,74 @@ namespace grvl {
     }
 
     void Painter::DrawImage(int16_t x, int16_t y, const ImageContent* image, uint32_t frame) const
+    {
+        if (image == nullptr) {
+            return;
+        }
+
+        DrawImage(x, y, image, frame, {0, 0, static_cast<int32_t>(image->GetWidth()), static_cast<int32_t>(image->GetHeight())});
+    }
+
+    void Painter::DrawImage(int16_t x, int16_t y, const ImageContent* image, uint32_t frame, const ImageRegion& region) const
     {
         if (image == nullptr || image->IsEmpty()) {
             return;
         }
 
+        if (region.x < 0 || region.y < 0 || region.x + region.width > static_cast<int32_t>(image->GetWidth())
+            || region.y + region.height > static_cast<int32_t>(image->GetHeight())) {
+            return;
+        }
+
+        if (image->IsCompressed()) {
+            DmaMoveCompressedImage(image, frame, GetActiveBuffer(), region, x, y);
+            return;
+        }
+
+        // streamed animations have nothing to show until their first frame is decoded
         uintptr_t address = reinterpret_cast<uintptr_t>(image->GetFrameData(frame));
+        if (address == 0) {
+            return;
+        }
 
         DmaMoveImage(
-            address, GetActiveBuffer(), 0, 0, x, y, image->GetWidth(), image->GetHeight(),
+            address, GetActiveBuffer(), region.x, region.y, x, y, region.width, region.height,
             image->GetPixelsPerLine(), image->GetNumberOfLines(), 0, 1,
             image->GetColorFormat(), GetPixelFormat(), image->HasAlphaChannel(), image->GetColorPalette()
         );
     }
 
+    void Painter::DrawScaledImage(int16_t x, int16_t y, int32_t width, int32_t height, const ImageContent* image, uint32_t frame,
+                                  const ImageRegion& region, ImageFilter filter) const
+    {
+        if (image == nullptr || image->IsEmpty() || width <= 0 || height <= 0 || region.width <= 0 || region.height <= 0) {
+            return;
+        }
+
+        if (width == region.width && height == region.height) {
+            DrawImage(x, y, image, frame, region);
+            return;
+        }
+
+        if (region.x < 0 || region.y < 0 || region.x + region.width > static_cast<int32_t>(image->GetWidth())
+            || region.y + region.height > static_cast<int32_t>(image->GetHeight())) {
+            return;
+        }
+
+        // each level halves the size, use the smallest one that is still at least as large as the drawn size
+        const ImageContent* source = image;
+        ImageRegion sourceRegion = region;
+        for (uint32_t level = 1; level <= image->GetNumberOfMipLevels(); level++) {
+            if ((region.width >> level) < width || (region.height >> level) < height) {
+                break;
+            }
+            source = image->GetMipLevel(level);
+            sourceRegion = {region.x >> level, region.y >> level, region.width >> level, region.height >> level};
+        }
+
+        DmaMoveScaledImage(source, frame, GetActiveBuffer(), sourceRegion, x, y, width, height, filter);
+    }
+
     void Painter::DrawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t color) const
     {
         int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0, yinc1 = 0, yinc2 = 0, den = 0, num = 0,
@@ -938,9 +1046,8 @@ namespace grvl {
             return;
         }
 
-        grvl::Callbacks()->blit(
-            inputMem, backgroundMem, outputMem, PixelsPerLine, NumberOfLines, inOffset, backgroundOffset, outOffset,
-            inPixelFormat, backgroundPixelFormat, outPixelFormat, frontColor);
+        QueueBlit({BlitOperation::Blit, inputMem, backgroundMem, outputMem, PixelsPerLine, NumberOfLines, inOffset, backgroundOffset, outOffset,
+                   inPixelFormat, backgroundPixelFormat, outPixelFormat, frontColor, 0, 0});
     }
 
     void Painter::DmaOperationCLT(uintptr_t inputMem, uintptr_t backgroundMem, uintptr_t outputMem, uint32_t PixelsPerLine,
@@ -965,22 +1072,130 @@ namespace grvl {
                 frontCLT = (uintptr_t)greyscaleCltPalette;
             }
 
-            grvl::Callbacks()->blit_clt(
-                inputMem, backgroundMem, outputMem, PixelsPerLine, NumberOfLines, inOffset, backgroundOffset, outOffset,
-                inPixelFormat, backgroundPixelFormat, outPixelFormat, 0, backCLT, frontCLT);
+            QueueBlit({BlitOperation::BlitClt, inputMem, backgroundMem, outputMem, PixelsPerLine, NumberOfLines, inOffset, backgroundOffset, outOffset,
+                       inPixelFormat, backgroundPixelFormat, outPixelFormat, 0, backCLT, frontCLT});
+
+            return;
+        }
+
+        QueueBlit({BlitOperation::Blit, inputMem, backgroundMem, outputMem, PixelsPerLine, NumberOfLines, inOffset, backgroundOffset, outOffset,
+                   inPixelFormat, backgroundPixelFormat, outPixelFormat, 0, 0, 0});
+    }
 
+    void Painter::DmaBlend(uintptr_t inputMem, uintptr_t backgroundMem, uintptr_t outputMem, uint32_t PixelsPerLine,
+                           uint32_t NumberOfLines, uint32_t inOffset, uint32_t backgroundOffset, uint32_t outOffset,
+                           Format inPixelFormat, Format backgroundPixelFormat, Format outPixelFormat, uint8_t alpha) const
+    {
+        if(PixelsPerLine == 0 || NumberOfLines == 0) {
             return;
         }
 
-        grvl::Callbacks()->blit(
-            inputMem, backgroundMem, outputMem, PixelsPerLine, NumberOfLines, inOffset, backgroundOffset, outOffset,
-            inPixelFormat, backgroundPixelFormat, outPixelFormat, 0);
+        QueueBlit({BlitOperation::Blend, inputMem, backgroundMem, outputMem, PixelsPerLine, NumberOfLines, inOffset, backgroundOffset, outOffset,
+                   inPixelFormat, backgroundPixelFormat, outPixelFormat, alpha, 0, 0});
     }
 
     void Painter::DmaFill(uintptr_t outputMem, uint32_t PixelsPerLine, uint32_t NumberOfLines, uint32_t outOffset,
                           uint32_t color_index, Format pixel_format) const
     {
-        return grvl::Callbacks()->fill(outputMem, PixelsPerLine, NumberOfLines, outOffset, color_index, pixel_format);
+        if(PixelsPerLine == 0 || NumberOfLines == 0) {
+            return;
+        }
+
+        QueueBlit({BlitOperation::Fill, 0, 0, outputMem, PixelsPerLine, NumberOfLines, 0, 0, outOffset,
+                   pixel_format, pixel_format, pixel_format, color_index, 0, 0});
+    }
+
+    // Bytes of memory used by an operation, lines of 'width' bytes, 'pitch' bytes apart
+    struct BlitArea {
+        uintptr_t start;
+        uintptr_t end;
+        uint32_t width;
+        uint32_t pitch;
+    };
+
+    static BlitArea GetBlitArea(uintptr_t memory, uint32_t columns, uint32_t rows, uint32_t offset, Format format)
+    {
+        if(memory == 0 || columns == 0 || rows == 0) {
+            return {0, 0, 0, 0};
+        }
+
+        const uint32_t stride = GetFormatStride(format);
+        const uint32_t pitch = (columns + offset) * stride;
+        return {memory, memory + (rows - 1) * pitch + columns * stride, columns * stride, pitch};
+    }
+
+    static bool Overlaps(const BlitArea& a, const BlitArea& b)
+    {
+        if(a.start >= b.end || b.start >= a.end) {
+            return false;
+        }
+
+        // the spans overlap, areas with the same pitch are rectangles on the same lines, which overlap if their columns do
+        if(a.pitch != b.pitch || a.pitch == 0) {
+            return true;
+        }
+
+        const uintptr_t aColumn = a.start % a.pitch;
+        const uintptr_t bColumn = b.start % b.pitch;
+        if(aColumn + a.width > a.pitch || bColumn + b.width > b.pitch) {
+            return true;
+        }
+
+        return aColumn < bColumn + b.width && bColumn < aColumn + a.width;
+    }
+
+    static bool Conflicts(const BlitDescriptor& first, const BlitDescriptor& second)
+    {
+        const BlitArea firstOutput = GetBlitArea(first.outputMem, first.columns, first.rows, first.outOffset, first.outPixelFormat);
+        const BlitArea secondOutput = GetBlitArea(second.outputMem, second.columns, second.rows, second.outOffset, second.outPixelFormat);
+
+        if(Overlaps(firstOutput, secondOutput)) {
+            return true;
+        }
+
+        // fills do not read any memory
+        if(second.operation != BlitOperation::Fill
+           && (Overlaps(firstOutput, GetBlitArea(second.inputMem, second.columns, second.rows, second.inOffset, second.inPixelFormat))
+               || Overlaps(firstOutput, GetBlitArea(second.backgroundMem, second.columns, second.rows, second.backgroundOffset, second.backgroundPixelFormat)))) {
+            return true;
+        }
+
+        return first.operation != BlitOperation::Fill
+            && (Overlaps(secondOutput, GetBlitArea(first.inputMem, first.columns, first.rows, first.inOffset, first.inPixelFormat))
+                || Overlaps(secondOutput, GetBlitArea(first.backgroundMem, first.columns, first.rows, first.backgroundOffset, first.backgroundPixelFormat)));
+    }
+
+    void Painter::QueueBlit(const BlitDescriptor& descriptor) const
+    {
+        if(!grvl::Callbacks()->blit_batch) {
+            RunBlitDescriptor(descriptor);
+            return;
+        }
+
+        // operations in a batch may run in any order, so one depending on a queued operation starts a new batch
+        for(uint32_t i = 0; i < blitBatchCount; i++) {
+            if(Conflicts(blitBatch[i], descriptor)) {
+                FlushBlits();
+                break;
+            }
+        }
+
+        if(blitBatchCount == blitBatch.size()) {
+            FlushBlits();
+        }
+
+        blitBatch[blitBatchCount++] = descriptor;
+    }
+
+    void Painter::FlushBlits() const
+    {
+        if(blitBatchCount == 0) {
+            return;
+        }
+
+        const uint32_t count = blitBatchCount;
+        blitBatchCount = 0;
+        grvl::Callbacks()->blit_batch(blitBatch.data(), count);
     }
 
     Format Painter::GetActiveBufferPixelFormat() const
@@ -1083,7 +1298,7 @@ namespace grvl {
             uint32_t frameWidth = totalImageWidth / frames;
             inputMem = img_src + inBytes * ((totalImageWidth * (totalImageHeight - width - x_src) + y_src + (activeFrame * frameWidth)));
             outputMem = fb_dst + outBytes * (y_lcd_size * (x_lcd_size - x_dst - width) + y_dst);
-            NumberOfLines = width - x_src;
+            NumberOfLines = width;
             PixelsPerLine = height;
             inOffset = totalImageWidth - height;
             outOffset = y_lcd_size - height;
@@ -1110,6 +1325,245 @@ namespace grvl {
         }
     }
 
+    void Painter::DmaMoveCompressedImage(const ImageContent* image, uint32_t frame, uintptr_t fb_dst, const ImageRegion& region, int32_t x_dst, int32_t y_dst) const
+    {
+        const Format inPixelFormat = image->GetColorFormat();
+        const Format outPixelFormat = GetPixelFormat();
+        int inBytes = GetFormatStride(inPixelFormat);
+        int outBytes = GetFormatStride(outPixelFormat);
+        uint32_t x_lcd_size = GetXSize();
+        uint32_t y_lcd_size = GetYSize();
+        int32_t x_src = region.x, y_src = region.y;
+        int32_t width = region.width;
+        int32_t height = region.height;
+        uintptr_t outputMem = 0;
+        uint32_t firstLine = 0, firstPixel = 0, NumberOfLines = 0, PixelsPerLine = 0, outLineLength = 0;
+
+        /* safety checks so that image is in drawing bounds */
+        if(y_dst < CurrentDrawingBoundsStartY()){
+            auto offset = std::abs(y_dst - CurrentDrawingBoundsStartY());
+            y_dst = CurrentDrawingBoundsStartY();
+            y_src += offset;
+            height -= offset;
+        }
+
+        if(y_dst + height > CurrentDrawingBoundsEndY()){
+            height -= y_dst + height - CurrentDrawingBoundsEndY();
+        }
+
+        if(x_dst < CurrentDrawingBoundsStartX()){
+            auto offset = std::abs(x_dst - CurrentDrawingBoundsStartX());
+            x_dst = CurrentDrawingBoundsStartX();
+            x_src += offset;
+            width -= offset;
+        }
+
+        if(x_dst + width > CurrentDrawingBoundsEndX()){
+            width -= x_dst + width - CurrentDrawingBoundsEndX();
+        }
+
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+
+        if(IsRotated()) {
+            // lines of rotated content are columns of the image, starting from the right
+            firstLine = image->GetNumberOfLines() - width - x_src;
+            firstPixel = y_src;
+            NumberOfLines = width;
+            PixelsPerLine = height;
+            outputMem = fb_dst + outBytes * (y_lcd_size * (x_lcd_size - x_dst - width) + y_dst);
+            outLineLength = y_lcd_size;
+        } else {
+            firstLine = y_src;
+            firstPixel = x_src;
+            NumberOfLines = height;
+            PixelsPerLine = width;
+            outputMem = fb_dst + outBytes * ((x_lcd_size * (y_dst)) + x_dst);
+            outLineLength = x_lcd_size;
+        }
+
+        const uint32_t lineLength = PixelsPerLine * inBytes;
+        const uint32_t stripLines = std::max<uint32_t>(1, PrepareDecodeStrips() / lineLength);
+        const uint32_t outOffset = outLineLength - PixelsPerLine;
+
+        for(uint32_t line = 0; line < NumberOfLines; line += stripLines) {
+            const uint32_t lines = std::min(stripLines, NumberOfLines - line);
+            const uint8_t stripIndex = NextDecodeStrip();
+            uint8_t* strip = decodeStrips[stripIndex].data();
+
+            for(uint32_t i = 0; i < lines; i++) {
+                image->DecodeLine(frame, firstLine + line + i, firstPixel, PixelsPerLine, strip + i * lineLength);
+            }
+
+            const uintptr_t inputMem = reinterpret_cast<uintptr_t>(strip);
+            const uintptr_t stripOutputMem = outputMem + outBytes * outLineLength * line;
+
+            if(image->HasAlphaChannel()) {
+                DmaOperationCLT(
+                    inputMem, stripOutputMem, stripOutputMem, PixelsPerLine, lines, 0, outOffset, outOffset,
+                    inPixelFormat, outPixelFormat, outPixelFormat, 0, image->GetColorPalette());
+            } else {
+                DmaOperationCLT(
+                    inputMem, 0, stripOutputMem, PixelsPerLine, lines, 0, 0, outOffset,
+                    inPixelFormat, Format::ARGB8888, outPixelFormat, 0, image->GetColorPalette());
+            }
+
+            decodeStripFences[stripIndex] = GetBlitFence();
+        }
+    }
+
+    void Painter::DmaMoveScaledImage(const ImageContent* image, uint32_t frame, uintptr_t fb_dst, const ImageRegion& region, int32_t x_dst,
+                                     int32_t y_dst, int32_t width, int32_t height, ImageFilter filter) const
+    {
+        const Format outPixelFormat = GetPixelFormat();
+        int outBytes = GetFormatStride(outPixelFormat);
+        uint32_t x_lcd_size = GetXSize();
+        uint32_t y_lcd_size = GetYSize();
+
+        /* safety checks so that image is in drawing bounds */
+        const int32_t x_start = std::max(x_dst, CurrentDrawingBoundsStartX());
+        const int32_t y_start = std::max(y_dst, CurrentDrawingBoundsStartY());
+        const int32_t x_end = std::min(x_dst + width, CurrentDrawingBoundsEndX());
+        const int32_t y_end = std::min(y_dst + height, CurrentDrawingBoundsEndY());
+
+        if (x_start >= x_end || y_start >= y_end) {
+            return;
+        }
+
+        // scaling follows the order of stored pixels, lines of rotated content are columns of the image, starting from the right
+        ScaleAxis lines {}, pixels {};
+        uintptr_t outputMem = 0;
+        uint32_t outLineLength = 0;
+
+        if(IsRotated()) {
+            lines = {static_cast<int32_t>(image->GetNumberOfLines()) - region.x - region.width, region.width, width, x_dst + width - x_end, x_end - x_start};
+            pixels = {region.y, region.height, height, y_start - y_dst, y_end - y_start};
+            outputMem = fb_dst + outBytes * (y_lcd_size * (x_lcd_size - x_end) + y_start);
+            outLineLength = y_lcd_size;
+        } else {
+            lines = {region.y, region.height, height, y_start - y_dst, y_end - y_start};
+            pixels = {region.x, region.width, width, x_start - x_dst, x_end - x_start};
+            outputMem = fb_dst + outBytes * ((x_lcd_size * y_start) + x_start);
+            outLineLength = x_lcd_size;
+        }
+
+        for(auto& sourceLine : scaleSourceLines) {
+            if(sourceLine.size() < static_cast<size_t>(pixels.sourceLength)) {
+                sourceLine.resize(pixels.sourceLength);
+            }
+        }
+
+        // the two most recently converted source lines are kept, so upscaling converts every line only once
+        int32_t cachedLines[2] = {-1, -1};
+        uint32_t lastSlot = 0;
+        const uint32_t inBytes = image->GetBytesPerPixel();
+
+        // streamed animations have nothing to show until their first frame is decoded
+        const uint8_t* frameData = image->IsCompressed() ? nullptr : image->GetFrameData(frame);
+        if(!image->IsCompressed() && !frameData) {
+            return;
+        }
+
+        auto sourceLine = [&](int32_t line) -> const uint32_t* {
+            for(uint32_t slot = 0; slot < 2; slot++) {
+                if(cachedLines[slot] == line) {
+                    lastSlot = slot;
+                    return scaleSourceLines[slot].data();
+                }
+            }
+
+            lastSlot ^= 1;
+            cachedLines[lastSlot] = line;
+            uint32_t* output = scaleSourceLines[lastSlot].data();
+            const uint32_t storedLine = lines.sourceStart + line;
+
+            const uint8_t* input = nullptr;
+            if(image->IsCompressed()) {
+                // decoded pixels are never wider than the converted ones, converting from the end does not overwrite unread pixels
+                image->DecodeLine(frame, storedLine, pixels.sourceStart, pixels.sourceLength, reinterpret_cast<uint8_t*>(output));
+                input = reinterpret_cast<const uint8_t*>(output);
+            } else {
+                input = frameData + (static_cast<size_t>(storedLine) * image->GetPixelsPerLine() + pixels.sourceStart) * inBytes;
+            }
+
+            for(int32_t i = pixels.sourceLength - 1; i >= 0; i--) {
+                output[i] = image->GetPixelColor(input + i * inBytes);
+            }
+            return output;
+        };
+
+        const uint32_t lineLength = pixels.visibleLength * GetFormatStride(Format::ARGB8888);
+        const uint32_t stripLines = std::max<uint32_t>(1, PrepareDecodeStrips() / lineLength);
+        const uint32_t outOffset = outLineLength - pixels.visibleLength;
+        const int32_t lineStep = lines.Step();
+        const int32_t pixelStep = pixels.Step();
+        const int32_t pixelStart = pixels.Start(filter);
+        int32_t linePosition = lines.Start(filter);
+
+        for(int32_t line = 0; line < lines.visibleLength; line += stripLines) {
+            const uint32_t stripLineCount = std::min<uint32_t>(stripLines, lines.visibleLength - line);
+            const uint8_t stripIndex = NextDecodeStrip();
+            uint32_t* strip = reinterpret_cast<uint32_t*>(decodeStrips[stripIndex].data());
+
+            for(uint32_t i = 0; i < stripLineCount; i++, linePosition += lineStep) {
+                int32_t nextLine = 0, nextPixel = 0;
+                uint32_t lineWeight = 0, pixelWeight = 0;
+                const uint32_t* first = sourceLine(lines.Sample(linePosition, filter, nextLine, lineWeight));
+                const uint32_t* second = lineWeight ? sourceLine(nextLine) : first;
+                uint32_t* output = strip + i * pixels.visibleLength;
+
+                int32_t pixelPosition = pixelStart;
+                for(int32_t x = 0; x < pixels.visibleLength; x++, pixelPosition += pixelStep) {
+                    const int32_t pixel = pixels.Sample(pixelPosition, filter, nextPixel, pixelWeight);
+                    uint32_t color = LerpColor(first[pixel], first[nextPixel], pixelWeight);
+                    if(lineWeight) {
+                        color = LerpColor(color, LerpColor(second[pixel], second[nextPixel], pixelWeight), lineWeight);
+                    }
+                    output[x] = color;
+                }
+            }
+
+            const uintptr_t inputMem = reinterpret_cast<uintptr_t>(strip);
+            const uintptr_t stripOutputMem = outputMem + outBytes * outLineLength * line;
+
+            if(image->HasAlphaChannel()) {
+                DmaOperationCLT(
+                    inputMem, stripOutputMem, stripOutputMem, pixels.visibleLength, stripLineCount, 0, outOffset, outOffset,
+                    Format::ARGB8888, outPixelFormat, outPixelFormat, 0, 0);
+            } else {
+                DmaOperationCLT(
+                    inputMem, 0, stripOutputMem, pixels.visibleLength, stripLineCount, 0, 0, outOffset,
+                    Format::ARGB8888, Format::ARGB8888, outPixelFormat, 0, 0);
+            }
+
+            decodeStripFences[stripIndex] = GetBlitFence();
+        }
+    }
+
+    uint32_t Painter::PrepareDecodeStrips() const
+    {
+        // strips are never resized, a blit from them may still be in progress
+        if(decodeStrips[0].empty()) {
+            const uint32_t size = std::max<uint32_t>(decodeStripSize, std::max(GetXSize(), GetYSize()) * GetFormatStride(Format::ARGB8888));
+            for(auto& strip : decodeStrips) {
+                strip.resize(size);
+            }
+        }
+
+        return decodeStrips[0].size();
+    }
+
+    uint8_t Painter::NextDecodeStrip() const
+    {
+        const uint8_t index = decodeStripIndex;
+        decodeStripIndex ^= 1;
+
+        // the strip is decoded into once the blit from its previous contents is done, the other one may still be in progress
+        WaitForBlit(decodeStripFences[index]);
+        return index;
+    }
+
     void Painter::DmaMoveShadow(uintptr_t img_src, uintptr_t fb_dst, int32_t x_dst, int32_t y_dst, int32_t width, int32_t height,
                                 Format outPixelFormat, uint32_t color) const
     {
@@ -1357,9 +1811,34 @@ namespace grvl {
 
     void Painter::SetLayerAddress(uint32_t display)
     {
+        // the buffer is shown once everything drawn into it is done
+        WaitForBlitter();
         grvl::Callbacks()->set_layer_pointer(backLayerPointers[display].data);
     }
 
+    BlitFence Painter::GetBlitFence() const
+    {
+        // queued operations are only covered by a fence once they are submitted
+        FlushBlits();
+
+        if(!grvl::Callbacks()->blit_fence) {
+            return 0;
+        }
+        return grvl::Callbacks()->blit_fence();
+    }
+
+    void Painter::WaitForBlit(BlitFence fence) const
+    {
+        if(fence != 0 && grvl::Callbacks()->wait_for_blit) {
+            grvl::Callbacks()->wait_for_blit(fence);
+        }
+    }
+
+    void Painter::WaitForBlitter() const
+    {
+        WaitForBlit(GetBlitFence());
+    }
+
     void Painter::AddBackgroundBlock(int32_t y_position, int32_t height, uint32_t backgroundColor)
     {
         if(!HasTransparency(backgroundColor) || BackgroundImage->IsEmpty()) {
@@ -1467,6 +1946,8 @@ namespace grvl {
 
     void Painter::FlipSynchronizeBuffers()
     {
+        // finish drawing before waiting for the vertical blanking, so the flip is not delayed by another frame
+        WaitForBlitter();
         if(grvl::Callbacks()->wait_for_vsync) {
             grvl::Callbacks()->wait_for_vsync();
         }
@@ -1479,12 +1960,25 @@ namespace grvl {
     void Painter::SetBackgroundImage(const std::string& resource)
     {
         BackgroundImage->ReplaceDelegate(contentManager->RequestImage(resource));
+        DecompressBackgroundImage();
     }
 
     void Painter::SetBackgroundImage(Image* image)
     {
         if(image) {
             BackgroundImage = image;
+            DecompressBackgroundImage();
+        }
+    }
+
+    void Painter::DecompressBackgroundImage()
+    {
+        // the background is blitted straight from the image data
+        ImageContent* content = BackgroundImage ? BackgroundImage->GetContent() : nullptr;
+        if(content && content->IsCompressed()) {
+            Log(WARN, "Background images can not be compressed, decompressing");
+            WaitForBlitter();
+            content->Decompress();
         }
     }
 
@@ -1656,6 +2150,8 @@ namespace grvl {
 
     void Painter::PushDrawingBoundsStackElement(int32_t startX, int32_t startY, int32_t endX, int32_t endY)
     {
+        FlushBlits();
+
         startX = std::max(CurrentDrawingBoundsStartX(), startX);
         startY = std::max(CurrentDrawingBoundsStartY(), startY);
         endX = std::min(CurrentDrawingBoundsEndX(), endX);
@@ -1672,6 +2168,8 @@ namespace grvl {
 
     void Painter::PopDrawingBoundsStackElement()
     {
+        FlushBlits();
+
         if (drawingBoundsStackIndex <= 0) {
             return;
         }
@@ -1681,6 +2179,8 @@ namespace grvl {
 
     void Painter::ResetDrawingBounds()
     {
+        FlushBlits();
+
         drawingBoundsStackIndex = 0;
 
         drawingBoundsStack[0].startX = 0;
@@ -0,0 +1,123 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <grvl/PixelConversion.h>
+#include <grvl/Endian.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace grvl {
+
+    // Side of the square blocks a frame is transposed in, a block of ARGB8888 pixels takes 256 bytes
+    static constexpr uint32_t rotateBlock = 8;
+
+    template <Format input, Format output>
+    static void ConvertRun(const uint8_t* in, uint8_t* out, uint32_t count)
+    {
+        constexpr uint32_t istride = GetFormatStride(input);
+        constexpr uint32_t ostride = GetFormatStride(output);
+
+        // both formats are known here, so the conversion folds into a few shifts and masks per pixel
+        for(uint32_t i = 0; i < count; i++) {
+            uint32_t color = 0;
+            memcpy(&color, in + i * istride, istride);
+            color = ConvertColorFormat(color, input, output);
+            memcpy(out + i * ostride, &color, ostride);
+        }
+    }
+
+    template <Format input>
+    struct ConvertFrom {
+        template <Format output>
+        struct To {
+            void operator()(const uint8_t* in, uint8_t* out, uint32_t count)
+            {
+                ConvertRun<input, output>(in, out, count);
+            }
+        };
+
+        void operator()(const uint8_t* in, uint8_t* out, uint32_t count, Format output)
+        {
+            static_format_lookup<To>(output, in, out, count);
+        }
+    };
+
+    void ConvertPixels(const uint8_t* in, uint8_t* out, uint32_t count, Format input, Format output)
+    {
+        if(input == output) {
+            memmove(out, in, count * GetFormatStride(input));
+            return;
+        }
+
+        static_format_lookup<ConvertFrom>(input, in, out, count, output);
+    }
+
+    void SwapRedBlue(uint8_t* pixels, uint32_t count)
+    {
+        for(uint32_t i = 0; i < count; i++) {
+            uint32_t pixel;
+            memcpy(&pixel, pixels + i * 4, sizeof(pixel));
+
+#if GRVL_BIG_ENDIAN
+            pixel = (pixel >> 8) | (pixel << 24);
+#else
+            pixel = (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+#endif
+
+            memcpy(pixels + i * 4, &pixel, sizeof(pixel));
+        }
+    }
+
+    template <uint32_t stride>
+    static void RotateBlocks(const uint8_t* in, uint8_t* out, uint32_t width, uint32_t height)
+    {
+        for(uint32_t blockY = 0; blockY < height; blockY += rotateBlock) {
+            const uint32_t endY = std::min(blockY + rotateBlock, height);
+
+            for(uint32_t blockX = 0; blockX < width; blockX += rotateBlock) {
+                const uint32_t endX = std::min(blockX + rotateBlock, width);
+
+                // column x of the input becomes row (width - x - 1) of the output
+                for(uint32_t x = blockX; x < endX; x++) {
+                    uint8_t* row = out + (width - x - 1) * height * stride;
+                    for(uint32_t y = blockY; y < endY; y++) {
+                        memcpy(row + y * stride, in + (y * width + x) * stride, stride);
+                    }
+                }
+            }
+        }
+    }
+
+    void RotatePixels90(const uint8_t* in, uint8_t* out, uint32_t width, uint32_t height, uint32_t stride)
+    {
+        switch(stride) {
+            case 1:
+                RotateBlocks<1>(in, out, width, height);
+                break;
+            case 2:
+                RotateBlocks<2>(in, out, width, height);
+                break;
+            case 3:
+                RotateBlocks<3>(in, out, width, height);
+                break;
+            case 4:
+                RotateBlocks<4>(in, out, width, height);
+                break;
+        }
+    }
+
+} /* namespace grvl */
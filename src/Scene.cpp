@@ -0,0 +1,151 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <grvl/Scene.h>
+#include <grvl/Endian.h>
+#include <grvl/grvl.h>
+
+#include <string.h>
+#include <vector>
+
+namespace grvl {
+
+    Scene::Scene(const uint8_t* data, size_t size)
+        : data(data)
+        , size(size)
+    {
+        if(!Parse()) {
+            Log(ERROR, "Scene at %p is invalid", data);
+        }
+    }
+
+    bool Scene::Parse()
+    {
+        if(!data || size < sizeof(SceneHeader)) {
+            return false;
+        }
+
+        SceneHeader header;
+        memcpy(&header, data, sizeof(header));
+
+        if(memcmp(header.magic, sceneMagic, sizeof(sceneMagic)) != 0) {
+            return false;
+        }
+
+        if(BigEndian32(header.version) != sceneVersion) {
+            Log(ERROR, "Scene has unknown version %d, it has to be compiled again", BigEndian32(header.version));
+            return false;
+        }
+
+        const uint64_t count = BigEndian32(header.elements);
+        const uint64_t attributeCount = BigEndian32(header.attributes);
+        const uint64_t stringsLength = BigEndian32(header.strings);
+        const uint64_t attributesStart = sizeof(header) + count * sizeof(SceneElement);
+        const uint64_t stringsStart = attributesStart + attributeCount * sizeof(SceneAttribute);
+        if(count == 0 || stringsStart + stringsLength > size || stringsLength == 0 || data[stringsStart + stringsLength - 1] != '\0') {
+            return false;
+        }
+
+        // the tables are read with memcpy, scenes in memory or bundles are not necessarily aligned
+        elements = data + sizeof(header);
+        elementCount = count;
+        attributes = data + attributesStart;
+
+        // elements are stored depth first, so children and siblings always come later, which rules out cycles
+        auto isLink = [count](uint32_t link, uint64_t index) { return link == sceneNone || (link > index && link < count); };
+
+        for(uint64_t i = 0; i < count; i++) {
+            const SceneElement element = GetElement(i);
+            const uint32_t text = BigEndian32(element.text);
+            const uint64_t firstAttribute = BigEndian32(element.firstAttribute);
+
+            if(BigEndian32(element.name) >= stringsLength || (text != sceneNone && text >= stringsLength)
+               || firstAttribute + BigEndian32(element.attributeCount) > attributeCount
+               || !isLink(BigEndian32(element.firstChild), i) || !isLink(BigEndian32(element.nextSibling), i)) {
+                elements = nullptr;
+                return false;
+            }
+        }
+
+        for(uint64_t i = 0; i < attributeCount; i++) {
+            const SceneAttribute attribute = GetAttribute(i);
+            if(BigEndian32(attribute.name) >= stringsLength || BigEndian32(attribute.value) >= stringsLength) {
+                elements = nullptr;
+                return false;
+            }
+        }
+
+        strings = reinterpret_cast<const char*>(data + stringsStart);
+        return true;
+    }
+
+    SceneElement Scene::GetElement(uint32_t index) const
+    {
+        SceneElement element;
+        memcpy(&element, elements + index * sizeof(SceneElement), sizeof(element));
+        return element;
+    }
+
+    SceneAttribute Scene::GetAttribute(uint32_t index) const
+    {
+        SceneAttribute attribute;
+        memcpy(&attribute, attributes + index * sizeof(SceneAttribute), sizeof(attribute));
+        return attribute;
+    }
+
+    const char* Scene::GetString(uint32_t offset) const
+    {
+        return strings + offset;
+    }
+
+    tinyxml2::XMLElement* Scene::Load(tinyxml2::XMLDocument& document) const
+    {
+        if(!IsValid()) {
+            return nullptr;
+        }
+
+        std::vector<tinyxml2::XMLElement*> nodes(elementCount);
+
+        for(uint32_t i = 0; i < elementCount; i++) {
+            const SceneElement element = GetElement(i);
+            tinyxml2::XMLElement* node = document.NewElement(GetString(BigEndian32(element.name)));
+
+            const uint32_t firstAttribute = BigEndian32(element.firstAttribute);
+            const uint32_t attributeCount = BigEndian32(element.attributeCount);
+            for(uint32_t a = firstAttribute; a < firstAttribute + attributeCount; a++) {
+                const SceneAttribute attribute = GetAttribute(a);
+                node->SetAttribute(GetString(BigEndian32(attribute.name)), GetString(BigEndian32(attribute.value)));
+            }
+
+            const uint32_t text = BigEndian32(element.text);
+            if(text != sceneNone) {
+                node->SetText(GetString(text));
+            }
+
+            nodes[i] = node;
+        }
+
+        for(uint32_t i = 0; i < elementCount; i++) {
+            for(uint32_t child = BigEndian32(GetElement(i).firstChild); child != sceneNone; child = BigEndian32(GetElement(child).nextSibling)) {
+                nodes[i]->InsertEndChild(nodes[child]);
+            }
+        }
+
+        document.InsertEndChild(nodes[0]);
+        return nodes[0];
+    }
+
+} /* namespace grvl */
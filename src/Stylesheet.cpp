@@ -0,0 +1,144 @@
+// Copyright 2026 Antmicro <antmicro.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <grvl/Stylesheet.h>
+#include <grvl/XMLSupport.h>
+
+#include <string.h>
+
+namespace grvl {
+
+    Stylesheet::Scope::Scope(Stylesheet& stylesheet)
+        : stylesheet(stylesheet)
+    {
+        stylesheet.scopes++;
+    }
+
+    Stylesheet::Scope::~Scope()
+    {
+        // blocks are keyed by the element, which may be freed once the scope ends
+        if(--stylesheet.scopes == 0) {
+            stylesheet.resolved.clear();
+        }
+    }
+
+    void Stylesheet::Parse(const char* text)
+    {
+        XMLSupport::ParseStylesheet(text, [this](const char* object, const char* attribute, const char* value) {
+            AddProperty(object, attribute, value);
+        });
+    }
+
+    void Stylesheet::AddProperty(const char* object, const char* attribute, const char* value)
+    {
+        resolved.clear();
+
+        Rules* rules = &widgetRules;
+        if(object[0] == '.') {
+            rules = &classRules;
+            object++;
+        } else if(object[0] == '#') {
+            rules = &idRules;
+            object++;
+        }
+
+        const char* name = Intern(attribute);
+        PropertyBlock& rule = (*rules)[Intern(object)];
+        for(Property& property : rule) {
+            if(property.name == name) {
+                property.value = Intern(value);
+                return;
+            }
+        }
+        rule.push_back({name, Intern(value)});
+    }
+
+    void Stylesheet::Clear()
+    {
+        widgetRules.clear();
+        classRules.clear();
+        idRules.clear();
+        resolved.clear();
+        strings.clear();
+    }
+
+    const char* Stylesheet::Find(const tinyxml2::XMLElement* element, const char* attributeName)
+    {
+        if(IsEmpty()) {
+            return nullptr;
+        }
+
+        // outside of a scope elements may be freed at any time, so nothing is kept for them
+        if(scopes == 0) {
+            return FindInBlock(Resolve(element), attributeName);
+        }
+
+        auto block = resolved.find(element);
+        if(block == resolved.end()) {
+            block = resolved.emplace(element, Resolve(element)).first;
+        }
+        return FindInBlock(block->second, attributeName);
+    }
+
+    Stylesheet::PropertyBlock Stylesheet::Resolve(const tinyxml2::XMLElement* element) const
+    {
+        PropertyBlock block;
+        Merge(block, idRules, element->Attribute("id"));
+        Merge(block, classRules, element->Attribute("class"));
+        Merge(block, widgetRules, element->Value());
+        return block;
+    }
+
+    const char* Stylesheet::Intern(const char* text)
+    {
+        return strings.emplace(text).first->c_str();
+    }
+
+    const char* Stylesheet::FindInBlock(const PropertyBlock& block, const char* attributeName)
+    {
+        for(const Property& property : block) {
+            if(strcmp(property.name, attributeName) == 0) {
+                return property.value;
+            }
+        }
+        return nullptr;
+    }
+
+    void Stylesheet::Merge(PropertyBlock& block, const Rules& rules, const char* name)
+    {
+        if(!name) {
+            return;
+        }
+
+        auto rule = rules.find(name);
+        if(rule == rules.end()) {
+            return;
+        }
+
+        const size_t inherited = block.size();
+        for(const Property& property : rule->second) {
+            bool present = false;
+            for(size_t i = 0; i < inherited && !present; i++) {
+                present = block[i].name == property.name;
+            }
+
+            if(!present) {
+                block.push_back(property);
+            }
+        }
+    }
+
+} /* namespace grvl */
@@ -22,31 +22,9 @@
 
 namespace grvl {
 
-    bool TryGetAttributeFromCollection(const std::unordered_map<std::string, char*>& collection, const char* key, const char* attributeName, const char** value)
-    {
-        if(!key) {
-            return false;
-        }
-
-        std::string collectionKey(key);
-        collectionKey.append("+");
-        collectionKey.append(attributeName);
-        auto search = collection.find(collectionKey);
-        if(search != collection.end()) {
-            *value = search->second;
-            return true;
-        }
-        return false;
-    }
-
     const char* GetAttributeFromStylesheet(XMLElement* element, const char* attributeName)
     {
-        const char* value;
-
-        if(TryGetAttributeFromCollection(Manager::GetInstance().idAttributes, element->Attribute("id"), attributeName, &value) || TryGetAttributeFromCollection(Manager::GetInstance().classAttributes, element->Attribute("class"), attributeName, &value) || TryGetAttributeFromCollection(Manager::GetInstance().widgetAttributes, element->Value(), attributeName, &value)) {
-            return value;
-        }
-        return NULL;
+        return Manager::GetInstance().stylesheet.Find(element, attributeName);
     }
 
     uint32_t XMLSupport::GetAttributeOrDefault(XMLElement* element, const char* attributeName, uint32_t defaultValue)
@@ -165,6 +143,76 @@ namespace grvl {
         return defaultValue;
     }
 
+    void XMLSupport::ParseStylesheet(const char* data, const StyleCallback& callback)
+    {
+        if(!data)
+            return;
+
+        size_t SIZE = 255;
+
+        char active_object[SIZE];
+        char active_parameter[SIZE];
+        char active_parameter_value[SIZE];
+        char active[SIZE];
+        int count = 0;
+        int level = 0;
+
+        while(data[0] != 0x0) {
+            switch(data[0]) {
+                case '{': {
+                    if(level != 0)
+                        break;
+                    strncpy(active_object, active, SIZE);
+                    count = 0;
+                    level++;
+                    break;
+                }
+                case ':': {
+                    if(level != 1)
+                        break;
+                    strncpy(active_parameter, active, SIZE);
+                    count = 0;
+                    level++;
+                    break;
+                }
+                case ';': {
+                    if(level == 2) {
+                        level--;
+                        strncpy(active_parameter_value, active, SIZE);
+                        callback(active_object, active_parameter, active_parameter_value);
+                    }
+                    count = 0;
+                    break;
+                }
+                case '}': {
+                    if(level == 2) {
+                        level--;
+                        strncpy(active_parameter_value, active, SIZE);
+                        callback(active_object, active_parameter, active_parameter_value);
+                    }
+                    if(level != 1)
+                        break;
+                    level--;
+                    count = 0;
+                    break;
+                }
+                case ' ':
+                case '\n':
+                case '\t': {
+                    count = 0;
+                    break;
+                }
+                default: {
+                    active[count++] = data[0];
+                    if(count > SIZE)
+                        return;
+                    active[count] = 0;
+                }
+            }
+            data++;
+        }
+    }
+
     static int atoi(const std::string& str)
     {
         int32_t n = 0;
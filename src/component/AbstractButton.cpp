@@ -43,11 +43,13 @@ namespace grvl {
     void AbstractButton::SetText(const char* text)
     {
         Text = std::string(text);
+        Invalidate();
     }
 
     void AbstractButton::SetImage(const Image& image)
     {
         ButtonImage = image;
+        Invalidate();
     }
 
     Font* AbstractButton::GetButtonFont()
@@ -58,11 +60,13 @@ namespace grvl {
     void AbstractButton::SetTextFont(Font* font)
     {
         ButtonFont = font;
+        Invalidate();
     }
 
     void AbstractButton::ClearButtonFont()
     {
         ButtonFont = 0;
+        Invalidate();
     }
 
     bool AbstractButton::IsEmpty() const
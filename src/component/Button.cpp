@@ -51,11 +51,13 @@ namespace grvl {
     void Button::SetIcoFont(Font* font)
     {
         IcoFont = font;
+        Invalidate();
     }
 
     void Button::ClearIcoFont()
     {
         IcoFont = NULL;
+        Invalidate();
     }
 
     Font* Button::GetIcoFont()
@@ -86,11 +88,13 @@ namespace grvl {
     void Button::SetIcoChar(int16_t textIco)
     {
         IcoChar = textIco;
+        Invalidate();
     }
 
     void Button::ClearIcoChar()
     {
         IcoChar = -1;
+        Invalidate();
     }
 
     void Button::InitFromXML(tinyxml2::XMLElement* xmlElement)
@@ -240,21 +244,25 @@ namespace grvl {
     void Button::SetTextColor(uint32_t color)
     {
         TextColor = color;
+        Invalidate();
     }
 
     void Button::SetActiveTextColor(uint32_t color)
     {
         ActiveTextColor = color;
+        Invalidate();
     }
 
     void Button::SetImagePosition(int32_t x, int32_t y)
     {
         ButtonImage.SetPosition(x, y);
+        Invalidate();
     }
 
     void Button::SetTextTopOffset(int32_t value)
     {
         TextTopOffset = value;
+        Invalidate();
     }
 
     uint32_t Button::GetTextColor()
@@ -275,11 +283,13 @@ namespace grvl {
     void Button::SetIcoColor(uint32_t color)
     {
         IcoColor = color;
+        Invalidate();
     }
 
     void Button::SetActiveIcoColor(uint32_t color)
     {
         ActiveIcoColor = color;
+        Invalidate();
     }
 
     uint32_t Button::GetIcoColor() const
@@ -295,6 +305,7 @@ namespace grvl {
     void Button::SetImageCentered(bool isCentered)
     {
         imageCentered = isCentered;
+        Invalidate();
     }
 
     void Button::SetSize(int32_t width, int32_t height)
@@ -302,27 +313,32 @@ namespace grvl {
         if(Width != width || Height != height) {
             Width = width;
             Height = height;
+            Invalidate();
         }
     }
 
     void Button::SetContentAlignment(HorizontalAlignment alignment)
     {
         ContentAlignment = alignment;
+        Invalidate();
     }
 
     void Button::SetContentLayoutMode(ButtonContentLayoutMode mode)
     {
         ContentLayoutMode = mode;
+        Invalidate();
     }
 
     void Button::SetImageTextGap(int32_t gap)
     {
         ImageTextGap = gap;
+        Invalidate();
     }
 
     void Button::SetHorizontalPadding(int32_t padding)
     {
         HorizontalPadding = padding;
+        Invalidate();
     }
 
     void Button::PopulateJavaScriptObject(JSObjectBuilder& jsObjectBuilder)
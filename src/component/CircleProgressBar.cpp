@@ -98,11 +98,13 @@ namespace grvl {
     void CircleProgressBar::SetStartAngle(float angle)
     {
         StartAngle = ConstrainAngle(angle);
+        Invalidate();
     }
 
     void CircleProgressBar::SetEndAngle(float angle)
     {
         EndAngle = ConstrainAngle(angle);
+        Invalidate();
     }
 
     float CircleProgressBar::GetStartAngle() const
@@ -118,23 +120,27 @@ namespace grvl {
     void CircleProgressBar::SetRadius(int32_t radius)
     {
         Radius = radius;
+        Invalidate();
     }
 
     void CircleProgressBar::SetThickness(int32_t thickness)
     {
         Thickness = thickness;
+        Invalidate();
     }
 
     void CircleProgressBar::SetColors(uint32_t start, uint32_t end)
     {
         StartColor = start;
         EndColor = end;
+        Invalidate();
     }
 
     void CircleProgressBar::SetColor(uint32_t color)
     {
         StartColor = color;
         EndColor = color;
+        Invalidate();
     }
 
     int32_t CircleProgressBar::GetRadius() const
@@ -18,6 +18,8 @@
 #include <grvl/Manager.h>
 #include <grvl/XMLSupport.h>
 
+#include <chrono>
+
 namespace grvl {
 
     void Clock::Start()
@@ -79,10 +81,20 @@ namespace grvl {
                 SetText(buf);
                 lastCurrentTime = current_time;
             }
+
+            // redraw when the next second begins
+            static constexpr auto msPerSecond = 1000;
+            auto sinceEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            Manager::RequestRedraw(grvl::Callbacks()->get_timestamp() + msPerSecond - sinceEpoch % msPerSecond);
         }
         Label::Draw(painter, ParentRenderX, ParentRenderY);
     }
 
+    bool Clock::IsDirty() const
+    {
+        return Label::IsDirty() || (isRunning && lastCurrentTime != time(NULL));
+    }
+
     void Clock::SetTimeFormat(const char* fmt)
     {
         if (!fmt) {
@@ -90,6 +102,7 @@ namespace grvl {
         }
 
         format = fmt;
+        Invalidate();
     }
 
     void Clock::PopulateJavaScriptObject(JSObjectBuilder& jsObjectBuilder)
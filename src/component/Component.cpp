@@ -24,51 +24,71 @@
 #include <grvl/grvl.h>
 
 #include <cassert>
+#include <strings.h>
 
 namespace grvl {
 
-    int ComponentCount = 0;
-    component_list_item list[];
-    static constexpr auto bufferSize = 80;
+    typedef Component* (*constructor_fun)(XMLElement*);
 
-    void* register_widget_constructor(void* con, char* nm)
+    struct WidgetConstructor {
+        constructor_fun fun;
+        std::string name;
+    };
+
+    // Widgets register during static initialization, so the registry is created on first use
+    static std::unordered_multimap<uint32_t, WidgetConstructor>& GetWidgetRegistry()
+    {
+        static std::unordered_multimap<uint32_t, WidgetConstructor> registry;
+        return registry;
+    }
+
+    static const WidgetConstructor* FindWidgetConstructor(const char* nm, uint32_t hash)
     {
-        char nm_lower[bufferSize];
-        strncpy(nm_lower, nm, bufferSize);
-        string_to_lower(nm_lower);
-        int i;
-        for(i = 0; i < ComponentCount; i++)
-            if(strcmp(nm_lower, list[i].name) == 0)
-                return NULL;
-        ComponentCount++;
-        list[ComponentCount - 1].fun = con;
-        strncpy(list[ComponentCount - 1].name, nm_lower, bufferSize);
+        // different names may share a hash, so the name is compared as well
+        auto range = GetWidgetRegistry().equal_range(hash);
+        for(auto it = range.first; it != range.second; ++it) {
+            if(strcasecmp(it->second.name.c_str(), nm) == 0) {
+                return &it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    void* register_widget_constructor(void* con, const char* nm, uint32_t hash)
+    {
+        if(!FindWidgetConstructor(nm, hash)) {
+            std::string name(nm);
+            string_to_lower(name);
+            GetWidgetRegistry().emplace(hash, WidgetConstructor {(constructor_fun)con, name});
+        }
         return NULL;
     }
 
-    typedef Component* (*constructor_fun)(XMLElement*);
+    void* register_widget_constructor(void* con, char* nm)
+    {
+        return register_widget_constructor(con, nm, HashWidgetName(nm));
+    }
 
     Component* create_component(const char* nm, void* el)
     {
-        char nm_lower[bufferSize];
-        strncpy(nm_lower, nm, bufferSize);
-        string_to_lower(nm_lower);
-        int i;
-        for(i = 0; i < ComponentCount; i++) {
-            if(strcmp(nm_lower, list[i].name) == 0) {
-                constructor_fun fun = (constructor_fun)(list[i].fun);
-                return fun((XMLElement*)el);
-            }
+        if(const WidgetConstructor* constructor = FindWidgetConstructor(nm, HashWidgetName(nm))) {
+            return constructor->fun((XMLElement*)el);
         }
 
-        Log(ERROR, "Widget of type %s does not exist!", nm_lower);
-        for(i = 0; i < ComponentCount; i++) {
-            Log(ERROR, " -- We have %d : %s", i, list[i].name);
+        Log(ERROR, "Widget of type %s does not exist!", nm);
+        int i = 0;
+        for(const auto& entry : GetWidgetRegistry()) {
+            Log(ERROR, " -- We have %d : %s", i++, entry.second.name.c_str());
         }
 
         return nullptr;
     }
 
+    bool component_exists(const char* nm)
+    {
+        return FindWidgetConstructor(nm, HashWidgetName(nm)) != nullptr;
+    }
+
     uint64_t Component::AssignUniqueID()
     {
         return firstAvailableUniqueID++;
@@ -123,6 +143,7 @@ namespace grvl {
         longTouchActive = other.longTouchActive;
         onLongPress = other.onLongPress;
         onLongPressRepeat = other.onLongPressRepeat;
+        Dirty = true;
 
         onPress.SetSenderPointer(this);
         onRelease.SetSenderPointer(this);
@@ -136,7 +157,7 @@ namespace grvl {
     Component::~Component()
     {
         if (JavascriptObject != nullptr) {
-            JSEngine::ForgetObject(JavascriptObject);
+            JSEngine::ForgetObject(JavascriptObjectSlot, JavascriptObjectHeap);
         }
     }
 
@@ -171,26 +192,31 @@ namespace grvl {
         if(X != x || Y != y) {
             X = x;
             Y = y;
+            Invalidate();
         }
     }
     void Component::SetX(int32_t x)
     {
         X = x;
+        Invalidate();
     }
 
     void Component::SetY(int32_t y)
     {
         Y = y;
+        Invalidate();
     }
 
     void Component::SetWidth(int32_t width)
     {
         Width = width;
+        Invalidate();
     }
 
     void Component::SetHeight(int32_t height)
     {
         Height = height;
+        Invalidate();
     }
 
     uint32_t Component::GetBackgroundColor() const
@@ -206,21 +232,25 @@ namespace grvl {
     void Component::SetForegroundColor(uint32_t color)
     {
         ForegroundColor = color;
+        Invalidate();
     }
 
     void Component::SetBackgroundColor(uint32_t color)
     {
         BackgroundColor = color;
+        Invalidate();
     }
 
     void Component::SetActiveBackgroundColor(uint32_t color)
     {
         ActiveBackgroundColor = color;
+        Invalidate();
     }
 
     void Component::SetActiveForegroundColor(uint32_t color)
     {
         ActiveForegroundColor = color;
+        Invalidate();
     }
 
     uint32_t Component::GetActiveBackgroundColor() const
@@ -236,26 +266,31 @@ namespace grvl {
     void Component::SetBorderColor(uint32_t color)
     {
         BorderColor = color;
+        Invalidate();
     }
 
     void Component::SetActiveBorderColor(uint32_t color)
     {
         ActiveBorderColor = color;
+        Invalidate();
     }
 
     void Component::SetBorderType(BorderTypeBits type)
     {
         BorderType = type;
+        Invalidate();
     }
 
     void Component::SetBorderArcRadius(uint32_t radius)
     {
         BorderArcRadius = radius;
+        Invalidate();
     }
 
     void Component::SetVisible(bool state)
     {
         Visible = state;
+        Invalidate();
     }
     bool Component::IsVisible() const
     {
@@ -265,11 +300,13 @@ namespace grvl {
     void Component::Hide()
     {
         Visible = false;
+        Invalidate();
     }
 
     void Component::Show()
     {
         Visible = true;
+        Invalidate();
     }
 
     uint32_t Component::GetCurrentBackgroundColor()
@@ -322,6 +359,7 @@ namespace grvl {
         if(Width != width || Height != height) {
             Width = width;
             Height = height;
+            Invalidate();
         }
     }
 
@@ -406,7 +444,7 @@ namespace grvl {
             if(onLongPress.IsSet()) {
                 longTouchActive = true;
                 TouchActivatedTimestamp = grvl::Callbacks()->get_timestamp();
-                Manager::GetInstance().GetEventsQueueInstance().push(&onLongPress);
+                Manager::GetInstance().QueueEvent(&onLongPress);
             } else {
                 return Touch::TouchReleased;
             }
@@ -415,7 +453,7 @@ namespace grvl {
         static constexpr auto longpressRepeatOffset = 500;
         if(longTouchActive && TouchActivatedTimestamp < (grvl::Callbacks()->get_timestamp() - longpressRepeatOffset)) { // Long press repeat
             TouchActivatedTimestamp = grvl::Callbacks()->get_timestamp();
-            Manager::GetInstance().GetEventsQueueInstance().push(&onLongPressRepeat);
+            Manager::GetInstance().QueueEvent(&onLongPressRepeat);
         }
 
         if(longTouchActive) {
@@ -426,7 +464,26 @@ namespace grvl {
 
     void Component::SetState(ComponentState state)
     {
-        State = state;
+        if(State != state) {
+            State = state;
+            Invalidate();
+        }
+    }
+
+    void Component::Invalidate()
+    {
+        Dirty = true;
+        Manager::RequestRedraw();
+    }
+
+    bool Component::IsDirty() const
+    {
+        return Dirty;
+    }
+
+    void Component::ClearDirty()
+    {
+        Dirty = false;
     }
 
     Component::ComponentState Component::GetState()
@@ -437,21 +494,23 @@ namespace grvl {
     void Component::OnPress()
     {
         State = On;
+        Invalidate();
         TouchActivatedTimestamp = grvl::Callbacks()->get_timestamp();
-        Manager::GetInstance().GetEventsQueueInstance().push(&onPress);
+        Manager::GetInstance().QueueEvent(&onPress);
     }
 
     void Component::OnRelease()
     {
         State = Off;
+        Invalidate();
         TouchActivatedTimestamp = 0;
         longTouchActive = false;
-        Manager::GetInstance().GetEventsQueueInstance().push(&onRelease);
+        Manager::GetInstance().QueueEvent(&onRelease);
     }
 
     void Component::OnClick()
     {
-        Manager::GetInstance().GetEventsQueueInstance().push(&onClick);
+        Manager::GetInstance().QueueEvent(&onClick);
     }
 
     void Component::SetOnPressEvent(const Event& event)
@@ -558,16 +617,31 @@ namespace grvl {
 
     void Component::PushJSObjectOnStack(duk_context* ctx)
     {
-        if (JavascriptObject != nullptr) {
+        // objects created in a previous heap are gone, a new one is created
+        if (JavascriptObject != nullptr && JavascriptObjectHeap == JSEngine::GetHeapGeneration()) {
             duk_push_heapptr(ctx, JavascriptObject);
             return;
         }
         JSObjectBuilder jsObjectBuilder{ctx, this};
         JavascriptObject = duk_get_heapptr(ctx, -1);
-        JSEngine::RememberObject(JavascriptObject);
+        JavascriptObjectSlot = JSEngine::RememberObject(JavascriptObject);
+        JavascriptObjectHeap = JSEngine::GetHeapGeneration();
         PopulateJavaScriptObject(jsObjectBuilder);
     }
 
+    void Component::TakeJavaScriptObject(Component& other)
+    {
+        if(!other.JavascriptObject || JavascriptObject) {
+            return;
+        }
+
+        JavascriptObject = other.JavascriptObject;
+        JavascriptObjectSlot = other.JavascriptObjectSlot;
+        JavascriptObjectHeap = other.JavascriptObjectHeap;
+        other.JavascriptObject = nullptr;
+        JSEngine::RetargetObject(JavascriptObject, this);
+    }
+
     void Component::PopulateJavaScriptObject(JSObjectBuilder& jsObjectBuilder)
     {
         jsObjectBuilder.AddProperty("name", Component::JSGetIDWrapper);
@@ -69,6 +69,7 @@ namespace grvl {
     void Graph::SetHorizontalPadding(uint32_t horizontalPadding)
     {
         HorizontalPadding = horizontalPadding;
+        Invalidate();
     }
 
     void Graph::SetVerticalPadding(uint32_t verticalPadding)
@@ -80,26 +81,31 @@ namespace grvl {
     void Graph::SetTopPadding(uint32_t topPadding)
     {
         TopPadding = topPadding;
+        Invalidate();
     }
 
     void Graph::SetBottomPadding(uint32_t bottomPadding)
     {
         BottomPadding = bottomPadding;
+        Invalidate();
     }
 
     void Graph::SetTextVerticalOffset(uint32_t textVerticalOffset)
     {
         TextVerticalOffset = textVerticalOffset;
+        Invalidate();
     }
 
     void Graph::SetTextColor(uint32_t textColor)
     {
         TextColor = textColor;
+        Invalidate();
     }
 
     void Graph::SetTextFont(Font* font)
     {
         TextFont = font;
+        Invalidate();
     }
 
     void Graph::AddData(float value)
@@ -109,6 +115,7 @@ namespace grvl {
         graphData.emplace_back(value);
 
         cubicSpline = CubicSplineInterpolation(graphData);
+        Invalidate();
     }
 
     void Graph::ClearData()
@@ -118,6 +125,7 @@ namespace grvl {
 
         graphData.clear();
         cubicSpline = CubicSpline{};
+        Invalidate();
     }
 
     // From https://en.wikipedia.org/wiki/Spline_(mathematics)#Algorithm_for_computing_natural_cubic_splines
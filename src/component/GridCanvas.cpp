@@ -35,11 +35,13 @@ namespace grvl {
     void GridCanvas::SetHorizontalGridElementWidth(int32_t width)
     {
         horizontalGridElementWidth = width;
+        Invalidate();
     }
 
     void GridCanvas::SetHorizontalGridElementHeight(int32_t height)
     {
         horizontalGridElementHeight = height;
+        Invalidate();
     }
 
     void GridCanvas::Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY)
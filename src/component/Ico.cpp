@@ -36,6 +36,7 @@ namespace grvl {
         if(IcoFont) {
             AdjustSize();
         }
+        Invalidate();
     }
 
     Font* Ico::GetIcoFont() const
@@ -49,6 +50,7 @@ namespace grvl {
         if(IcoChar) {
             AdjustSize();
         }
+        Invalidate();
     }
 
     void Ico::Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY)
@@ -33,6 +33,7 @@ namespace grvl {
         if(content && activeFrame < content->GetNumberOfFrames()) {
             ActiveFrame = activeFrame;
             LastFrameChange = std::chrono::steady_clock::now();
+            Invalidate();
         }
     }
 
@@ -67,6 +68,35 @@ namespace grvl {
         ActiveFrame = 0;
         AnimationEnabled = true;
         LastFrameChange = std::chrono::steady_clock::now();
+        Invalidate();
+    }
+
+    bool Image::isNextFrameDue() const
+    {
+        if (!IsAnimationEnabled()) {
+            return false;
+        }
+
+        const uint32_t duration = Delegate->Get()->GetFrameDuration(ActiveFrame);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - LastFrameChange).count();
+
+        return duration != 0 && elapsed >= duration;
+    }
+
+    void Image::requestNextFrame() const
+    {
+        if (!IsAnimationEnabled()) {
+            return;
+        }
+
+        const uint32_t duration = Delegate->Get()->GetFrameDuration(ActiveFrame);
+        if (duration == 0) {
+            return;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - LastFrameChange).count();
+        uint64_t remaining = elapsed < duration ? duration - elapsed : 0;
+        Manager::RequestRedraw(grvl::Callbacks()->get_timestamp() + remaining);
     }
 
     void Image::updateAnimation()
@@ -108,6 +138,11 @@ namespace grvl {
         Image* result = new Image();
         result->InitFromXML(xmlElement);
 
+        result->SetScaledSize(result->GetWidth(), result->GetHeight());
+        if(XMLSupport::TryGetAttribute(xmlElement, "filter", &name)) {
+            result->SetFilter(strcmp(name, "nearest") == 0 ? ImageFilter::Nearest : ImageFilter::Bilinear);
+        }
+
         if(XMLSupport::TryGetAttribute(xmlElement, "contentId", &name)) {
             man->BindImageContentToImage(name, result);
         }
@@ -121,8 +156,13 @@ namespace grvl {
         ImageContent* content = GetContent();
         if (content == nullptr) return;
 
-        int w = content->GetWidth();
-        int h = content->GetHeight();
+        const ImageRegion region = Delegate->GetRegion();
+        if (region.width <= 0 || region.height <= 0) {
+            return;
+        }
+
+        int w = ScaledWidth ? ScaledWidth : (ScaledHeight ? region.width * ScaledHeight / region.height : region.width);
+        int h = ScaledHeight ? ScaledHeight : (ScaledWidth ? region.height * ScaledWidth / region.width : region.height);
         SetSize(w, h);
 
         if (w <= 0 || h <= 0) {
@@ -133,7 +173,26 @@ namespace grvl {
         int32_t RenderY = ParentRenderY + Y;
 
         updateAnimation();
-        painter.DrawImage(RenderX, RenderY, content, ActiveFrame);
+        painter.DrawScaledImage(RenderX, RenderY, w, h, content, ActiveFrame, region, Filter);
+        requestNextFrame();
+    }
+
+    void Image::SetScaledSize(int32_t width, int32_t height)
+    {
+        ScaledWidth = width;
+        ScaledHeight = height;
+        Invalidate();
+    }
+
+    void Image::SetFilter(ImageFilter filter)
+    {
+        Filter = filter;
+        Invalidate();
+    }
+
+    bool Image::IsDirty() const
+    {
+        return Component::IsDirty() || isNextFrameDue();
     }
 
     bool Image::IsEmpty() const
@@ -147,6 +206,7 @@ namespace grvl {
         Width = 0;
         Height = 0;
         Delegate = nullptr;
+        Invalidate();
     }
 
     void Image::ReplaceDelegate(const std::shared_ptr<ImageDelegate>& delegate)
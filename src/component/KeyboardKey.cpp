@@ -73,21 +73,25 @@ namespace grvl {
     void KeyboardKey::SetSecondaryText(const char* text)
     {
         secondaryText = text;
+        Invalidate();
     }
 
     void KeyboardKey::SetSecondaryTextFont(Font* font)
     {
         secondaryTextFont = font;
+        Invalidate();
     }
 
     void KeyboardKey::SetSecondaryTextColor(uint32_t color)
     {
         secondaryTextColor = color;
+        Invalidate();
     }
 
     void KeyboardKey::SetActiveSecondaryTextColor(uint32_t color)
     {
         activeSecondaryTextColor = color;
+        Invalidate();
     }
 
     const char* KeyboardKey::GetSecondaryText()
@@ -102,6 +106,7 @@ namespace grvl {
         }
 
         currentTextValueIndex = (currentTextValueIndex + 1) % 2;
+        Invalidate();
     }
 
     void KeyboardKey::DrawText(Painter& painter, int32_t RenderX, int32_t RenderY, int32_t RenderWidth, int32_t RenderHeight)
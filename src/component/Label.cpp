@@ -26,6 +26,7 @@ namespace grvl {
     void Label::SetTextColor(uint32_t color)
     {
         TextColor = color;
+        Invalidate();
     }
 
     Component* Label::Clone() const
@@ -36,11 +37,13 @@ namespace grvl {
     void Label::SetText(const char* text)
     {
         Text = std::string(text);
+        Invalidate();
     }
 
     void Label::SetHorizontalAlignment(HorizontalAlignment alignment)
     {
         TextHorizontalAlignment = alignment;
+        Invalidate();
     }
 
     HorizontalAlignment Label::GetMode()
@@ -115,6 +118,7 @@ namespace grvl {
     void Label::SetTextFont(Font* font)
     {
         TextFont = font;
+        Invalidate();
     }
 
     Font* Label::GetTextFont()
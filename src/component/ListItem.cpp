@@ -162,6 +162,7 @@ namespace grvl {
             return;
         }
         Description = std::string(desc);
+        Invalidate();
     }
 
     void ListItem::SetDescriptionFont(Font* font)
@@ -170,21 +171,25 @@ namespace grvl {
             return;
         }
         DescriptionFont = font;
+        Invalidate();
     }
 
     void ListItem::SetType(ItemType type)
     {
         Type = type;
+        Invalidate();
     }
 
     void ListItem::SetDescriptionColor(uint32_t color)
     {
         DescriptionColor = color;
+        Invalidate();
     }
 
     void ListItem::SetActiveDescriptionColor(uint32_t color)
     {
         ActiveDescriptionColor = color;
+        Invalidate();
     }
 
     uint32_t ListItem::GetDescriptionColor() const
@@ -273,6 +278,7 @@ namespace grvl {
     void ListItem::SetAdditionalImage(const Image& image)
     {
         AdditionalImge = image;
+        Invalidate();
     }
 
     Image* ListItem::GetAdditionalImagePointer()
@@ -316,6 +322,7 @@ namespace grvl {
     void ListItem::SetRoundingImage(const Image& image)
     {
         roundingImage = image;
+        Invalidate();
     }
 
     Image* ListItem::GetRoundingImagePointer()
@@ -31,6 +31,7 @@ namespace grvl {
             value = progressMax;
         }
         ProgressValue = value;
+        Invalidate();
     }
 
     int32_t ProgressBar::GetProgressValue() const
@@ -30,6 +30,7 @@ namespace grvl {
     void Slider::SetScrollImage(const Image& image)
     {
         ScrollImage = image;
+        Invalidate();
     }
 
     Image* Slider::GetScrollImagePointer()
@@ -40,21 +41,25 @@ namespace grvl {
     void Slider::SetBarColor(uint32_t color)
     {
         BarColor = color;
+        Invalidate();
     }
 
     void Slider::SetScrollColor(uint32_t color)
     {
         ScrollColor = color;
+        Invalidate();
     }
 
     void Slider::SetActiveScrollColor(uint32_t color)
     {
         ActiveScrollColor = color;
+        Invalidate();
     }
 
     void Slider::SetFrameColor(uint32_t color)
     {
         FrameColor = color;
+        Invalidate();
     }
 
 #define EPSILON 2.2204460492503131e-16
@@ -73,11 +78,13 @@ namespace grvl {
     {
         Value = value;
         MinValue = value;
+        Invalidate();
     }
 
     void Slider::SetMaxValue(float value)
     {
         MaxValue = value;
+        Invalidate();
     }
 
     void Slider::SetValue(float value)
@@ -86,6 +93,7 @@ namespace grvl {
             Value = value;
             Position = ValueToPosition(Value);
         }
+        Invalidate();
     }
 
     void Slider::SetDivision(uint8_t value)
@@ -95,6 +103,7 @@ namespace grvl {
         }
         division = value;
         CalculateStep();
+        Invalidate();
     }
 
     void Slider::CalculateStep()
@@ -105,6 +114,7 @@ namespace grvl {
     void Slider::SetTextFont(Font* font)
     {
         SliderFont = font;
+        Invalidate();
     }
 
     void Slider::SetLimiters(float const array[], uint8_t size)
@@ -116,6 +126,7 @@ namespace grvl {
         MinValue = 0;
         MaxValue = size - 1.0;
         ScaleType = SliderScaleType::LIST;
+        Invalidate();
     }
 
     uint32_t Slider::GetBarColor() const
@@ -348,6 +359,7 @@ namespace grvl {
     void Slider::SetSelectedFrameColor(uint32_t color)
     {
         SelectedFrameColor = color;
+        Invalidate();
     }
 
     uint32_t Slider::GetSelectedFrameColor() const
@@ -419,7 +431,7 @@ namespace grvl {
         PreviousValueUpdateTimestamp = 0;
         if(onValueChange.IsSet() && ReportedValue != Value) {
             ReportedValue = Value;
-            Manager::GetInstance().GetEventsQueueInstance().push(&onValueChange);
+            Manager::GetInstance().QueueEvent(&onValueChange);
         }
         Component::OnRelease();
     }
@@ -501,13 +513,16 @@ namespace grvl {
             tempVal = MinValue;
         }
 
-        Position = ValueToPosition(tempVal);
-        Value = tempVal;
+        if(Value != tempVal) {
+            Position = ValueToPosition(tempVal);
+            Value = tempVal;
+            Invalidate();
+        }
 
         if(onValueChange.IsSet() && Value != ReportedValue && PreviousValueUpdateTimestamp < (grvl::Callbacks()->get_timestamp() - 400)) { // Report time
             PreviousValueUpdateTimestamp = grvl::Callbacks()->get_timestamp();
             ReportedValue = Value;
-            Manager::GetInstance().GetEventsQueueInstance().push(&onValueChange);
+            Manager::GetInstance().QueueEvent(&onValueChange);
         }
 
         return Touch::TouchHandled;
@@ -547,6 +562,7 @@ namespace grvl {
     void Slider::SetActiveBarColor(uint32_t color)
     {
         ActiveBarColor = color;
+        Invalidate();
     }
 
     uint32_t Slider::GetActiveBarColor() const
@@ -562,6 +578,7 @@ namespace grvl {
     void Slider::SetSliderType(SliderScaleType value)
     {
         ScaleType = value;
+        Invalidate();
     }
 
     bool Slider::GetKeepBoundaries() const
@@ -130,9 +130,9 @@ namespace grvl {
     {
         if(previousSwitchState != switchState) {
             if(switchState) {
-                Manager::GetInstance().GetEventsQueueInstance().push(&onSwitchON);
+                Manager::GetInstance().QueueEvent(&onSwitchON);
             } else {
-                Manager::GetInstance().GetEventsQueueInstance().push(&onSwitchOFF);
+                Manager::GetInstance().QueueEvent(&onSwitchOFF);
             }
         }
         Component::OnRelease();
@@ -144,11 +144,12 @@ namespace grvl {
         if(previousSwitchState == switchState) {
             if(!switchState) {
                 switchState = true;
-                Manager::GetInstance().GetEventsQueueInstance().push(&onSwitchON);
+                Manager::GetInstance().QueueEvent(&onSwitchON);
             } else if(switchState) {
                 switchState = false;
-                Manager::GetInstance().GetEventsQueueInstance().push(&onSwitchOFF);
+                Manager::GetInstance().QueueEvent(&onSwitchOFF);
             }
+            Invalidate();
         }
         Component::OnClick();
     }
@@ -156,6 +157,7 @@ namespace grvl {
     void SwitchButton::SetSwitchState(bool state)
     {
         switchState = state;
+        Invalidate();
     }
 
     bool SwitchButton::GetSwitchState() const
@@ -166,16 +168,19 @@ namespace grvl {
     void SwitchButton::SetStateIndicatorWidth(uint32_t value)
     {
         stateIndicatorWidth = value;
+        Invalidate();
     }
 
     void SwitchButton::SetStateIndicatorHeight(uint32_t value)
     {
         stateIndicatorHeight = value;
+        Invalidate();
     }
 
     void SwitchButton::SetStateIndicatorArcRadius(uint32_t value)
     {
         stateIndicatorArcRadius = value;
+        Invalidate();
     }
 
     SwitchButton* SwitchButton::BuildFromXML(XMLElement* xmlElement)
@@ -211,6 +216,7 @@ namespace grvl {
     Touch::TouchResponse SwitchButton::ProcessMove(int32_t StartX, int32_t StartY, int32_t DeltaX, int32_t DeltaY)
     {
         Touch::TouchResponse res = Touch::TouchHandled;
+        const bool movedFromState = switchState;
 
         if(!previousSwitchState) {
             if(StartX < Width / 2 && DeltaX > Width / 2) {
@@ -236,6 +242,10 @@ namespace grvl {
             } // Ignore slide
         }
 
+        if(switchState != movedFromState) {
+            Invalidate();
+        }
+
         return res;
     }
 
@@ -85,6 +85,7 @@ namespace grvl {
     void TextInput::SetBasicText(const char* text)
     {
         basicText = text;
+        Invalidate();
     }
 
     void TextInput::OnClick()
@@ -98,13 +99,15 @@ namespace grvl {
     void TextInput::AddCharacter(char character)
     {
         Text += character;
-        Manager::GetInstance().GetEventsQueueInstance().push(&onTextInput);
+        Manager::GetInstance().QueueEvent(&onTextInput);
+        Invalidate();
     }
 
     void TextInput::Append(const char* text)
     {
         Text += text;
-        Manager::GetInstance().GetEventsQueueInstance().push(&onTextInput);
+        Manager::GetInstance().QueueEvent(&onTextInput);
+        Invalidate();
     }
 
     void TextInput::RemoveLastCharacter()
@@ -119,23 +122,26 @@ namespace grvl {
         }
         Text.erase(pos);
 
-        Manager::GetInstance().GetEventsQueueInstance().push(&onTextInput);
+        Manager::GetInstance().QueueEvent(&onTextInput);
+        Invalidate();
     }
 
     void TextInput::Clear()
     {
         Text.clear();
-        Manager::GetInstance().GetEventsQueueInstance().push(&onTextInput);
+        Manager::GetInstance().QueueEvent(&onTextInput);
+        Invalidate();
     }
 
     void TextInput::Submit()
     {
-        Manager::GetInstance().GetEventsQueueInstance().push(&onSubmit);
+        Manager::GetInstance().QueueEvent(&onSubmit);
     }
 
     void TextInput::SetType(InputType type)
     {
         this->type = type;
+        Invalidate();
     }
 
     const char* TextInput::GetType() const
@@ -146,6 +152,7 @@ namespace grvl {
     void TextInput::SetType(const char* type)
     {
         this->type = type;
+        Invalidate();
     }
 
     size_t TextInput::GetUTF8CharacterCount() const
@@ -19,6 +19,7 @@
 #include <grvl/Manager.h>
 #include <grvl/XMLSupport.h>
 
+#include <algorithm>
 #include <cassert>
 
 namespace grvl {
@@ -73,6 +74,31 @@ namespace grvl {
     void Container::SetBackgroundImage(Image* image)
     {
         BackgroundImage = image;
+        Invalidate();
+    }
+
+    bool Container::IsDirty() const
+    {
+        if(Component::IsDirty()) {
+            return true;
+        }
+
+        for(const auto* element : Elements) {
+            if(element->IsVisible() && element->IsDirty()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Container::ClearDirty()
+    {
+        Component::ClearDirty();
+
+        for(auto* element : Elements) {
+            element->ClearDirty();
+        }
     }
 
     void Container::SetAsSelection(bool value)
@@ -138,6 +164,16 @@ namespace grvl {
         Elements.emplace_back(el);
     }
 
+    void Container::ReplaceElements(const std::vector<Component*>& elements)
+    {
+        if(lastActiveChild && std::find(elements.begin(), elements.end(), lastActiveChild) == elements.end()) {
+            lastActiveChild = nullptr;
+        }
+
+        Elements = elements;
+        Invalidate();
+    }
+
     void Container::RemoveElement(const char* elementId)
     {
         Component* foundComponent{nullptr};
@@ -149,6 +185,7 @@ namespace grvl {
                 }
                 Elements.erase(Elements.begin() + index);
                 delete foundComponent;
+                Invalidate();
                 return;
             }
         }
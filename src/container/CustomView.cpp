@@ -165,7 +165,7 @@ namespace grvl {
             if(onLongPress.IsSet()) {
                 longTouchActive = true;
                 TouchActivatedTimestamp = grvl::Callbacks()->get_timestamp();
-                Manager::GetInstance().GetEventsQueueInstance().push(&onLongPress);
+                Manager::GetInstance().QueueEvent(&onLongPress);
             } else {
                 return Touch::TouchReleased;
             }
@@ -173,7 +173,7 @@ namespace grvl {
         static constexpr auto longPressRepeatDelay = 500;
         if(longTouchActive && TouchActivatedTimestamp < (grvl::Callbacks()->get_timestamp() - longPressRepeatDelay)) { // Long press repeat
             TouchActivatedTimestamp = grvl::Callbacks()->get_timestamp();
-            Manager::GetInstance().GetEventsQueueInstance().push(&onLongPressRepeat);
+            Manager::GetInstance().QueueEvent(&onLongPressRepeat);
         }
 
         if(longTouchActive) {
@@ -186,12 +186,12 @@ namespace grvl {
                 if(tp.GetState() != Touch::Released && abs(tp.GetDeltaY()) < Height / deltaOffsetScale
                    && abs(tp.GetDeltaX()) > Width / deltaOffsetScale) {
                     if(tp.GetDeltaX() > 0 && abs(tp.GetDeltaX()) > abs(tp.GetDeltaY())) {
-                        Manager::GetInstance().GetEventsQueueInstance().push(&onSlideToLeft);
+                        Manager::GetInstance().QueueEvent(&onSlideToLeft);
                         touchActive = false;
                         return Touch::TouchReleased;
                     }
                     if(tp.GetDeltaX() < 0 && abs(tp.GetDeltaX()) > abs(tp.GetDeltaY())) {
-                        Manager::GetInstance().GetEventsQueueInstance().push(&onSlideToRight);
+                        Manager::GetInstance().QueueEvent(&onSlideToRight);
                         touchActive = false;
                         return Touch::TouchReleased;
                     }
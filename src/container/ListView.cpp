@@ -16,8 +16,11 @@
 
 #include <grvl/component/Image.h>
 #include <grvl/container/ListView.h>
+#include <grvl/JSEngine.h>
 #include <grvl/Manager.h>
 
+#include <algorithm>
+
 namespace grvl {
 
     ListView* ListView::BuildFromXML(XMLElement* xmlElement)
@@ -34,6 +37,14 @@ namespace grvl {
 
         parent->InitFromXML(xmlElement);
 
+        const char* itemTemplate = xmlElement->Attribute("itemTemplate");
+        if(itemTemplate) {
+            parent->SetDataSource(itemTemplate,
+                                  XMLSupport::GetAttributeOrDefault(xmlElement, "itemCount", (uint32_t)0),
+                                  XMLSupport::ParseCallback(xmlElement->Attribute("onBindItem")).functionName);
+            return parent;
+        }
+
         XMLElement* child = xmlElement->FirstChildElement();
         for(; child != NULL; child = child->NextSiblingElement()) {
             // TODO: we should verify the correct class
@@ -63,6 +74,55 @@ namespace grvl {
             ScrollMax = 0;
         }
 
+        UpdateScrollIndicator();
+
+        Elements.push_back(component);
+    }
+
+    void ListView::Draw(Painter& painter, int32_t ParentRenderX, int32_t ParentRenderY)
+    {
+        ApplyRequestedChanges();
+
+        beingDrawn = true;
+        VerticalScrollView::Draw(painter, ParentRenderX, ParentRenderY);
+        beingDrawn = false;
+    }
+
+    bool ListView::IsBeingDrawn() const
+    {
+        // Only the drawing thread sets the flag
+        return Manager::IsDrawingThread() && beingDrawn;
+    }
+
+    void ListView::ApplyRequestedChanges()
+    {
+        // The list isn't locked before it's drawn, so the calls below apply the changes right away
+        if(clearRequested) {
+            clearRequested = false;
+            ClearList();
+        }
+
+        if(requestedItemTemplate) {
+            std::unique_ptr<Component> itemTemplate = std::move(requestedItemTemplate);
+            ListDataSource source = std::move(requestedDataSource);
+            requestedDataSource = ListDataSource {};
+            SetDataSource(*itemTemplate, source);
+        }
+
+        if(requestedItemCount) {
+            uint32_t count = *requestedItemCount;
+            requestedItemCount.reset();
+            SetItemCount(count);
+        }
+
+        if(refreshRequested) {
+            refreshRequested = false;
+            Refresh();
+        }
+    }
+
+    void ListView::UpdateScrollIndicator()
+    {
         // Prepare scroll image
         if(scrollingEnabled && ScrollMax > 0) {
             static constexpr auto minSWitdth = 10;
@@ -77,8 +137,6 @@ namespace grvl {
 
             scrollIndicatorImage = new ImageContent(sWidth, sHeight);
         }
-
-        Elements.push_back(component);
     }
 
     void ListView::RemoveElement(const char* elementId)
@@ -121,6 +179,15 @@ namespace grvl {
 
     void ListView::ClearList()
     {
+        if(IsBeingDrawn()) {
+            clearRequested = true;
+            refreshRequested = false;
+            requestedItemCount.reset();
+            requestedItemTemplate.reset();
+            Manager::RequestRedrawAfterFrame();
+            return;
+        }
+
         Guard touch_lock {ClearWhileTouchMutex};
         Guard draw_lock {ClearWhileDrawMutex};
 
@@ -130,11 +197,23 @@ namespace grvl {
             it = Elements.erase(it);
         }
 
+        itemTemplate.reset();
+        dataSource = ListDataSource {};
+        itemOffsets.clear();
+        boundItems.clear();
+
         Scroll = ScrollMax = ScrollChange = itemsHeight = animation = 0; //NOLINT
     }
 
     void ListView::Refresh()
     {
+        // The list is locked while it's drawn, by this thread
+        if(IsBeingDrawn()) {
+            refreshRequested = true;
+            Manager::RequestRedrawAfterFrame();
+            return;
+        }
+
         std::vector<Component*>::iterator it;
         ScrollMax = 0;
         itemsHeight = 0;
@@ -142,6 +221,13 @@ namespace grvl {
         Guard touch_lock {ClearWhileTouchMutex};
         Guard draw_lock {ClearWhileDrawMutex};
 
+        if(IsVirtualized()) {
+            UpdateItemOffsets();
+            std::fill(boundItems.begin(), boundItems.end(), unboundItem);
+            Invalidate();
+            return;
+        }
+
         for(it = Elements.begin(); it != Elements.end(); it++) {
             if((*it)->IsVisible()) {
                 itemsHeight += (*it)->GetHeight();
@@ -179,6 +265,7 @@ namespace grvl {
             return false;
         }
 
+        Stylesheet::Scope stylesheetScope(man->stylesheet);
         XMLElement* childElement = Root->FirstChildElement("listItem");
         while(childElement != 0) {
             ListItem* item = ListItem::BuildFromXML(childElement);
@@ -194,4 +281,209 @@ namespace grvl {
         return true;
     }
 
+    void ListView::SetDataSource(const Component& itemTemplate, const ListDataSource& source)
+    {
+        if(IsBeingDrawn()) {
+            clearRequested = false;
+            refreshRequested = false;
+            requestedItemCount.reset();
+            requestedItemTemplate.reset(itemTemplate.Clone());
+            requestedDataSource = source;
+            Manager::RequestRedrawAfterFrame();
+            return;
+        }
+
+        ClearList();
+
+        Guard touch_lock {ClearWhileTouchMutex};
+        Guard draw_lock {ClearWhileDrawMutex};
+
+        this->itemTemplate.reset(itemTemplate.Clone());
+        dataSource = source;
+        UpdateItemOffsets();
+        Invalidate();
+    }
+
+    bool ListView::SetDataSource(const char* prefabId, uint32_t itemCount, const std::string& bindCallbackName)
+    {
+        Division* prefab = Manager::GetInstance().GetPrefabByID(prefabId);
+        if(!prefab) {
+            Log(ERROR, "ListView: item template prefab %s not found\n", prefabId);
+            return false;
+        }
+
+        ListDataSource source;
+        source.itemCount = itemCount;
+        Event::CallbackFunction bindFunction = Manager::GetInstance().GetOrCreateCallbackFunction(bindCallbackName);
+        if(bindFunction) {
+            source.bindItem = [bindFunction] (Component* item, uint32_t index) {
+                bindFunction(item, Event::ArgVector { std::to_string(index) });
+            };
+        }
+
+        SetDataSource(*prefab, source);
+        return true;
+    }
+
+    void ListView::SetItemCount(uint32_t count)
+    {
+        if(!IsVirtualized()) {
+            return;
+        }
+
+        if(IsBeingDrawn()) {
+            requestedItemCount = count;
+            Manager::RequestRedrawAfterFrame();
+            return;
+        }
+
+        dataSource.itemCount = count;
+        Refresh();
+    }
+
+    uint32_t ListView::GetItemCount() const
+    {
+        return IsVirtualized() ? dataSource.itemCount : Elements.size();
+    }
+
+    void ListView::ReloadItems()
+    {
+        if(!IsVirtualized()) {
+            return;
+        }
+
+        // Applied before the next frame, so that it can be called from the bind callback
+        reloadRequested = true;
+        Invalidate();
+        Manager::RequestRedrawAfterFrame();
+    }
+
+    bool ListView::IsVirtualized() const
+    {
+        return itemTemplate != nullptr;
+    }
+
+    void ListView::UpdateItemOffsets()
+    {
+        itemOffsets.resize(dataSource.itemCount + 1);
+        itemOffsets[0] = 0;
+        for(uint32_t index = 0; index < dataSource.itemCount; ++index) {
+            int32_t itemHeight = dataSource.itemHeight ? dataSource.itemHeight(index) : itemTemplate->GetHeight();
+            itemOffsets[index + 1] = itemOffsets[index] + itemHeight + verticalGap;
+        }
+
+        itemsHeight = itemOffsets.back();
+        ScrollMax = std::max(itemsHeight - Height, 0);
+        if(Scroll > ScrollMax) {
+            Scroll = ScrollMax;
+        }
+
+        UpdateScrollIndicator();
+    }
+
+    uint32_t ListView::FindFirstVisibleItem(int32_t scroll) const
+    {
+        // Last item starting at or above the scroll position
+        auto item = std::upper_bound(itemOffsets.begin(), itemOffsets.end() - 1, scroll);
+        return std::max((int32_t)(item - itemOffsets.begin()) - 1, 0);
+    }
+
+    void ListView::PrepareVisibleElements(int32_t scroll)
+    {
+        if(!IsVirtualized()) {
+            return;
+        }
+
+        if(reloadRequested) {
+            reloadRequested = false;
+            std::fill(boundItems.begin(), boundItems.end(), unboundItem);
+        }
+
+        uint32_t first = FindFirstVisibleItem(scroll);
+        uint32_t last = first;
+        while(last < dataSource.itemCount && itemOffsets[last] < scroll + Height) {
+            ++last;
+        }
+
+        // Release elements bound to items which went out of the view
+        for(uint32_t element = 0; element < Elements.size(); ++element) {
+            if(boundItems[element] != unboundItem && (boundItems[element] < first || boundItems[element] >= last)) {
+                boundItems[element] = unboundItem;
+            }
+            if(boundItems[element] == unboundItem && Elements[element]->IsVisible()) {
+                Elements[element]->SetVisible(false);
+            }
+        }
+
+        for(uint32_t index = first; index < last; ++index) {
+            if(std::find(boundItems.begin(), boundItems.end(), index) != boundItems.end()) {
+                continue;
+            }
+
+            auto freeElement = std::find(boundItems.begin(), boundItems.end(), unboundItem);
+            if(freeElement == boundItems.end()) {
+                Component* element = itemTemplate->Clone();
+                element->SetParentID(GetID());
+                Elements.push_back(element);
+                freeElement = boundItems.insert(boundItems.end(), unboundItem);
+            }
+
+            BindElement(freeElement - boundItems.begin(), index);
+        }
+    }
+
+    void ListView::BindElement(uint32_t element, uint32_t index)
+    {
+        Component* item = Elements[element];
+        boundItems[element] = index;
+
+        item->SetPosition(0, itemOffsets[index]);
+        item->SetSize(Width, itemOffsets[index + 1] - itemOffsets[index] - verticalGap);
+        item->SetVisible(true);
+        item->Invalidate();
+
+        if(dataSource.bindItem) {
+            dataSource.bindItem(item, index);
+        }
+    }
+
+    void ListView::PopulateJavaScriptObject(JSObjectBuilder& jsObjectBuilder)
+    {
+        VerticalScrollView::PopulateJavaScriptObject(jsObjectBuilder);
+        jsObjectBuilder.AttachMemberFunction("SetDataSource", ListView::JSSetDataSourceWrapper, 3);
+        jsObjectBuilder.AttachMemberFunction("ReloadItems", ListView::JSReloadItemsWrapper, 0);
+        jsObjectBuilder.AddProperty("itemCount", ListView::JSGetItemCountWrapper, ListView::JSSetItemCountWrapper);
+    }
+
+    duk_ret_t ListView::JSSetDataSourceWrapper(duk_context* ctx)
+    {
+        duk_push_this(ctx);
+        duk_get_prop_string(ctx, -1, JSObject::C_OBJECT_POINTER_KEY);
+        ListView* listView = static_cast<ListView*>(duk_to_pointer(ctx, -1));
+        if (!listView) {
+            return 0;
+        }
+
+        const char* prefabId = duk_to_string(ctx, 0);
+        uint32_t itemCount = duk_to_uint(ctx, 1);
+        std::string bindFunctionName = duk_to_string(ctx, 2);
+        listView->SetDataSource(prefabId, itemCount, bindFunctionName);
+
+        return 0;
+    }
+
+    duk_ret_t ListView::JSReloadItemsWrapper(duk_context* ctx)
+    {
+        duk_push_this(ctx);
+        duk_get_prop_string(ctx, -1, JSObject::C_OBJECT_POINTER_KEY);
+        ListView* listView = static_cast<ListView*>(duk_to_pointer(ctx, -1));
+        if (!listView) {
+            return 0;
+        }
+
+        listView->ReloadItems();
+
+        return 0;
+    }
+
 } /* namespace grvl */
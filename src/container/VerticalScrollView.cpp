@@ -18,6 +18,8 @@
 #include <grvl/Manager.h>
 #include <grvl/container/VerticalScrollView.h>
 
+#include <algorithm>
+
 //NOLINTBEGIN
 #define min(x, y) (x < y ? x : y)
 #define max(x, y) (x < y ? y : x)
@@ -29,6 +31,7 @@ namespace grvl {
         AdjustScrollViewHeight(item);
         item->SetParentID(GetID());
         Elements.push_back(item);
+        Invalidate();
     }
 
     void VerticalScrollView::AdjustScrollViewHeight(Component* child)
@@ -62,6 +65,7 @@ namespace grvl {
         }
 
         delete foundComponent;
+        Invalidate();
     }
 
     void VerticalScrollView::SetScrolling(bool enable)
@@ -104,6 +108,7 @@ namespace grvl {
         scrollVal = Clamp(scrollVal + currentOverscrollBarSize, 0, ScrollMax);
         ScrollChange += scrollVal - Scroll + indicatorSizeDiff;
         Scroll = scrollVal;
+        Manager::RequestRedraw();
     }
 
     void VerticalScrollView::SetSize(int32_t width, int32_t height)
@@ -202,11 +207,20 @@ namespace grvl {
             SetScrollingValue(Scroll + dSpeed);
         }
 
+        if(animation != 0) {
+            Manager::RequestRedraw(grvl::Callbacks()->get_timestamp());
+        }
+
         int tempScrollChange = ScrollChange; // Store current values
         ScrollChange = 0; // Start collecting new position changes
         int tempCurrentOverscrollSize = currentOverscrollBarSize;
         int tempScroll = Scroll + tempCurrentOverscrollSize;
 
+        const int32_t renderX = ParentRenderX + X;
+        const int32_t renderY = ParentRenderY + Y;
+        const int32_t scrollShift = tempScroll - retainedScroll;
+        const bool storeContent = tempScrollChange != 0 && CanRetainContent(painter, renderX, renderY);
+
         bool DrawHLine = true;
 
         const int ScrollChangeMultiplicator = 2; // predicting a required image content
@@ -214,6 +228,16 @@ namespace grvl {
         {
             Guard lock {ClearWhileDrawMutex};
 
+            PrepareVisibleElements(tempScroll);
+
+            damagedRows.clear();
+            if(storeContent && CanReuseRetainedContent(painter, renderX, renderY, scrollShift)) {
+                CollectDamagedRows(tempScroll, scrollShift);
+                RestoreRetainedContent(painter, renderX, renderY, scrollShift);
+            } else {
+                damagedRows.push_back({ 0, Height });
+            }
+
             for(uint32_t i = 0; i < Elements.size(); i++) {
                 if(!Elements[i]->IsVisible()) {
                     continue;
@@ -289,19 +313,40 @@ namespace grvl {
                             Elements[i]->GetCurrentBackgroundColor());
                     }
 
-                    Elements[i]->Draw(painter, ParentRenderX + X, ParentRenderY + Y - tempScroll);
-
                     if(i == Elements.size() - 1) {
                         DrawHLine = false;
                     }
 
-                    if(DrawHLine && SplitLineColor > 0) {
-                        painter.DrawHLine(
-                            ParentRenderX + X, ParentRenderY + Y + Elements[i]->GetY() + Elements[i]->GetHeight() - tempScroll - 1,
-                            Width, SplitLineColor);
+                    const int32_t elementTop = Elements[i]->GetY() - tempScroll;
+                    const int32_t elementBottom = elementTop + Elements[i]->GetHeight();
+
+                    for(const auto& rows : damagedRows) {
+                        if(rows.end <= elementTop || rows.start >= elementBottom) {
+                            continue;
+                        }
+
+                        painter.PushDrawingBoundsStackElement(renderX, renderY + rows.start, renderX + Width, renderY + rows.end);
+
+                        Elements[i]->Draw(painter, renderX, renderY - tempScroll);
+
+                        if(DrawHLine && SplitLineColor > 0) {
+                            painter.DrawHLine(renderX, renderY + elementBottom - 1, Width, SplitLineColor);
+                        }
+
+                        painter.PopDrawingBoundsStackElement();
+                    }
+
+                    if(storeContent) {
+                        Elements[i]->ClearDirty();
                     }
                 }
             }
+
+            if(storeContent) {
+                StoreRetainedContent(painter, renderX, renderY, tempScroll);
+            } else {
+                retainedContentValid = false;
+            }
         }
 
         if(overscrollBarEnabled && tempCurrentOverscrollSize > 0 && tempScroll - tempCurrentOverscrollSize == ScrollMax) {
@@ -360,6 +405,9 @@ namespace grvl {
                         scrollIndicatorOpacity = 0;
                     }
                 }
+
+                // Keep fading out, the frame after the last one clears the indicator
+                Manager::RequestRedraw(max(now, scrollIndicatorTimestamp + scrollDelay));
             }
         }
 
@@ -372,9 +420,122 @@ namespace grvl {
         painter.PopDrawingBoundsStackElement();
     }
 
+    bool VerticalScrollView::CanRetainContent(const Painter& painter, int32_t renderX, int32_t renderY) const
+    {
+        // Retained rows are copied with a plain line stride, which does not match a rotated framebuffer
+        if(!scrollBlittingEnabled || painter.IsRotated()) {
+            return false;
+        }
+
+        // Pixels outside of the drawing bounds belong to other widgets, so the whole view has to be drawable
+        return painter.CurrentDrawingBoundsStartX() == renderX && painter.CurrentDrawingBoundsStartY() == renderY
+            && painter.CurrentDrawingBoundsEndX() == renderX + Width && painter.CurrentDrawingBoundsEndY() == renderY + Height;
+    }
+
+    bool VerticalScrollView::CanReuseRetainedContent(const Painter& painter, int32_t renderX, int32_t renderY, int32_t scrollShift) const
+    {
+        if(!retainedContentValid || Component::IsDirty()) {
+            return false;
+        }
+
+        if(retainedX != renderX || retainedY != renderY || retainedFormat != painter.GetActiveBufferPixelFormat()) {
+            return false;
+        }
+
+        return scrollShift != 0 && abs(scrollShift) < Height
+            && retainedContent.size() == (size_t)Width * Height * GetFormatStride(retainedFormat);
+    }
+
+    void VerticalScrollView::CollectDamagedRows(int32_t scroll, int32_t scrollShift)
+    {
+        // Rows scrolled into the view
+        if(scrollShift > 0) {
+            damagedRows.push_back({ Height - scrollShift, Height });
+        } else {
+            damagedRows.push_back({ 0, -scrollShift });
+        }
+
+        // Changed rows, nested components report their changes through Invalidate(), see Container::IsDirty()
+        for(auto* element : Elements) {
+            const int32_t elementTop = element->GetY() - scroll;
+            const int32_t elementBottom = elementTop + element->GetHeight();
+
+            if(!element->IsVisible() || elementBottom <= 0 || elementTop >= Height || !element->IsDirty()) {
+                continue;
+            }
+
+            damagedRows.push_back({ max(elementTop, 0), min(elementBottom, Height) });
+        }
+
+        std::sort(damagedRows.begin(), damagedRows.end(), [](const RowSpan& a, const RowSpan& b) {
+            return a.start < b.start;
+        });
+
+        // Merge overlapping spans, so that no element is drawn twice over the same rows
+        size_t merged = 0;
+        for(size_t i = 1; i < damagedRows.size(); i++) {
+            if(damagedRows[i].start <= damagedRows[merged].end) {
+                damagedRows[merged].end = max(damagedRows[merged].end, damagedRows[i].end);
+            } else {
+                damagedRows[++merged] = damagedRows[i];
+            }
+        }
+        damagedRows.resize(merged + 1);
+    }
+
+    void VerticalScrollView::RestoreRetainedContent(const Painter& painter, int32_t renderX, int32_t renderY, int32_t scrollShift) const
+    {
+        const uint32_t bytes = GetFormatStride(retainedFormat);
+        const uint32_t lineSize = painter.GetXSize();
+        const uintptr_t framebuffer = painter.GetActiveBuffer();
+        const uintptr_t content = (uintptr_t)retainedContent.data();
+
+        // Move every row range between damaged spans with a single transfer
+        int32_t row = 0;
+        for(const auto& rows : damagedRows) {
+            if(row < rows.start) {
+                painter.DmaOperation(content + bytes * Width * (row + scrollShift), 0,
+                                     framebuffer + bytes * (lineSize * (renderY + row) + renderX),
+                                     Width, rows.start - row, 0, 0, lineSize - Width,
+                                     retainedFormat, retainedFormat, retainedFormat);
+            }
+            row = rows.end;
+        }
+
+        if(row < Height) {
+            painter.DmaOperation(content + bytes * Width * (row + scrollShift), 0,
+                                 framebuffer + bytes * (lineSize * (renderY + row) + renderX),
+                                 Width, Height - row, 0, 0, lineSize - Width,
+                                 retainedFormat, retainedFormat, retainedFormat);
+        }
+    }
+
+    void VerticalScrollView::StoreRetainedContent(const Painter& painter, int32_t renderX, int32_t renderY, int32_t scroll)
+    {
+        retainedFormat = painter.GetActiveBufferPixelFormat();
+
+        const uint32_t bytes = GetFormatStride(retainedFormat);
+        const uint32_t lineSize = painter.GetXSize();
+
+        // the buffer may move, while a blit from the previous contents is still in progress
+        painter.WaitForBlitter();
+        retainedContent.resize((size_t)Width * Height * bytes);
+
+        painter.DmaOperation(painter.GetActiveBuffer() + bytes * (lineSize * renderY + renderX), 0,
+                             (uintptr_t)retainedContent.data(), Width, Height, lineSize - Width, 0, 0,
+                             retainedFormat, retainedFormat, retainedFormat);
+
+        retainedX = renderX;
+        retainedY = renderY;
+        retainedScroll = scroll;
+        retainedContentValid = true;
+        Component::ClearDirty();
+    }
+
     void VerticalScrollView::PrepareToOpen()
     {
         Scroll = 0;
+        retainedContentValid = false;
     }
 
     void VerticalScrollView::PrepareToClose()
@@ -461,9 +622,9 @@ namespace grvl {
             // Slide Event
             if(abs(deltaY) < Height / scrollingByFingerInertiaScale && abs(deltaX) > Width / scrollingByFingerInertiaScale && !scrollingByFinger) {
                 if(deltaX > 0) {
-                    Manager::GetInstance().GetEventsQueueInstance().push(&onSlideToLeft);
+                    Manager::GetInstance().QueueEvent(&onSlideToLeft);
                 } else if(deltaX < 0) {
-                    Manager::GetInstance().GetEventsQueueInstance().push(&onSlideToRight);
+                    Manager::GetInstance().QueueEvent(&onSlideToRight);
                 }
 
                 touchActive = false;
@@ -580,6 +741,17 @@ namespace grvl {
         overscrollBarColor = color;
     }
 
+    void VerticalScrollView::SetScrollBlitting(bool enable)
+    {
+        scrollBlittingEnabled = enable;
+        retainedContentValid = false;
+
+        if(!enable) {
+            retainedContent.clear();
+            retainedContent.shrink_to_fit();
+        }
+    }
+
     void VerticalScrollView::SetOverscrollBarSize(int32_t size)
     {
         if(size >= 0) {
@@ -593,6 +765,7 @@ namespace grvl {
         static constexpr auto defaultOverscrollBarSize = 50;
         this->SetOverscrollBarSize(XMLSupport::GetAttributeOrDefault(xmlElement, "overscrollHeight", (uint32_t)defaultOverscrollBarSize));
         this->SetVisible(XMLSupport::GetAttributeOrDefault(xmlElement, "visible", true));
+        this->SetScrollBlitting(XMLSupport::GetAttributeOrDefault(xmlElement, "scrollBlitting", true));
 
         AbstractView::InitFromXML(xmlElement);
     }
@@ -606,6 +779,7 @@ namespace grvl {
             }
         }
         ScrollMax = max(itemsHeight - Height, 0);
+        Invalidate();
     }
 
     void VerticalScrollView::PopulateJavaScriptObject(JSObjectBuilder& jsObjectBuilder)
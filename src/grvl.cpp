@@ -62,15 +62,27 @@ namespace grvl {
             }
         }
 
+        // batches of custom operations go through them one by one
+        if (!n_callbacks->blit_batch && (n_callbacks->fill || n_callbacks->blit || n_callbacks->blit_clt || n_callbacks->blend)) {
+            n_callbacks->blit_batch = UseOperationsAsBlitBatch;
+        }
+
         // this avoids a terrible performance regression for users that did not define blit_clt but require
         // custom blit/fill functions, previously grvl would avoid using CLT formats altogether in those cases, but now it's the user who decides
         if (n_callbacks->blit && !n_callbacks->blit_clt) {
             n_callbacks->blit_clt = UseBlitAsBlitClt;
         }
 
+        // same as above, the default blender would race with asynchronous user blits
+        if (n_callbacks->blit && !n_callbacks->blend) {
+            n_callbacks->blend = UseBlitAsBlend;
+        }
+
         if (n_callbacks->fill == nullptr) n_callbacks->fill = GetFillFunction();
         if (n_callbacks->blit == nullptr) n_callbacks->blit = GetBlitFunction();
         if (n_callbacks->blit_clt == nullptr) n_callbacks->blit_clt = GetBlitCltFunction();
+        if (n_callbacks->blend == nullptr) n_callbacks->blend = GetBlendFunction();
+        if (n_callbacks->blit_batch == nullptr) n_callbacks->blit_batch = GetBlitBatchFunction();
 
         // those should probably be set for grvl to be usefull but let's not crash if they are not
         if (n_callbacks->set_layer_pointer == nullptr) n_callbacks->set_layer_pointer = NoOpSetLayerPointer;
@@ -5,6 +5,7 @@
 #include <grvl/platform/Dma2d.h>
 #include <zephyr/logging/log.h>
 #include <grvl/Blitter.h>
+#include <grvl/Misc.h>
 #include <zephyr/dt-bindings/input/input-event-codes.h>
 #include <vector>
 
@@ -14,9 +15,10 @@ LOG_MODULE_REGISTER(dma2d, LOG_LEVEL_INF);
 
 static DMA2D_HandleTypeDef hal_dma2d;
 static bool dma_in_progress = true;
+static grvl::BlitFence dma_submitted = 0;
 static int cluts[2] = {0};
 
-static void Dma2dInitClut(int layer, int length)
+static void Dma2dInitClut(int layer, int length, const uint8_t* palette = nullptr)
 {
     int rc;
 
@@ -25,24 +27,38 @@ static void Dma2dInitClut(int layer, int length)
         return;
     }
 
-    // if we already have the desired grayscale lookup loaded for this layer we can do nothing
-    if (cluts[layer] == length) {
+    // the greyscale palette is generated below
+    if (palette == grvl::greyscaleCltPalette) {
+        palette = nullptr;
+    }
+
+    // if we already have the desired grayscale lookup loaded for this layer we can do nothing,
+    // image palettes are always loaded as their contents may have changed
+    if (!palette && cluts[layer] == length) {
         return;
     }
 
-    std::vector<uint32_t> grayscale;
-    grayscale.resize(length);
+    std::vector<uint32_t> entries;
+    entries.resize(length);
 
     int step = 256 / length;
 
     DMA2D_CLUTCfgTypeDef clut;
-    clut.pCLUT = grayscale.data();
+    clut.pCLUT = entries.data();
     clut.CLUTColorMode = DMA2D_CCM_ARGB8888;
     clut.Size = length - 1;
 
     for (uint32_t i = 0; i < length; i ++) {
         uint32_t val = i * step;
-        grayscale[i] = val | (val << 8u) | (val << 16u) | (0xff << 24);
+
+        if (palette) {
+            // palettes have 256 blue, green and red entries, smaller lookups are spread over them like in LookupClt
+            const uint8_t* entry = palette + (i * 255 / (length - 1)) * 3;
+            entries[i] = entry[0] | (entry[1] << 8u) | (entry[2] << 16u) | (0xff << 24);
+            continue;
+        }
+
+        entries[i] = val | (val << 8u) | (val << 16u) | (0xff << 24);
     }
 
     if ((rc = HAL_DMA2D_CLUTLoad(&hal_dma2d, clut, layer)) != HAL_OK) {
@@ -56,7 +72,7 @@ static void Dma2dInitClut(int layer, int length)
     }
 
     LOG_DBG("InitClut: Created CLUT for layer %d of size %d", layer, length);
-    cluts[layer] = length;
+    cluts[layer] = palette ? 0 : length;
 }
 
 static int Dma2dGetClutSize(grvl::Format format)
@@ -80,9 +96,22 @@ static void Dma2dWaitIdle(const char* where)
     dma_in_progress = false;
 }
 
-static void Dma2dBlit(uintptr_t fg_mem, uintptr_t bg_mem, uintptr_t out_mem,
+// a single transfer is in flight, so every fence is reached once the engine is idle
+static grvl::BlitFence Dma2dFence()
+{
+    return dma_submitted;
+}
+
+static void Dma2dWait(grvl::BlitFence fence)
+{
+    (void) fence;
+    Dma2dWaitIdle("Wait");
+}
+
+static void Dma2dStart(uintptr_t fg_mem, uintptr_t bg_mem, uintptr_t out_mem,
                  uint32_t width, uint32_t height, uint32_t fg_off, uint32_t bg_off, uint32_t out_off,
-                 grvl::Format fg_fmt, grvl::Format bg_fmt, grvl::Format out_fmt, uint32_t fnt_alpha)
+                 grvl::Format fg_fmt, grvl::Format bg_fmt, grvl::Format out_fmt, uint32_t fg_alpha_mode, uint32_t fg_alpha,
+                 uintptr_t bg_clt = 0, uintptr_t fg_clt = 0)
 {
     int rc;
 
@@ -102,14 +131,14 @@ static void Dma2dBlit(uintptr_t fg_mem, uintptr_t bg_mem, uintptr_t out_mem,
     hal_dma2d.LayerCfg[1] = {
         .InputOffset = fg_off,
         .InputColorMode = grvl::FormatToDma2d(fg_fmt),
-        .AlphaMode = DMA2D_NO_MODIF_ALPHA,
-        .InputAlpha = fnt_alpha,
+        .AlphaMode = fg_alpha_mode,
+        .InputAlpha = fg_alpha,
     };
 
     Dma2dWaitIdle("DmaBlit");
 
-    Dma2dInitClut(0, Dma2dGetClutSize(bg_fmt));
-    Dma2dInitClut(1, Dma2dGetClutSize(fg_fmt));
+    Dma2dInitClut(0, Dma2dGetClutSize(bg_fmt), (const uint8_t*) bg_clt);
+    Dma2dInitClut(1, Dma2dGetClutSize(fg_fmt), (const uint8_t*) fg_clt);
 
     /* DMA2D Initialization */
     if ((rc = HAL_DMA2D_Init(&hal_dma2d)) != HAL_OK) {
@@ -133,6 +162,29 @@ static void Dma2dBlit(uintptr_t fg_mem, uintptr_t bg_mem, uintptr_t out_mem,
     }
 
     dma_in_progress = true;
+    dma_submitted = dma_submitted + 1 == 0 ? 1 : dma_submitted + 1;
+}
+
+static void Dma2dBlit(uintptr_t fg_mem, uintptr_t bg_mem, uintptr_t out_mem,
+                 uint32_t width, uint32_t height, uint32_t fg_off, uint32_t bg_off, uint32_t out_off,
+                 grvl::Format fg_fmt, grvl::Format bg_fmt, grvl::Format out_fmt, uint32_t fnt_alpha)
+{
+    Dma2dStart(fg_mem, bg_mem, out_mem, width, height, fg_off, bg_off, out_off, fg_fmt, bg_fmt, out_fmt, DMA2D_NO_MODIF_ALPHA, fnt_alpha);
+}
+
+static void Dma2dBlitClt(uintptr_t fg_mem, uintptr_t bg_mem, uintptr_t out_mem,
+                 uint32_t width, uint32_t height, uint32_t fg_off, uint32_t bg_off, uint32_t out_off,
+                 grvl::Format fg_fmt, grvl::Format bg_fmt, grvl::Format out_fmt, uint32_t fnt_alpha, uintptr_t bg_clt, uintptr_t fg_clt)
+{
+    Dma2dStart(fg_mem, bg_mem, out_mem, width, height, fg_off, bg_off, out_off, fg_fmt, bg_fmt, out_fmt, DMA2D_NO_MODIF_ALPHA, fnt_alpha, bg_clt, fg_clt);
+}
+
+static void Dma2dBlend(uintptr_t fg_mem, uintptr_t bg_mem, uintptr_t out_mem,
+                 uint32_t width, uint32_t height, uint32_t fg_off, uint32_t bg_off, uint32_t out_off,
+                 grvl::Format fg_fmt, grvl::Format bg_fmt, grvl::Format out_fmt, uint8_t alpha)
+{
+    // the foreground alpha is multiplied by the constant alpha
+    Dma2dStart(fg_mem, bg_mem, out_mem, width, height, fg_off, bg_off, out_off, fg_fmt, bg_fmt, out_fmt, DMA2D_COMBINE_ALPHA, alpha);
 }
 
 static void Dma2dFill(uintptr_t out_mem, uint32_t width, uint32_t height, uint32_t off, uint32_t col, grvl::Format fmt)
@@ -158,6 +210,7 @@ static void Dma2dFill(uintptr_t out_mem, uint32_t width, uint32_t height, uint32
     }
 
     dma_in_progress = true;
+    dma_submitted = dma_submitted + 1 == 0 ? 1 : dma_submitted + 1;
 }
 
 namespace grvl {
@@ -175,6 +228,10 @@ namespace grvl {
     {
         callbacks.fill = Dma2dFill;
         callbacks.blit = Dma2dBlit;
+        callbacks.blit_clt = Dma2dBlitClt;
+        callbacks.blend = Dma2dBlend;
+        callbacks.blit_fence = Dma2dFence;
+        callbacks.wait_for_blit = Dma2dWait;
     }
 
 }
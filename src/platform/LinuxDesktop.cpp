@@ -49,11 +49,15 @@ namespace grvl {
 
     void LinuxDesktopApp::Render()
     {
-        Manager::GetInstance().MainLoopIteration();
+        frame_drawn = Manager::GetInstance().MainLoopIteration();
     }
 
     void LinuxDesktopApp::Swap()
     {
+        if (!frame_drawn) {
+            return;
+        }
+
         Stopwatch watch {};
 
         void* pixels = 0;
@@ -78,7 +82,12 @@ namespace grvl {
         SDL_Event event;
         SDL_zero(event);
 
-        while (SDL_PollEvent(&event)) {
+        // SDL can't be woken up by frames requested from other threads, so don't sleep for too long
+        static constexpr uint64_t maxWaitTimeout = 100;
+        uint64_t timeout = Manager::GetInstance().GetFrameScheduler().GetTimeout(grvl::Callbacks()->get_timestamp());
+        bool pending = SDL_WaitEventTimeout(&event, std::min(timeout, maxWaitTimeout));
+
+        for (; pending; pending = SDL_PollEvent(&event)) {
 
             if (event.type == SDL_TEXTINPUT) {
                 Manager::GetInstance().ProcessTextInput(event.text.text);
@@ -288,8 +288,11 @@ namespace grvl {
 
     LinuxNativeApp::~LinuxNativeApp()
     {
-        thread_run = false;
-        render_mutex.unlock();
+        {
+            std::lock_guard<std::mutex> lock(commit_mutex);
+            thread_run = false;
+        }
+        commit_changed.notify_all();
 
         input_thread.join();
 
@@ -520,19 +523,44 @@ namespace grvl {
 
         cursor_state.x = x;
         cursor_state.y = y;
+        RequestCommit();
+    }
+
+    void LinuxNativeApp::RequestCommit()
+    {
+        {
+            std::lock_guard<std::mutex> lock(commit_mutex);
+            commit_requested = true;
+        }
+        commit_changed.notify_all();
     }
 
     void LinuxNativeApp::PageFlipHandler(int fd, unsigned int frame, unsigned int sec, unsigned int usec, void* app)
     {
-        reinterpret_cast<LinuxNativeApp*>(app)->cursor_state.pending = false;
+        LinuxNativeApp* self = reinterpret_cast<LinuxNativeApp*>(app);
+        {
+            std::lock_guard<std::mutex> lock(self->commit_mutex);
+            self->cursor_state.pending = false;
+        }
+        self->commit_changed.notify_all();
+
+        // the event is timestamped with CLOCK_MONOTONIC, translate it to the grvl timestamp
+        timespec now = {};
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        const int64_t age_us = (now.tv_sec - (int64_t) sec) * 1000000 + (now.tv_nsec / 1000 - (int64_t) usec);
+        const uint64_t vblank = grvl::Callbacks()->get_timestamp() - std::max<int64_t>(age_us / 1000, 0);
+
+        Manager::GetInstance().GetFrameScheduler().ReportVblank(vblank);
     }
 
     void LinuxNativeApp::CommitPlanes()
     {
-        if (cursor_state.pending){
+        if (cursor_state.pending || !commit_requested){
             return;
         }
 
+        commit_requested = false;
+
         int x = cursor_state.x.load();
         int y = cursor_state.y.load();
 
@@ -568,11 +596,19 @@ namespace grvl {
 
     void LinuxNativeApp::DRMWait()
     {
+        // nothing is shown until the planes are changed, which wakes the thread up
+        if (!cursor_state.pending) {
+            std::unique_lock<std::mutex> lock(commit_mutex);
+            commit_changed.wait(lock, [this] () { return commit_requested || !thread_run; });
+            return;
+        }
+
         pollfd pfd = {};
         pfd.fd = fd;
         pfd.events = POLLIN;
 
-        int ret = poll(&pfd, 1, 16);
+        // wait for the page flip, for up to 100ms, so that the thread can notice it should stop
+        int ret = poll(&pfd, 1, 100);
 
         if (ret > 0 && (pfd.revents & POLLIN)) {
             drmHandleEvent(fd, &ev);
@@ -797,7 +833,6 @@ namespace grvl {
             while (thread_run) {
                 CommitPlanes();
                 DRMWait();
-                render_mutex.unlock();
             }
         });
 
@@ -816,14 +851,23 @@ namespace grvl {
             return;
         }
 
-        render_mutex.lock();
-        Manager::GetInstance().MainLoopIteration();
+        frame_drawn = Manager::GetInstance().MainLoopIteration();
     }
 
     void LinuxNativeApp::Swap()
     {
+        if (!frame_drawn) {
+            return;
+        }
+
         Stopwatch watch {};
 
+        // the primary plane is still shown until the page flip of the previous frame
+        {
+            std::unique_lock<std::mutex> lock(commit_mutex);
+            commit_changed.wait(lock, [this] () { return !cursor_state.pending || !thread_run; });
+        }
+
         const uint32_t row_bytes = width * 4;
         auto* dst = static_cast<uint8_t*>(primary.map);
         auto* src = reinterpret_cast<const uint8_t*>(framebuffer);
@@ -839,6 +883,7 @@ namespace grvl {
             }
         }
 
+        RequestCommit();
         Manager::GetInstance().perf.swap_times.put(watch.stop());
     }
 
@@ -851,13 +896,20 @@ namespace grvl {
                 break;
             }
 
-            (*event)();
+            if (event->type == InputEvent::TEXT) {
+                Manager::GetInstance().ProcessTextInput(event->text);
+            } else {
+                Manager::GetInstance().ProcessKeyInput(event->pressed, event->keycode);
+            }
         }
 
         auto x = cursor_state.x.load();
         auto y = cursor_state.y.load();
 
         Manager::GetInstance().ProcessTouchPoint(left_mouse_pressed, x, y);
+
+        // the input thread requests a frame for every input event, which ends the wait
+        Manager::GetInstance().GetFrameScheduler().WaitForFrame(grvl::Callbacks()->get_timestamp());
     }
 
     void LinuxNativeApp::HandleKeycode(uint32_t xkb_keycode, uint32_t evdev_keycode, bool pressed)
@@ -900,26 +952,22 @@ namespace grvl {
                     break;
                 }
 
-                char* buffer;
-                size_t size = xkb_state_key_get_utf8(xkb_state, xkb_keycode, nullptr, 0);
+                InputEvent text { InputEvent::TEXT };
+                int size = xkb_state_key_get_utf8(xkb_state, xkb_keycode, text.text, sizeof(text.text));
 
-                if (size > 0) {
-                    std::vector<char> buffer (size + 1);
-                    if (xkb_state_key_get_utf8(xkb_state, xkb_keycode, buffer.data(), buffer.size()) > 0) {
-
-                        // move the buffer to the handler
-                        events.push([buffer = std::move(buffer)] () {
-                            Manager::GetInstance().ProcessTextInput(buffer.data());
-                        });
+                // text which doesn't fit in the event would be cut, so it isn't sent
+                if (size > 0 && size < static_cast<int>(sizeof(text.text))) {
+                    if (!events.push(text)) {
+                        Log(WARN, "Input event queue is full, text input dropped.");
                     }
                 }
         }
 
         xkb_state_update_key(xkb_state, xkb_keycode, pressed ? XKB_KEY_DOWN : XKB_KEY_UP);
 
-        events.push([pressed, evdev_keycode] () {
-            Manager::GetInstance().ProcessKeyInput(pressed, evdev_keycode);
-        });
+        if (!events.push({ InputEvent::KEY, pressed, evdev_keycode })) {
+            Log(WARN, "Input event queue is full, key %u dropped.", evdev_keycode);
+        }
     }
 
     void LinuxNativeApp::HandleEvent(libinput_event* event)
@@ -995,9 +1043,11 @@ namespace grvl {
         pfd.fd = libinput_get_fd(li);
         pfd.events = POLLIN;
 
+        bool handled = false;
+
         while (true) {
-            // wait for up to 5ms
-            poll(&pfd, 1, 5);
+            // wait for up to 100ms, so that the thread can notice it should stop
+            poll(&pfd, 1, handled ? 0 : 100);
 
             libinput_dispatch(li);
             struct libinput_event* event = libinput_get_event(li);
@@ -1008,6 +1058,11 @@ namespace grvl {
 
             HandleEvent(event);
             libinput_event_destroy(event);
+            handled = true;
+        }
+
+        if (handled) {
+            Manager::GetInstance().GetFrameScheduler().RequestFrame();
         }
     }
 
@@ -40,6 +40,8 @@ namespace grvl {
             LOG_WRN_ONCE("Unknown input event %d", evt->code);
             break;
         }
+
+        Manager::GetInstance().GetFrameScheduler().RequestFrame();
     }
 
     bool ZephyrApp::InitDisplay(const device* dev)
@@ -114,11 +116,15 @@ namespace grvl {
 
     void ZephyrApp::Render()
     {
-        Manager::GetInstance().MainLoopIteration();
+        frame_drawn = Manager::GetInstance().MainLoopIteration();
     }
 
     void ZephyrApp::Swap()
     {
+        if (!frame_drawn) {
+            return;
+        }
+
         Stopwatch watch {};
         display_write(display_device, 0, 0, &display_descriptor, framebuffer);
         Manager::GetInstance().perf.swap_times.put(watch.stop());
@@ -127,6 +133,9 @@ namespace grvl {
     void ZephyrApp::Poll()
     {
         Manager::GetInstance().ProcessTouchPoint(mouse.pressed, mouse.x, mouse.y);
+
+        // input events request a frame, which ends the wait
+        Manager::GetInstance().GetFrameScheduler().WaitForFrame(GetTimestamp());
     }
 
 }
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <grvl/AssetBundle.h>
+#include <grvl/Endian.h>
+#include <grvl/grvl.h>
+
+#include <string.h>
+#include <vector>
+
+using namespace grvl;
+
+static void PrintfNewline(const char* text, va_list argList)
+{
+    vprintf(text, argList);
+    printf("\n");
+}
+
+// bundle with a single uncompressed entry, starting at the given offset of the buffer
+static std::vector<uint8_t> MakeBundle(size_t start, AssetBundleEntry entry = {})
+{
+    static constexpr char name[] = "asset.txt";
+    static constexpr char content[] = "content";
+
+    AssetBundleHeader header {};
+    memcpy(header.magic, assetBundleMagic, sizeof(header.magic));
+    header.version = BigEndian32(assetBundleVersion);
+    header.entries = BigEndian32(1);
+    header.names = BigEndian32(sizeof(name));
+
+    const uint32_t offset = sizeof(header) + sizeof(entry) + sizeof(name);
+    if(entry.offset == 0) {
+        entry.offset = BigEndian32(offset);
+        entry.size = BigEndian32(sizeof(content));
+        entry.storedSize = BigEndian32(sizeof(content));
+    }
+
+    std::vector<uint8_t> bundle(start + offset + sizeof(content));
+    memcpy(bundle.data() + start, &header, sizeof(header));
+    memcpy(bundle.data() + start + sizeof(header), &entry, sizeof(entry));
+    memcpy(bundle.data() + start + sizeof(header) + sizeof(entry), name, sizeof(name));
+    memcpy(bundle.data() + start + offset, content, sizeof(content));
+    return bundle;
+}
+
+TEST_CASE("Asset bundles are parsed at any address", "[bundle]")
+{
+
+    gui_callbacks_t callbacks {};
+    callbacks.gui_printf = PrintfNewline;
+    grvl::grvl::Init(&callbacks);
+
+    for(size_t start : { 0, 1, 3 }) {
+        std::vector<uint8_t> data = MakeBundle(start);
+        AssetBundle bundle(data.data() + start, data.size() - start);
+        REQUIRE(bundle.IsValid());
+
+        const AssetBundleEntry* entry = bundle.Find("asset.txt");
+        REQUIRE(entry != nullptr);
+        REQUIRE(bundle.Find("missing.txt") == nullptr);
+
+        REQUIRE(bundle.GetSize(entry) == sizeof("content"));
+        REQUIRE(strcmp(reinterpret_cast<const char*>(bundle.GetData(entry)), "content") == 0);
+    }
+
+    grvl::grvl::Destroy();
+
+}
+
+TEST_CASE("Corrupt asset bundles are rejected", "[bundle]")
+{
+
+    gui_callbacks_t callbacks {};
+    callbacks.gui_printf = PrintfNewline;
+    grvl::grvl::Init(&callbacks);
+
+    const std::vector<uint8_t> valid = MakeBundle(0);
+    const uint32_t dataOffset = valid.size() - sizeof("content");
+
+    SECTION("truncated")
+    {
+        for(size_t size : { (size_t)0, sizeof(AssetBundleHeader), valid.size() - 1 }) {
+            AssetBundle bundle(valid.data(), size);
+            REQUIRE_FALSE(bundle.IsValid());
+            REQUIRE(bundle.Find("asset.txt") == nullptr);
+        }
+    }
+
+    SECTION("data past the end")
+    {
+        AssetBundleEntry entry {};
+        entry.offset = BigEndian32(dataOffset + 1);
+        entry.size = entry.storedSize = BigEndian32(sizeof("content"));
+        std::vector<uint8_t> data = MakeBundle(0, entry);
+        REQUIRE_FALSE(AssetBundle(data.data(), data.size()).IsValid());
+    }
+
+    SECTION("uncompressed entry with a different stored size")
+    {
+        AssetBundleEntry entry {};
+        entry.offset = BigEndian32(dataOffset);
+        entry.size = BigEndian32(1024);
+        entry.storedSize = BigEndian32(sizeof("content"));
+        std::vector<uint8_t> data = MakeBundle(0, entry);
+        REQUIRE_FALSE(AssetBundle(data.data(), data.size()).IsValid());
+    }
+
+    SECTION("unknown compression")
+    {
+        AssetBundleEntry entry {};
+        entry.offset = BigEndian32(dataOffset);
+        entry.size = entry.storedSize = BigEndian32(sizeof("content"));
+        entry.compression = 7;
+        std::vector<uint8_t> data = MakeBundle(0, entry);
+        REQUIRE_FALSE(AssetBundle(data.data(), data.size()).IsValid());
+    }
+
+    SECTION("name out of the name table")
+    {
+        AssetBundleEntry entry {};
+        entry.name = BigEndian32(100);
+        entry.offset = BigEndian32(dataOffset);
+        entry.size = entry.storedSize = BigEndian32(sizeof("content"));
+        std::vector<uint8_t> data = MakeBundle(0, entry);
+        REQUIRE_FALSE(AssetBundle(data.data(), data.size()).IsValid());
+    }
+
+    grvl::grvl::Destroy();
+
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <grvl/grvl.h>
+#include <grvl/Manager.h>
+#include <grvl/Ring.h>
+
+#include <vector>
+
+using namespace grvl;
+
+static void PrintfNewline(const char* text, va_list argList)
+{
+    vprintf(text, argList);
+    printf("\n");
+}
+
+TEST_CASE("Ring drops elements when full", "[events]")
+{
+
+    Ring<int, 4> ring;
+
+    for(int i = 0; i < 4; i++) {
+        REQUIRE(ring.push(i));
+    }
+    REQUIRE_FALSE(ring.push(4));
+
+    REQUIRE(ring.pop() == 0);
+    REQUIRE(ring.push(5));
+
+    for(int expected : { 1, 2, 3, 5 }) {
+        REQUIRE(ring.pop() == expected);
+    }
+    REQUIRE_FALSE(ring.pop().has_value());
+
+}
+
+TEST_CASE("Events overflowing the queue are triggered in order", "[events]")
+{
+
+    gui_callbacks_t callbacks {};
+    callbacks.gui_printf = PrintfNewline;
+    grvl::grvl::Init(&callbacks);
+
+    Manager::Initialize(50, 50, 4, false);
+    Manager& manager = grvl::Manager::GetInstance();
+
+    std::vector<uint32_t> triggered;
+    std::vector<Event> events;
+
+    // more than the queue holds
+    static constexpr uint32_t eventCount = 300;
+    events.reserve(eventCount);
+    for(uint32_t i = 0; i < eventCount; i++) {
+        events.emplace_back(Event::CallbackFunction([&triggered, i](void*, const Event::ArgVector&) {
+            triggered.push_back(i);
+        }));
+    }
+
+    for(Event& event : events) {
+        manager.QueueEvent(&event);
+    }
+
+    manager.MainLoopIteration();
+
+    REQUIRE(triggered.size() == eventCount);
+    for(uint32_t i = 0; i < eventCount; i++) {
+        REQUIRE(triggered[i] == i);
+    }
+
+    // the queue is used again once the list is drained
+    triggered.clear();
+    manager.QueueEvent(&events[0]);
+    manager.MainLoopIteration();
+    REQUIRE(triggered == std::vector<uint32_t> { 0 });
+
+    grvl::grvl::Destroy();
+
+}
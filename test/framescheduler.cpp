@@ -0,0 +1,45 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <grvl/FrameScheduler.h>
+#include <grvl/grvl.h>
+
+using namespace grvl;
+
+static uint64_t timestamp = 0;
+
+static uint64_t GetTimestamp()
+{
+    return timestamp;
+}
+
+TEST_CASE("Frames requested after idling meet their deadline", "[framescheduler]")
+{
+
+    gui_callbacks_t callbacks {};
+    callbacks.get_timestamp = GetTimestamp;
+    grvl::grvl::Init(&callbacks);
+
+    FrameScheduler scheduler;
+
+    timestamp = 1000;
+    scheduler.RequestFrame();
+    REQUIRE(scheduler.IsFrameDue(timestamp));
+    REQUIRE(scheduler.BeginFrame(timestamp));
+
+    // nothing is drawn for a while, the deadline is the time of the request
+    timestamp = 5000;
+    scheduler.RequestFrame();
+    REQUIRE(scheduler.GetNextFrameTimestamp() == 5000);
+    REQUIRE(scheduler.BeginFrame(5010));
+    REQUIRE(scheduler.GetMissedDeadlines() == 0);
+
+    // requested right after a frame, it's due one frame interval after it
+    timestamp = 5012;
+    scheduler.RequestFrame();
+    REQUIRE(scheduler.GetNextFrameTimestamp() == 5010 + FrameScheduler::defaultFrameInterval);
+    REQUIRE_FALSE(scheduler.BeginFrame(5100));
+    REQUIRE(scheduler.GetMissedDeadlines() == 1);
+
+    grvl::grvl::Destroy();
+
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <grvl/grvl.h>
+#include <grvl/Manager.h>
+
+#include <vector>
+
+using namespace grvl;
+
+static void PrintfNewline(const char* text, va_list argList)
+{
+    vprintf(text, argList);
+    printf("\n");
+}
+
+static uint64_t timestamp = 0;
+
+static uint64_t GetTimestamp()
+{
+    return timestamp;
+}
+
+TEST_CASE("Bind callbacks may change the list", "[listview]")
+{
+
+    gui_callbacks_t callbacks {};
+    callbacks.gui_printf = PrintfNewline;
+    callbacks.get_timestamp = GetTimestamp;
+    grvl::grvl::Init(&callbacks);
+
+    Manager::Initialize(50, 50, 4, false);
+    Manager& manager = grvl::Manager::GetInstance();
+
+    int parsed = manager.BuildFromXMLString(R"XML(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <doc>
+            <stylesheet></stylesheet>
+            <customView id="home" backgroundColor="#FFFF0000">
+                <listView id="list" x="0" y="0" width="50" height="50" />
+            </customView>
+        </doc>
+    )XML");
+
+    REQUIRE(parsed != -1);
+
+    manager.InitializationFinished();
+    manager.SetActiveScreen("home", 0);
+
+    ListView* list = dynamic_cast<ListView*>(manager.FindElementInTheActiveScreenById("list"));
+    REQUIRE(list != nullptr);
+
+    std::vector<uint32_t> bound;
+    bool changeList = true;
+
+    ListDataSource source;
+    source.itemCount = 100;
+    source.bindItem = [&](Component*, uint32_t index) {
+        bound.push_back(index);
+
+        // the list is locked while its items are bound
+        if(changeList && index == 0) {
+            changeList = false;
+            list->SetItemCount(200);
+            list->ReloadItems();
+        }
+    };
+    list->SetDataSource(Panel(0, 0, 50, 10), source);
+
+    // the visible items are bound, changes made by the callback wait for the next frame
+    timestamp += 1000;
+    REQUIRE(manager.MainLoopIteration());
+    REQUIRE(bound == std::vector<uint32_t> { 0, 1, 2, 3, 4 });
+    REQUIRE(list->GetItemCount() == 100);
+    REQUIRE(manager.GetFrameScheduler().GetNextFrameTimestamp() != FrameScheduler::noFrame);
+
+    bound.clear();
+    timestamp += 1000;
+    REQUIRE(manager.MainLoopIteration());
+    REQUIRE(bound == std::vector<uint32_t> { 0, 1, 2, 3, 4 });
+    REQUIRE(list->GetItemCount() == 200);
+
+    // nothing changed since
+    bound.clear();
+    timestamp += 1000;
+    manager.MainLoopIteration();
+    REQUIRE(bound.empty());
+
+    grvl::grvl::Destroy();
+
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <grvl/grvl.h>
+#include <grvl/Manager.h>
+
+using namespace grvl;
+
+static void PrintfNewline(const char* text, va_list argList)
+{
+    vprintf(text, argList);
+    printf("\n");
+}
+
+static bool IsRedrawRequested(Manager& manager)
+{
+    return manager.GetFrameScheduler().GetNextFrameTimestamp() != FrameScheduler::noFrame;
+}
+
+template <class T>
+static T* FindElement(Manager& manager, const char* id)
+{
+    T* element = dynamic_cast<T*>(manager.FindElementInTheActiveScreenById(id));
+    REQUIRE(element != nullptr);
+    return element;
+}
+
+TEST_CASE("Setters request a redraw", "[redraw]")
+{
+
+    gui_callbacks_t callbacks {};
+    callbacks.gui_printf = PrintfNewline;
+    grvl::grvl::Init(&callbacks);
+
+    Manager::Initialize(50, 50, 4, false);
+    Manager& manager = grvl::Manager::GetInstance();
+
+    int parsed = manager.BuildFromXMLString(R"XML(
+        <?xml version="1.0" encoding="UTF-8"?>
+        <doc>
+            <stylesheet></stylesheet>
+            <customView id="home" backgroundColor="#FFFF0000">
+                <progressBar id="progress" x="0" y="0" width="50" height="5" />
+                <circleProgressBar id="circle" x="0" y="5" width="10" height="10" />
+                <slider id="slider" x="0" y="15" width="50" height="5" />
+                <switchButton id="switch" x="0" y="20" width="20" height="10" />
+                <textInput id="input" x="0" y="30" width="50" height="10" />
+                <graph id="graph" x="0" y="40" width="50" height="10" />
+            </customView>
+        </doc>
+    )XML");
+
+    REQUIRE(parsed != -1);
+
+    manager.InitializationFinished();
+    manager.SetActiveScreen("home", 0);
+
+    // draws the pending frame, after which nothing is requested until something changes
+    auto RequiresRedraw = [&manager](auto change) {
+        manager.MainLoopIteration();
+        REQUIRE_FALSE(IsRedrawRequested(manager));
+
+        change();
+        REQUIRE(IsRedrawRequested(manager));
+    };
+
+    RequiresRedraw([&] { FindElement<ProgressBar>(manager, "progress")->SetProgressValue(50); });
+    RequiresRedraw([&] { FindElement<CircleProgressBar>(manager, "circle")->SetEndAngle(90); });
+    RequiresRedraw([&] { FindElement<CircleProgressBar>(manager, "circle")->SetColor(0xFF00FF00); });
+    RequiresRedraw([&] { FindElement<Slider>(manager, "slider")->SetValue(50); });
+    RequiresRedraw([&] { FindElement<SwitchButton>(manager, "switch")->SetSwitchState(true); });
+    RequiresRedraw([&] { FindElement<TextInput>(manager, "input")->SetBasicText("placeholder"); });
+    RequiresRedraw([&] { FindElement<TextInput>(manager, "input")->Append("text"); });
+    RequiresRedraw([&] { FindElement<Graph>(manager, "graph")->AddData(1); });
+    RequiresRedraw([&] { FindElement<Graph>(manager, "graph")->ClearData(); });
+
+    grvl::grvl::Destroy();
+
+}
+
+TEST_CASE("Setters of nested components damage their scroll view row", "[redraw]")
+{
+
+    gui_callbacks_t callbacks {};
+    callbacks.gui_printf = PrintfNewline;
+    grvl::grvl::Init(&callbacks);
+
+    Manager::Initialize(50, 50, 4, false);
+
+    GridRow row(0, 0, 50, 20);
+    ProgressBar* progressBar = new ProgressBar(0, 0, 25, 10);
+    SwitchButton* switchButton = new SwitchButton(25, 0, 25, 10);
+    row.AddElement(progressBar);
+    row.AddElement(switchButton);
+
+    // rows are cleaned once their pixels are retained
+    row.ClearDirty();
+    REQUIRE_FALSE(row.IsDirty());
+
+    progressBar->SetProgressValue(50);
+    REQUIRE(row.IsDirty());
+
+    row.ClearDirty();
+    switchButton->SetSwitchState(true);
+    REQUIRE(row.IsDirty());
+
+    grvl::grvl::Destroy();
+
+}